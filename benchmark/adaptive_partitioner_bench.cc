@@ -0,0 +1,67 @@
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+// Benchmarks a parallel for_each of cheap iterations run repeatedly with
+// fixed chunk sizes and with the adaptive partitioner, which tunes its
+// chunk size over the runs.
+
+#include <benchmark/benchmark.h>
+#include <dubhe/taskflow.h>
+#include <dubhe/algorithm/for_each.h>
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+namespace {
+
+  dubhe::Executor& executor() {
+    static dubhe::Executor executor(std::max(2u, std::thread::hardware_concurrency()));
+    return executor;
+  }
+
+  template <typename P>
+  void run(benchmark::State& state, P partitioner) {
+    std::vector<double> vec(static_cast<size_t>(state.range(0)), 1.0);
+    dubhe::Taskflow taskflow;
+    taskflow.for_each(vec.begin(), vec.end(), [](double& x){ x = x * 0.5 + 1.0; }, partitioner);
+    for(auto _ : state) {
+      executor().run(taskflow).wait();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  void BM_Dynamic(benchmark::State& state) {
+    run(state, dubhe::DynamicPartitioner<>(static_cast<size_t>(state.range(1))));
+  }
+
+  void BM_Guided(benchmark::State& state) {
+    run(state, dubhe::GuidedPartitioner<>(static_cast<size_t>(state.range(1))));
+  }
+
+  void BM_Adaptive(benchmark::State& state) {
+    run(state, dubhe::AdaptivePartitioner<>(static_cast<size_t>(state.range(1))));
+  }
+
+}  // namespace
+
+BENCHMARK(BM_Dynamic)->ArgNames({"items", "chunk"})
+                     ->Args({1 << 20, 1})->Args({1 << 20, 1024})->UseRealTime();
+BENCHMARK(BM_Guided)->ArgNames({"items", "chunk"})
+                    ->Args({1 << 20, 1})->UseRealTime();
+BENCHMARK(BM_Adaptive)->ArgNames({"items", "chunk"})
+                      ->Args({1 << 20, 1})->UseRealTime();
@@ -0,0 +1,70 @@
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+
+// Benchmarks repeated runs of a 10k-task graph with and without freezing
+// the taskflow, where the set-up of each run is a large share of its time.
+
+#include <benchmark/benchmark.h>
+#include <dubhe/taskflow.h>
+
+#include <algorithm>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace {
+
+  dubhe::Executor& executor() {
+    static dubhe::Executor executor(std::max(1u, std::thread::hardware_concurrency()));
+    return executor;
+  }
+
+  // a layered graph where every task has up to four dependents in the
+  // previous layer
+  void build(dubhe::Taskflow& taskflow, size_t n) {
+    std::mt19937 rng(1);
+    size_t width = 100;
+    std::vector<dubhe::Task> tasks;
+    tasks.reserve(n);
+    for(size_t i=0; i<n; ++i) {
+      tasks.push_back(taskflow.emplace([](){}));
+      if(i >= width) {
+        size_t layer = i / width;
+        for(size_t k=0; k<4; ++k) {
+          tasks[(layer-1)*width + rng()%width].precede(tasks[i]);
+        }
+      }
+    }
+  }
+
+  void BM_Run(benchmark::State& state) {
+    dubhe::Taskflow taskflow;
+    build(taskflow, static_cast<size_t>(state.range(0)));
+    if(state.range(1)) {
+      taskflow.freeze();
+    }
+    for(auto _ : state) {
+      executor().run(taskflow).wait();
+    }
+    state.SetItemsProcessed(state.iterations() * taskflow.num_tasks());
+  }
+
+}  // namespace
+
+BENCHMARK(BM_Run)->ArgNames({"tasks", "frozen"})
+                 ->Args({10000, 0})->Args({10000, 1})->UseRealTime();
@@ -0,0 +1,66 @@
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+// Benchmarks graphs of many short chains of empty tasks with and without
+// fusing the chains, where each link otherwise pays for a join counter
+// update and a queue round trip.
+
+#include <benchmark/benchmark.h>
+#include <dubhe/taskflow.h>
+
+#include <algorithm>
+#include <thread>
+
+namespace {
+
+  dubhe::Executor& executor() {
+    static dubhe::Executor executor(std::max(1u, std::thread::hardware_concurrency()));
+    return executor;
+  }
+
+  // a source that fans out to chains of the given length joined by a sink
+  void build(dubhe::Taskflow& taskflow, size_t num_chains, size_t length) {
+    auto source = taskflow.emplace([](){});
+    auto sink = taskflow.emplace([](){});
+    for(size_t c=0; c<num_chains; ++c) {
+      dubhe::Task prev = source;
+      for(size_t i=0; i<length; ++i) {
+        auto task = taskflow.emplace([](){});
+        prev.precede(task);
+        prev = task;
+      }
+      prev.precede(sink);
+    }
+  }
+
+  void BM_Chains(benchmark::State& state) {
+    dubhe::Taskflow taskflow;
+    build(taskflow, 100, static_cast<size_t>(state.range(0)));
+    if(state.range(1)) {
+      taskflow.fuse();
+    }
+    for(auto _ : state) {
+      executor().run(taskflow).wait();
+    }
+    state.SetItemsProcessed(state.iterations() * taskflow.num_tasks());
+  }
+
+}  // namespace
+
+BENCHMARK(BM_Chains)->ArgNames({"length", "fused"})
+                    ->Args({10, 0})->Args({10, 1})
+                    ->Args({100, 0})->Args({100, 1})->UseRealTime();
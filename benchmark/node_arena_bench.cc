@@ -0,0 +1,90 @@
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+// Benchmarks the allocation of task nodes from the shared node pool against
+// a worker arena, and the recursive fibonacci subflow whose children are
+// spawned from the arena of the worker running their parent.
+
+#include <benchmark/benchmark.h>
+#include <dubhe/taskflow.h>
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+namespace {
+
+  dubhe::Executor& executor() {
+    static dubhe::Executor executor(std::max(1u, std::thread::hardware_concurrency()));
+    return executor;
+  }
+
+  // animates a batch of nodes and recycles them, as a subflow does per run
+  void BM_NodePool(benchmark::State& state) {
+    std::vector<dubhe::Node*> nodes(static_cast<size_t>(state.range(0)));
+    for(auto _ : state) {
+      for(auto& node : nodes) {
+        node = dubhe::node_pool.animate();
+      }
+      for(auto node : nodes) {
+        dubhe::recycle_node(node);
+      }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  void BM_NodeArena(benchmark::State& state) {
+    dubhe::ObjectArena<dubhe::Node> arena;
+    std::vector<dubhe::Node*> nodes(static_cast<size_t>(state.range(0)));
+    for(auto _ : state) {
+      for(auto& node : nodes) {
+        node = arena.animate();
+      }
+      for(auto node : nodes) {
+        dubhe::recycle_node(node);
+      }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  int fibonacci(int n, dubhe::Subflow& sf) {
+    if(n < 2) {
+      return n;
+    }
+    int r1, r2;
+    sf.emplace([&r1, n](dubhe::Subflow& child){ r1 = fibonacci(n-1, child); });
+    sf.emplace([&r2, n](dubhe::Subflow& child){ r2 = fibonacci(n-2, child); });
+    sf.join();
+    return r1 + r2;
+  }
+
+  void BM_FibonacciSubflow(benchmark::State& state) {
+    int n = static_cast<int>(state.range(0));
+    int r = 0;
+    dubhe::Taskflow taskflow;
+    taskflow.emplace([&](dubhe::Subflow& sf){ r = fibonacci(n, sf); });
+    for(auto _ : state) {
+      executor().run(taskflow).wait();
+    }
+    benchmark::DoNotOptimize(r);
+  }
+
+}  // namespace
+
+BENCHMARK(BM_NodePool)->Arg(1024)->Arg(65536);
+BENCHMARK(BM_NodeArena)->Arg(1024)->Arg(65536);
+BENCHMARK(BM_FibonacciSubflow)->Arg(20)->Arg(25)->UseRealTime();
@@ -0,0 +1,108 @@
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+
+// Benchmarks the per-task overhead of the scheduler on fine-grained graphs,
+// where every task does no work and the run time is dominated by the
+// scheduling fields of the nodes. Tasks per second are reported as items
+// per second.
+
+#include <benchmark/benchmark.h>
+#include <dubhe/taskflow.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+namespace {
+
+  dubhe::Executor& executor() {
+    static dubhe::Executor executor(std::max(1u, std::thread::hardware_concurrency()));
+    return executor;
+  }
+
+  // a chain of n tasks, which exposes the latency of scheduling one task
+  void BM_Chain(benchmark::State& state) {
+    auto n = static_cast<size_t>(state.range(0));
+    dubhe::Taskflow taskflow;
+    std::vector<dubhe::Task> tasks(n);
+    for(size_t i=0; i<n; ++i) {
+      tasks[i] = taskflow.emplace([](){});
+      if(i) {
+        tasks[i-1].precede(tasks[i]);
+      }
+    }
+    for(auto _ : state) {
+      executor().run(taskflow).wait();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+  }
+
+  // n independent tasks between a source and a sink, which exposes the
+  // throughput of the queues and the join counters
+  void BM_FanOut(benchmark::State& state) {
+    auto n = static_cast<size_t>(state.range(0));
+    dubhe::Taskflow taskflow;
+    auto source = taskflow.emplace([](){});
+    auto sink = taskflow.emplace([](){});
+    for(size_t i=0; i<n; ++i) {
+      taskflow.emplace([](){}).succeed(source).precede(sink);
+    }
+    for(auto _ : state) {
+      executor().run(taskflow).wait();
+    }
+    state.SetItemsProcessed(state.iterations() * (n + 2));
+  }
+
+  // an m x m grid where each task depends on its upper and left neighbors
+  void BM_Wavefront(benchmark::State& state) {
+    auto m = static_cast<size_t>(std::sqrt(static_cast<double>(state.range(0))));
+    dubhe::Taskflow taskflow;
+    std::vector<dubhe::Task> tasks(m*m);
+    for(size_t i=0; i<m; ++i) {
+      for(size_t j=0; j<m; ++j) {
+        tasks[i*m+j] = taskflow.emplace([](){});
+        if(i) tasks[(i-1)*m+j].precede(tasks[i*m+j]);
+        if(j) tasks[i*m+j-1].precede(tasks[i*m+j]);
+      }
+    }
+    for(auto _ : state) {
+      executor().run(taskflow).wait();
+    }
+    state.SetItemsProcessed(state.iterations() * m * m);
+  }
+
+  // n asynchronous tasks, each of which is a node from the pool
+  void BM_Async(benchmark::State& state) {
+    auto n = static_cast<size_t>(state.range(0));
+    for(auto _ : state) {
+      for(size_t i=0; i<n; ++i) {
+        executor().silent_async([](){});
+      }
+      executor().wait_for_all();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+  }
+
+}  // namespace
+
+BENCHMARK(BM_Chain)->RangeMultiplier(16)->Range(1<<10, 1<<18)->UseRealTime();
+BENCHMARK(BM_FanOut)->RangeMultiplier(16)->Range(1<<10, 1<<18)->UseRealTime();
+BENCHMARK(BM_Wavefront)->RangeMultiplier(16)->Range(1<<10, 1<<18)->UseRealTime();
+BENCHMARK(BM_Async)->RangeMultiplier(16)->Range(1<<10, 1<<18)->UseRealTime();
@@ -0,0 +1,65 @@
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+
+// Benchmarks the thief side of the work-stealing queue, where every steal
+// reads the array of its priority level while the owner may retire it.
+
+#include <benchmark/benchmark.h>
+#include <dubhe/taskflow.h>
+
+#include <vector>
+
+namespace {
+
+  // fills the queue from the owner and empties it by single steals
+  void BM_Steal(benchmark::State& state) {
+    dubhe::TaskQueue<void*> queue;
+    std::vector<int> items(static_cast<size_t>(state.range(0)));
+    for(auto _ : state) {
+      for(auto& item : items) {
+        queue.push(&item, 0);
+      }
+      while(auto ptr = queue.steal()) {
+        benchmark::DoNotOptimize(ptr);
+      }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  // fills the queue from the owner and empties it by halves into a thief
+  void BM_StealHalf(benchmark::State& state) {
+    dubhe::TaskQueue<void*> queue;
+    dubhe::TaskQueue<void*> thief;
+    std::vector<int> items(static_cast<size_t>(state.range(0)));
+    for(auto _ : state) {
+      for(auto& item : items) {
+        queue.push(&item, 0);
+      }
+      while(auto ptr = queue.steal_half(thief)) {
+        for(; ptr; ptr = thief.pop()) {
+          benchmark::DoNotOptimize(ptr);
+        }
+      }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+}  // namespace
+
+BENCHMARK(BM_Steal)->Arg(1024)->Arg(65536);
+BENCHMARK(BM_StealHalf)->Arg(1024)->Arg(65536);
@@ -95,6 +95,7 @@ namespace dubhe {
     + dubhe::DynamicPartitioner to enable dynamic scheduling algorithm of equal chunk size
     + dubhe::StaticPartitioner  to enable static scheduling algorithm of static chunk size
     + dubhe::RandomPartitioner  to enable random scheduling algorithm of random chunk size
+    + dubhe::AdaptivePartitioner to enable dynamic scheduling algorithm of measured chunk size
 
     Depending on applications, partitioning algorithms can impact the performance
     a lot.
@@ -803,6 +804,198 @@ namespace dubhe {
       float _beta  {0.5f};
     };
 
+    // ----------------------------------------------------------------------------
+    // AdaptivePartitioner
+    // ----------------------------------------------------------------------------
+
+    /**
+    @class AdaptivePartitioner
+
+    @brief class to construct an adaptive partitioner for scheduling parallel algorithms
+
+    @tparam C closure wrapper type (default dubhe::DefaultClosureWrapper)
+
+    Similar to dubhe::DynamicPartitioner,
+    the partitioner distributes partitions of equal size dynamically to workers,
+    but it times every partition and tunes the chunk size toward a target
+    duration per partition (30 microseconds by default).
+    A partition that runs for less than the target grows the chunk size
+    and a partition that runs for longer shrinks it, by at most a factor of
+    two each, such that the chunk size follows changes in the workload
+    without jumping on a single outlier.
+    The chunk size given to the constructor is the size to start with, and
+    a chunk size of zero starts at one.
+
+    The tuned chunk size is shared by all copies of a partitioner, which
+    makes a partitioner the memory of its call site: an algorithm task run
+    many times continues from the chunk size of its previous run.
+    A partition never exceeds a half of the iterations per worker, such that
+    the iterations of a run still spread over all workers.
+
+    @code{.cpp}
+    dubhe::AdaptivePartitioner partitioner;
+    taskflow.for_each_index(0, N, 1, [](int i){
+      // work of unknown cost
+    }, partitioner);
+    executor.run_n(taskflow, 100).wait();
+    std::cout << "tuned chunk size: " << partitioner.tuned_chunk_size() << '\n';
+    @endcode
+
+    The partitioner reads the clock twice per partition, which is negligible
+    for partitions near the target duration.
+    */
+    template <typename C = DefaultClosureWrapper>
+    class AdaptivePartitioner : public PartitionerBase<C> {
+
+      public:
+
+      /**
+      @brief queries the partition type (dynamic)
+      */
+      static constexpr PartitionerType type() { return PartitionerType::DYNAMIC; }
+
+      /**
+      @brief default constructor
+      */
+      AdaptivePartitioner() = default;
+
+      /**
+      @brief construct an adaptive partitioner with the given initial chunk size
+      */
+      explicit AdaptivePartitioner(size_t sz) :
+        PartitionerBase<C>(sz),
+        _state {std::make_shared<State>(sz)} {
+      }
+
+      /**
+      @brief construct an adaptive partitioner with the given initial chunk size
+             and the closure
+      */
+      explicit AdaptivePartitioner(size_t sz, C&& closure) :
+        PartitionerBase<C>(sz, std::forward<C>(closure)),
+        _state {std::make_shared<State>(sz)} {
+      }
+
+      /**
+      @brief construct an adaptive partitioner with the given initial chunk size
+             and target duration per partition
+      */
+      AdaptivePartitioner(size_t sz, std::chrono::nanoseconds target) :
+        PartitionerBase<C>(sz),
+        _target {target},
+        _state  {std::make_shared<State>(sz)} {
+      }
+
+      /**
+      @brief construct an adaptive partitioner with the given initial chunk size,
+             target duration per partition, and the closure
+      */
+      AdaptivePartitioner(size_t sz, std::chrono::nanoseconds target, C&& closure) :
+        PartitionerBase<C>(sz, std::forward<C>(closure)),
+        _target {target},
+        _state  {std::make_shared<State>(sz)} {
+      }
+
+      /**
+      @brief queries the target duration per partition
+      */
+      std::chrono::nanoseconds target() const { return _target; }
+
+      /**
+      @brief queries the chunk size tuned so far
+      */
+      size_t tuned_chunk_size() const {
+        return _state->chunk_size.load(std::memory_order_relaxed);
+      }
+
+      // --------------------------------------------------------------------------
+      // scheduling methods
+      // --------------------------------------------------------------------------
+
+      /**
+      @private
+      */
+      template <typename F,
+        std::enable_if_t<std::is_invocable_r_v<void, F, size_t, size_t>, void>* = nullptr
+      >
+      void loop(
+        size_t N, size_t W, std::atomic<size_t>& next, F&& func
+      ) const {
+
+        size_t max_chunk_size = std::max(N / (2*W), size_t{1});
+
+        while(1) {
+          size_t chunk_size = std::min(tuned_chunk_size(), max_chunk_size);
+          size_t curr_b = next.fetch_add(chunk_size, std::memory_order_relaxed);
+          if(curr_b >= N) {
+            return;
+          }
+          size_t curr_e = std::min(curr_b + chunk_size, N);
+          auto beg = std::chrono::steady_clock::now();
+          func(curr_b, curr_e);
+          // the last partition may be too short to tell anything
+          if(curr_e - curr_b == chunk_size) {
+            _tune(chunk_size, std::chrono::steady_clock::now() - beg);
+          }
+        }
+      }
+
+      /**
+      @private
+      */
+      template <typename F,
+        std::enable_if_t<std::is_invocable_r_v<bool, F, size_t, size_t>, void>* = nullptr
+      >
+      void loop_until(
+        size_t N, size_t W, std::atomic<size_t>& next, F&& func
+      ) const {
+
+        size_t max_chunk_size = std::max(N / (2*W), size_t{1});
+
+        while(1) {
+          size_t chunk_size = std::min(tuned_chunk_size(), max_chunk_size);
+          size_t curr_b = next.fetch_add(chunk_size, std::memory_order_relaxed);
+          if(curr_b >= N) {
+            return;
+          }
+          size_t curr_e = std::min(curr_b + chunk_size, N);
+          auto beg = std::chrono::steady_clock::now();
+          if(func(curr_b, curr_e)) {
+            return;
+          }
+          // the last partition may be too short to tell anything
+          if(curr_e - curr_b == chunk_size) {
+            _tune(chunk_size, std::chrono::steady_clock::now() - beg);
+          }
+        }
+      }
+
+      private:
+
+      struct State {
+        explicit State(size_t sz) : chunk_size {std::max(sz, size_t{1})} {}
+        std::atomic<size_t> chunk_size;
+      };
+
+      std::chrono::nanoseconds _target {std::chrono::microseconds(30)};
+
+      std::shared_ptr<State> _state {std::make_shared<State>(0)};
+
+      // Procedure: _tune
+      // scales the chunk size by the ratio of the target to the measured
+      // duration of a partition of the given size, within a factor of two
+      void _tune(size_t size, std::chrono::steady_clock::duration elapsed) const {
+        auto t = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+        double lo = static_cast<double>(std::max(size / 2, size_t{1}));
+        double hi = static_cast<double>(size) * 2;
+        double ideal = (t <= 0) ? hi :
+          static_cast<double>(size) * static_cast<double>(_target.count()) / static_cast<double>(t);
+        _state->chunk_size.store(
+          static_cast<size_t>(std::clamp(ideal, lo, hi)), std::memory_order_relaxed
+        );
+      }
+    };
+
     /**
     @brief default partitioner set to dubhe::GuidedPartitioner
 
@@ -31,31 +31,129 @@ namespace dubhe {
 template <typename P, typename F>
 auto Executor::async(P&& params, F&& f) {
 
+  // beyond the bound of pending tasks, the task may run inline
+  if(!_reserve(_params_tenant(params), 1, true)) {
+    using R = std::invoke_result_t<std::decay_t<F>>;
+    std::packaged_task<R()> p(std::forward<F>(f));
+    dubhe::Future<R> fu(p.get_future(), this);
+    p();
+    return fu;
+  }
+
+  return _async(std::forward<P>(params), std::forward<F>(f));
+}
+
+// Function: _async
+template <typename P, typename F>
+auto Executor::_async(P&& params, F&& f) {
+
   _increment_topology();
 
+  Node* node;
+  auto fu = _make_async(std::forward<P>(params), std::forward<F>(f), node);
+
+  _schedule_async_task(node);
+
+  return fu;
+}
+
+// Function: _make_async
+// creates an asynchronous task without scheduling it and returns the
+// future of its result, whose continuations run right after the result
+template <typename P, typename F>
+auto Executor::_make_async(P&& params, F&& f, Node*& node) {
+
   using R = std::invoke_result_t<std::decay_t<F>>;
 
   std::packaged_task<R()> p(std::forward<F>(f));
-  auto fu{p.get_future()};
+  auto c = std::make_shared<Continuations>();
 
-  auto node = node_pool.animate(
-    std::forward<P>(params), nullptr, nullptr, 0, 
+  dubhe::Future<R> fu(p.get_future(), this, c);
+
+  node = node_pool.animate(
+    std::forward<P>(params), nullptr, nullptr, 0,
     // handle
-    std::in_place_type_t<Node::Async>{}, 
-    [p=make_moc(std::move(p))]() mutable { p.object(); }
+    std::in_place_type_t<Node::Async>{},
+    [p=std::move(p), c=std::move(c)]() mutable {
+      p();
+      c->_complete();
+    }
   );
 
-  _schedule_async_task(node);
-
   return fu;
 }
 
+// Procedure: _schedule_deferred
+// schedules an asynchronous task of _make_async whose topology has been
+// counted when it was made; it becomes pending from now on
+inline void Executor::_schedule_deferred(Node* node) {
+  _num_pending.fetch_add(1, std::memory_order_relaxed);
+  _schedule_async_task(node);
+}
+
 // Function: async
 template <typename F>
 auto Executor::async(F&& f) {
   return async(DefaultTaskParams{}, std::forward<F>(f));
 }
 
+// Function: async
+template <typename P, typename F>
+auto Executor::async(LightFutureTag, P&& params, F&& f) {
+
+  using R = std::invoke_result_t<std::decay_t<F>>;
+
+  auto state = LightState<R>::_make();
+  LightFuture<R> fu(state);
+
+  // the task gives up its share of the state once the result is in
+  auto work = [state, f=std::forward<F>(f)]() mutable {
+    state->_invoke(f);
+    state->_release();
+  };
+
+  // beyond the bound of pending tasks, the task may run inline
+  if(!_reserve(_params_tenant(params), 1, true)) {
+    work();
+    return fu;
+  }
+
+  _silent_async(std::forward<P>(params), std::move(work));
+
+  return fu;
+}
+
+// Function: async
+template <typename F>
+auto Executor::async(LightFutureTag tag, F&& f) {
+  return async(tag, DefaultTaskParams{}, std::forward<F>(f));
+}
+
+// ----------------------------------------------------------------------------
+// Silent Async
+// ----------------------------------------------------------------------------
+
+// Function: try_async
+template <typename P, typename F>
+auto Executor::try_async(P&& params, F&& f) {
+
+  using R = std::invoke_result_t<std::decay_t<F>>;
+
+  std::optional<dubhe::Future<R>> fu;
+
+  if(_try_reserve(_params_tenant(params), 1)) {
+    fu = _async(std::forward<P>(params), std::forward<F>(f));
+  }
+
+  return fu;
+}
+
+// Function: try_async
+template <typename F>
+auto Executor::try_async(F&& f) {
+  return try_async(DefaultTaskParams{}, std::forward<F>(f));
+}
+
 // ----------------------------------------------------------------------------
 // Silent Async
 // ----------------------------------------------------------------------------
@@ -64,6 +162,21 @@ auto Executor::async(F&& f) {
 template <typename P, typename F>
 void Executor::silent_async(P&& params, F&& f) {
 
+  // beyond the bound of pending tasks, a task without runtime may run inline
+  if(!_reserve(_params_tenant(params), 1, std::is_invocable_v<F>)) {
+    if constexpr(std::is_invocable_v<F>) {
+      std::invoke(std::forward<F>(f));
+    }
+    return;
+  }
+
+  _silent_async(std::forward<P>(params), std::forward<F>(f));
+}
+
+// Function: _silent_async
+template <typename P, typename F>
+void Executor::_silent_async(P&& params, F&& f) {
+
   _increment_topology();
   
   auto node = node_pool.animate(
@@ -81,6 +194,336 @@ void Executor::silent_async(F&& f) {
   silent_async(DefaultTaskParams{}, std::forward<F>(f));
 }
 
+// Function: try_silent_async
+template <typename P, typename F>
+bool Executor::try_silent_async(P&& params, F&& f) {
+  if(!_try_reserve(_params_tenant(params), 1)) {
+    return false;
+  }
+  _silent_async(std::forward<P>(params), std::forward<F>(f));
+  return true;
+}
+
+// Function: try_silent_async
+template <typename F>
+bool Executor::try_silent_async(F&& f) {
+  return try_silent_async(DefaultTaskParams{}, std::forward<F>(f));
+}
+
+// ----------------------------------------------------------------------------
+// Timers
+// ----------------------------------------------------------------------------
+
+// Function: schedule_at
+template <typename F>
+auto Executor::schedule_at(std::chrono::steady_clock::time_point tp, F&& f) {
+
+  _increment_topology();
+
+  Node* node;
+  auto fu = _make_async(DefaultTaskParams{}, std::forward<F>(f), node);
+
+  _arm_timer(tp, node, true);
+
+  return fu;
+}
+
+// Function: schedule_after
+template <typename Rep, typename Period, typename F>
+auto Executor::schedule_after(const std::chrono::duration<Rep, Period>& delay, F&& f) {
+  return schedule_at(
+    std::chrono::steady_clock::now() +
+    std::chrono::duration_cast<std::chrono::steady_clock::duration>(delay),
+    std::forward<F>(f)
+  );
+}
+
+// Function: schedule_every
+template <typename Rep, typename Period, typename F>
+Timer Executor::schedule_every(const std::chrono::duration<Rep, Period>& period, F&& f) {
+  return schedule_every(
+    std::chrono::steady_clock::now() +
+    std::chrono::duration_cast<std::chrono::steady_clock::duration>(period),
+    period, std::forward<F>(f)
+  );
+}
+
+// Function: schedule_every
+template <typename Rep, typename Period, typename F>
+Timer Executor::schedule_every(
+  std::chrono::steady_clock::time_point first,
+  const std::chrono::duration<Rep, Period>& period,
+  F&& f
+) {
+
+  auto state = std::make_shared<Timer::State>();
+  state->period = std::chrono::duration_cast<std::chrono::nanoseconds>(period);
+  state->next = first;
+
+  if(state->period <= std::chrono::nanoseconds::zero()) {
+    DUBHE_THROW("timer period must be positive");
+  }
+
+  state->work = std::forward<F>(f);
+
+  _arm_periodic(state);
+
+  return Timer(std::move(state));
+}
+
+// ----------------------------------------------------------------------------
+// Future Continuations
+// ----------------------------------------------------------------------------
+
+// Function: then
+template <typename T>
+template <typename F>
+auto Future<T>::then(F&& f) {
+
+  auto executor = _executor;
+  auto continuations = _continuations.lock();
+
+  auto work = [src=std::move(*this), f=std::forward<F>(f)]() mutable {
+    if constexpr(std::is_void_v<T>) {
+      src.get();
+      return std::invoke(f);
+    }
+    else {
+      return std::invoke(f, src.get());
+    }
+  };
+
+  // a future that no executor produces is ready or invalid already
+  if(executor == nullptr) {
+    using R = std::invoke_result_t<decltype(work)&>;
+    std::packaged_task<R()> p(std::move(work));
+    dubhe::Future<R> fu(p.get_future(), nullptr);
+    p();
+    return fu;
+  }
+
+  executor->_increment_topology();
+
+  Node* node;
+  auto fu = executor->_make_async(DefaultTaskParams{}, std::move(work), node);
+
+  auto ready = [executor, node](){ executor->_schedule_deferred(node); };
+
+  if(continuations) {
+    continuations->_add(std::move(ready));
+  }
+  else {
+    ready();
+  }
+
+  return fu;
+}
+
+// Function: when_all
+template <typename I>
+auto when_all(I first, I last) {
+
+  using F = typename std::iterator_traits<I>::value_type;
+
+  struct State {
+    std::vector<F> futures;
+    std::atomic<size_t> count;
+  };
+
+  auto state = std::make_shared<State>();
+  Executor* executor = nullptr;
+
+  for(; first != last; ++first) {
+    if(executor == nullptr) {
+      executor = first->_executor;
+    }
+    state->futures.push_back(std::move(*first));
+  }
+
+  if(executor == nullptr) {
+    std::promise<std::vector<F>> p;
+    p.set_value(std::move(state->futures));
+    return Future<std::vector<F>>(p.get_future(), nullptr);
+  }
+
+  // The producers are looked up before any of them can complete the
+  // combined task, which moves the futures away. One extra count keeps
+  // the task from being scheduled until all callbacks are in place.
+  std::vector<std::shared_ptr<Continuations>> continuations;
+  continuations.reserve(state->futures.size());
+  for(auto& fu : state->futures) {
+    continuations.push_back(fu._continuations.lock());
+  }
+
+  state->count.store(continuations.size() + 1, std::memory_order_relaxed);
+
+  executor->_increment_topology();
+
+  Node* node;
+  auto fu = executor->_make_async(DefaultTaskParams{},
+    [state](){ return std::move(state->futures); }, node
+  );
+
+  auto arrive = [state, executor, node](){
+    if(state->count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      executor->_schedule_deferred(node);
+    }
+  };
+
+  for(auto& c : continuations) {
+    if(c) {
+      c->_add(arrive);
+    }
+    else {
+      arrive();
+    }
+  }
+  arrive();
+
+  return fu;
+}
+
+// Function: when_any
+template <typename I>
+auto when_any(I first, I last) {
+
+  using F = typename std::iterator_traits<I>::value_type;
+  using R = WhenAnyResult<std::vector<F>>;
+
+  struct State {
+    std::vector<F> futures;
+    std::atomic<size_t> index {static_cast<size_t>(-1)};
+  };
+
+  auto state = std::make_shared<State>();
+  Executor* executor = nullptr;
+
+  for(; first != last; ++first) {
+    if(executor == nullptr) {
+      executor = first->_executor;
+    }
+    state->futures.push_back(std::move(*first));
+  }
+
+  if(executor == nullptr) {
+    std::promise<R> p;
+    p.set_value(R{state->futures.empty() ? static_cast<size_t>(-1) : 0, std::move(state->futures)});
+    return Future<R>(p.get_future(), nullptr);
+  }
+
+  std::vector<std::shared_ptr<Continuations>> continuations;
+  continuations.reserve(state->futures.size());
+  for(auto& fu : state->futures) {
+    continuations.push_back(fu._continuations.lock());
+  }
+
+  executor->_increment_topology();
+
+  Node* node;
+  auto fu = executor->_make_async(DefaultTaskParams{},
+    [state](){
+      return R{state->index.load(std::memory_order_relaxed), std::move(state->futures)};
+    },
+    node
+  );
+
+  // the first future to become ready wins and schedules the combined task
+  for(size_t i=0; i<continuations.size(); ++i) {
+    auto arrive = [state, executor, node, i](){
+      size_t none = static_cast<size_t>(-1);
+      if(state->index.compare_exchange_strong(none, i, std::memory_order_acq_rel)) {
+        executor->_schedule_deferred(node);
+      }
+    };
+    if(continuations[i]) {
+      continuations[i]->_add(std::move(arrive));
+    }
+    else {
+      arrive();
+    }
+  }
+
+  return fu;
+}
+
+// ----------------------------------------------------------------------------
+// Silent Async Bulk
+// ----------------------------------------------------------------------------
+
+// Function: silent_async_bulk
+template <typename P, typename I,
+  std::enable_if_t<is_task_params_v<P>, void>*
+>
+void Executor::silent_async_bulk(P&& params, I first, I last) {
+  _silent_async_bulk(
+    std::forward<P>(params), static_cast<size_t>(std::distance(first, last)),
+    [&first](size_t) { return *first++; }
+  );
+}
+
+// Function: silent_async_bulk
+template <typename I>
+void Executor::silent_async_bulk(I first, I last) {
+  silent_async_bulk(DefaultTaskParams{}, first, last);
+}
+
+// Function: silent_async_bulk
+template <typename P, typename F,
+  std::enable_if_t<is_task_params_v<P>, void>*
+>
+void Executor::silent_async_bulk(P&& params, size_t beg, size_t end, F&& f) {
+  _silent_async_bulk(
+    std::forward<P>(params), beg < end ? end - beg : 0,
+    [beg, &f](size_t i) { return [f, i=beg+i]() mutable { f(i); }; }
+  );
+}
+
+// Function: silent_async_bulk
+template <typename F>
+void Executor::silent_async_bulk(size_t beg, size_t end, F&& f) {
+  silent_async_bulk(DefaultTaskParams{}, beg, end, std::forward<F>(f));
+}
+
+// Function: _silent_async_bulk
+// creates n asynchronous tasks where the i-th task runs gen(i)
+template <typename P, typename G>
+void Executor::_silent_async_bulk(P&& params, size_t n, G&& gen) {
+
+  if(n == 0) {
+    return;
+  }
+
+  // beyond the bound of pending tasks, tasks without runtime may run inline
+  constexpr bool inlinable = std::is_invocable_v<decltype(gen(size_t{0}))>;
+
+  if(!_reserve(_params_tenant(params), n, inlinable)) {
+    if constexpr(inlinable) {
+      for(size_t i=0; i<n; ++i) {
+        std::invoke(gen(i));
+      }
+    }
+    return;
+  }
+
+  _increment_topology(n);
+
+  std::vector<Node*> nodes(n);
+
+  // the handles are shared arguments of the batch and must be copyable,
+  // so they start out as no-ops and take their callables below
+  node_pool.animate_n(n, nodes.data(),
+    params, nullptr, nullptr, 0,
+    // handle
+    std::in_place_type_t<Node::Async>{}, [](){}
+  );
+
+  for(size_t i=0; i<n; ++i) {
+    std::get_if<Node::Async>(&nodes[i]->_handle)->work = gen(i);
+  }
+
+  _schedule_async_tasks(nodes.data(), n, priority_bucket(nodes[0]->_priority));
+}
+
 // ----------------------------------------------------------------------------
 // Async Helper Methods
 // ----------------------------------------------------------------------------
@@ -95,6 +538,50 @@ inline void Executor::_schedule_async_task(Node* node) {
   }
 }
 
+// Procedure: _schedule_async_tasks
+// schedules a batch of asynchronous tasks of the same priority with
+// one push and one notification
+inline void Executor::_schedule_async_tasks(Node** nodes, size_t n, unsigned p) {
+
+  auto d = nodes[0]->_effective_deadline();
+  auto t = nodes[0]->_effective_tenant();
+
+  for(size_t i=0; i<n; ++i) {
+    nodes[i]->_state.fetch_or(Node::READY, std::memory_order_release);
+  }
+
+  auto w = _this_worker();
+
+  if(d != std::chrono::steady_clock::time_point::max()) {
+    _push_deadline_tasks(w ? w->_group : _injection_group(), nodes, n, d);
+    _notifier.notify_n(n);
+    return;
+  }
+
+  // tasks beyond the share of their tenant are held back
+  if(t) {
+    size_t m = 0;
+    while(m < n && _admit_tenant_task(nodes[m], t)) {
+      ++m;
+    }
+    if(m < n) {
+      _hold_tenant_tasks(w ? w->_group : _injection_group(), nodes + m, n - m, t);
+    }
+    if((n = m) == 0) {
+      return;
+    }
+  }
+
+  if(w) {
+    w->_wsq.bulk_push(nodes, n, p);
+  }
+  else {
+    _groups[_injection_group()]._wsq.bulk_push(nodes, n, p);
+  }
+
+  _notifier.notify_n(n);
+}
+
 // Procedure: _tear_down_async
 inline void Executor::_tear_down_async(Node* node) {
   // from runtime
@@ -103,9 +590,10 @@ inline void Executor::_tear_down_async(Node* node) {
   }
   // from executor
   else {
+    _release(node->_tenant);
     _decrement_topology();
   }
-  node_pool.recycle(node);
+  recycle_node(node);
 }
 
 // ----------------------------------------------------------------------------
@@ -217,7 +705,7 @@ auto Executor::dependent_async(P&& params, F&& func, Tasks&&... tasks) {
   AsyncTask task(node_pool.animate(
     std::forward<P>(params), nullptr, nullptr, num_dependents,
     std::in_place_type_t<Node::DependentAsync>{},
-    [p=make_moc(std::move(p))] () mutable { p.object(); }
+    std::move(p)
   ));
   
   if constexpr(sizeof...(Tasks) > 0) {
@@ -257,7 +745,7 @@ auto Executor::dependent_async(P&& params, F&& func, I first, I last) {
   AsyncTask task(node_pool.animate(
     std::forward<P>(params), nullptr, nullptr, num_dependents,
     std::in_place_type_t<Node::DependentAsync>{},
-    [p=make_moc(std::move(p))] () mutable { p.object(); }
+    std::move(p)
   ));
 
   for(; first != last; first++) {
@@ -325,6 +813,10 @@ inline void Executor::_tear_down_dependent_async(Worker& worker, Node* node) {
     if(auto s = node->_successors[i]; 
       s->_join_counter.fetch_sub(1, std::memory_order_acq_rel) == 1
     ) {
+      if(!_runs_here(worker, s)) {
+        _schedule(worker, s);
+        continue;
+      }
       if(worker._cache) {
         _schedule(worker, worker._cache);
       }
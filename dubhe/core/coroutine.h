@@ -0,0 +1,710 @@
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <dubhe/core/async.h>
+
+/**
+@file coroutine.h
+@brief coroutine include file
+
+The coroutine tasks require C++20 and are not available otherwise.
+*/
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+#include <array>
+#include <coroutine>
+#include <exception>
+#include <future>
+#include <optional>
+#include <utility>
+
+namespace dubhe {
+
+    namespace detail {
+      template <typename T>
+      Coroutine<void> co_root(Coroutine<T>, std::promise<T>);
+    }  // namespace detail
+
+    // ----------------------------------------------------------------------------
+    // CoroutineFramePool
+    // ----------------------------------------------------------------------------
+
+    /**
+    @private
+
+    @brief class to recycle coroutine frames
+
+    Frames are cached per thread in size classes of 64 bytes up to 2 KB.
+    A frame freed by another thread than the one that allocated it joins
+    the cache of the freeing thread, and larger frames go to the global
+    allocator directly.
+    */
+    class CoroutineFramePool {
+
+      static constexpr size_t GRANULARITY = 64;
+      static constexpr size_t NUM_CLASSES = 32;
+      static constexpr size_t MAX_CACHED  = 256;
+
+      public:
+
+        static void* allocate(size_t size) {
+          auto c = (size + GRANULARITY - 1) / GRANULARITY;
+          if(c == 0 || c > NUM_CLASSES) {
+            return ::operator new(size);
+          }
+          auto& cache = _cache();
+          if(auto block = cache.heads[c-1]; block) {
+            cache.heads[c-1] = block->next;
+            --cache.sizes[c-1];
+            return block;
+          }
+          return ::operator new(c * GRANULARITY);
+        }
+
+        static void deallocate(void* ptr, size_t size) noexcept {
+          auto c = (size + GRANULARITY - 1) / GRANULARITY;
+          if(c == 0 || c > NUM_CLASSES) {
+            ::operator delete(ptr);
+            return;
+          }
+          auto& cache = _cache();
+          if(cache.sizes[c-1] == MAX_CACHED) {
+            ::operator delete(ptr);
+            return;
+          }
+          auto block = static_cast<Block*>(ptr);
+          block->next = cache.heads[c-1];
+          cache.heads[c-1] = block;
+          ++cache.sizes[c-1];
+        }
+
+      private:
+
+        struct Block {
+          Block* next;
+        };
+
+        struct Cache {
+          std::array<Block*, NUM_CLASSES> heads {};
+          std::array<size_t, NUM_CLASSES> sizes {};
+          ~Cache() {
+            for(auto head : heads) {
+              while(head) {
+                auto next = head->next;
+                ::operator delete(head);
+                head = next;
+              }
+            }
+          }
+        };
+
+        static Cache& _cache() {
+          thread_local Cache cache;
+          return cache;
+        }
+    };
+
+    // ----------------------------------------------------------------------------
+    // Awaitable Tags
+    // ----------------------------------------------------------------------------
+
+    /**
+    @private
+    */
+    struct CoroutineSleep {
+      std::chrono::steady_clock::time_point tp;
+    };
+
+    /**
+    @private
+    */
+    struct CoroutineRelease {
+      Semaphore* semaphore;
+    };
+
+    /**
+    @brief suspends the calling coroutine task until the given time
+
+    @code{.cpp}
+    co_await dubhe::sleep_until(std::chrono::steady_clock::now() + 10ms);
+    @endcode
+
+    The coroutine is resumed by a timer of its executor and holds no worker
+    while it sleeps.
+    */
+    inline CoroutineSleep sleep_until(std::chrono::steady_clock::time_point tp) {
+      return CoroutineSleep{tp};
+    }
+
+    /**
+    @brief suspends the calling coroutine task for the given duration
+
+    @code{.cpp}
+    co_await dubhe::sleep_for(10ms);
+    @endcode
+    */
+    template <typename Rep, typename Period>
+    CoroutineSleep sleep_for(const std::chrono::duration<Rep, Period>& duration) {
+      return CoroutineSleep{
+        std::chrono::steady_clock::now() +
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(duration)
+      };
+    }
+
+    /**
+    @brief releases a semaphore acquired by <tt>co_await semaphore</tt>
+
+    The release reschedules the tasks and coroutines waiting for the
+    semaphore and never suspends the calling coroutine.
+
+    @code{.cpp}
+    co_await semaphore;
+    critical_section();
+    co_await dubhe::release(semaphore);
+    @endcode
+    */
+    inline CoroutineRelease release(Semaphore& semaphore) {
+      return CoroutineRelease{&semaphore};
+    }
+
+    // ----------------------------------------------------------------------------
+    // CoroutinePromiseBase
+    // ----------------------------------------------------------------------------
+
+    /**
+    @private
+
+    @brief base class of the promise of a coroutine task
+
+    The promise keeps the executor of the coroutine and turns the awaitable
+    objects of dubhe into awaiters that suspend the coroutine and resume it
+    as a task of that executor once the awaited event has happened.
+    */
+    class CoroutinePromiseBase {
+
+      friend class Executor;
+
+      template <typename T>
+      friend class Coroutine;
+
+      public:
+
+        static void* operator new(size_t size) {
+          return CoroutineFramePool::allocate(size);
+        }
+
+        static void operator delete(void* ptr, size_t size) noexcept {
+          CoroutineFramePool::deallocate(ptr, size);
+        }
+
+        // a coroutine task starts when spawned or awaited
+        std::suspend_always initial_suspend() noexcept {
+          return {};
+        }
+
+        auto final_suspend() noexcept {
+          return FinalAwaiter{};
+        }
+
+        void unhandled_exception() noexcept {
+          _exception = std::current_exception();
+        }
+
+        template <typename A>
+        A&& await_transform(A&& awaitable) noexcept {
+          return std::forward<A>(awaitable);
+        }
+
+        auto await_transform(AsyncTask task) {
+          return AsyncTaskAwaiter{_executor, std::move(task)};
+        }
+
+        template <typename T>
+        auto await_transform(Future<T>& future) {
+          return ContinuationAwaiter<Future<T>&>{_executor, future};
+        }
+
+        // a temporary future, such as the result of dubhe::Executor::async,
+        // is kept by the awaiter until the coroutine resumes
+        template <typename T>
+        auto await_transform(Future<T>&& future) {
+          return ContinuationAwaiter<Future<T>>{_executor, std::move(future)};
+        }
+
+        template <typename T>
+        auto await_transform(std::future<T>& future) {
+          return FutureAwaiter<std::future<T>&>{_executor, future};
+        }
+
+        template <typename T>
+        auto await_transform(std::future<T>&& future) {
+          return FutureAwaiter<std::future<T>>{_executor, std::move(future)};
+        }
+
+        auto await_transform(Semaphore& semaphore) {
+          return SemaphoreAwaiter{_executor, semaphore};
+        }
+
+        auto await_transform(CoroutineSleep sleep) {
+          return SleepAwaiter{_executor, sleep.tp};
+        }
+
+        auto await_transform(CoroutineRelease release) {
+          auto nodes = release.semaphore->_release();
+          for(auto node : nodes) {
+            _executor->_schedule_async_task(node);
+          }
+          return std::suspend_never{};
+        }
+
+      protected:
+
+        Executor* _executor {nullptr};
+        std::coroutine_handle<> _continuation;
+        std::exception_ptr _exception;
+
+      private:
+
+        // a spawned coroutine owns its frame and accounts for its run
+        bool _detached {false};
+
+        // Procedure: _resume
+        // resumes the coroutine as an asynchronous task of the executor
+        static void _resume(Executor* executor, std::coroutine_handle<> h) {
+          executor->_num_pending.fetch_add(1, std::memory_order_relaxed);
+          executor->_silent_async(DefaultTaskParams{}, [h](){ h.resume(); });
+        }
+
+        // Procedure: _resume_at
+        // resumes the coroutine at the given time through the timer wheel
+        template <typename F>
+        static void _resume_at(Executor* executor, std::chrono::steady_clock::time_point tp, F&& f) {
+          executor->_increment_topology();
+          auto node = node_pool.animate(
+            DefaultTaskParams{}, nullptr, nullptr, 0,
+            // handle
+            std::in_place_type_t<Node::Async>{}, std::forward<F>(f)
+          );
+          executor->_arm_timer(tp, node, true);
+        }
+
+        struct FinalAwaiter {
+
+          bool await_ready() noexcept {
+            return false;
+          }
+
+          template <typename P>
+          std::coroutine_handle<> await_suspend(std::coroutine_handle<P> h) noexcept {
+            auto& promise = h.promise();
+            if(promise._continuation) {
+              return promise._continuation;
+            }
+            if(promise._detached) {
+              auto executor = promise._executor;
+              h.destroy();
+              executor->_release(nullptr);
+              executor->_decrement_topology();
+            }
+            return std::noop_coroutine();
+          }
+
+          void await_resume() noexcept {
+          }
+        };
+
+        // resumes the coroutine from a dependent-async task of the awaited
+        // task, such that it runs right after the task without another hop
+        struct AsyncTaskAwaiter {
+
+          Executor* executor;
+          AsyncTask task;
+
+          bool await_ready() const {
+            return task.empty() || task.is_done();
+          }
+
+          void await_suspend(std::coroutine_handle<> h) {
+            executor->silent_dependent_async([h](){ h.resume(); }, task);
+          }
+
+          void await_resume() noexcept {
+          }
+        };
+
+        // resumes the coroutine from a continuation of the future, which
+        // runs once the producer of the future has finished; F is either a
+        // reference to the awaited future or the future itself
+        template <typename F>
+        struct ContinuationAwaiter {
+
+          Executor* executor;
+          F future;
+
+          bool await_ready() const {
+            return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+          }
+
+          void await_suspend(std::coroutine_handle<> h) {
+            future._on_ready([executor=executor, h](){ _resume(executor, h); });
+          }
+
+          auto await_resume() {
+            return future.get();
+          }
+        };
+
+        // A std::future has no completion hook, so the awaiter checks it
+        // from the timer wheel with a backoff from 1 us up to 1 ms between
+        // the checks; no worker is held in between.
+        template <typename F>
+        struct FutureAwaiter {
+
+          Executor* executor;
+          F future;
+          std::coroutine_handle<> handle {};
+          std::chrono::nanoseconds backoff {std::chrono::microseconds(1)};
+
+          bool await_ready() const {
+            return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+          }
+
+          void await_suspend(std::coroutine_handle<> h) {
+            handle = h;
+            _poll();
+          }
+
+          auto await_resume() {
+            return future.get();
+          }
+
+          void _poll() {
+            _resume_at(executor, std::chrono::steady_clock::now() + backoff, [this](){
+              if(await_ready()) {
+                handle.resume();
+              }
+              else {
+                backoff = std::min<std::chrono::nanoseconds>(backoff * 2, std::chrono::milliseconds(1));
+                _poll();
+              }
+            });
+          }
+        };
+
+        // A coroutine that cannot acquire the semaphore right away waits as
+        // a task on the semaphore, which the executor resumes once the task
+        // has acquired the semaphore.
+        struct SemaphoreAwaiter {
+
+          Executor* executor;
+          Semaphore& semaphore;
+
+          bool await_ready() {
+            return semaphore._try_acquire();
+          }
+
+          void await_suspend(std::coroutine_handle<> h) {
+            executor->_increment_topology();
+            executor->_num_pending.fetch_add(1, std::memory_order_relaxed);
+            auto node = node_pool.animate(
+              DefaultTaskParams{}, nullptr, nullptr, 0,
+              // handle
+              std::in_place_type_t<Node::Async>{}, [h](){ h.resume(); }
+            );
+            node->_meta_data().semaphores.to_acquire.push_back(&semaphore);
+            executor->_schedule_async_task(node);
+          }
+
+          void await_resume() noexcept {
+          }
+        };
+
+        struct SleepAwaiter {
+
+          Executor* executor;
+          std::chrono::steady_clock::time_point tp;
+
+          bool await_ready() const {
+            return std::chrono::steady_clock::now() >= tp;
+          }
+
+          void await_suspend(std::coroutine_handle<> h) {
+            _resume_at(executor, tp, [h](){ h.resume(); });
+          }
+
+          void await_resume() noexcept {
+          }
+        };
+    };
+
+    // ----------------------------------------------------------------------------
+    // CoroutinePromise
+    // ----------------------------------------------------------------------------
+
+    /**
+    @private
+    */
+    template <typename T>
+    class CoroutinePromise : public CoroutinePromiseBase {
+
+      template <typename U>
+      friend class Coroutine;
+
+      public:
+
+        Coroutine<T> get_return_object();
+
+        template <typename U>
+        void return_value(U&& value) {
+          _value.emplace(std::forward<U>(value));
+        }
+
+      private:
+
+        std::optional<T> _value;
+
+        T _result() {
+          if(_exception) {
+            std::rethrow_exception(_exception);
+          }
+          return std::move(*_value);
+        }
+    };
+
+    /**
+    @private
+    */
+    template <>
+    class CoroutinePromise<void> : public CoroutinePromiseBase {
+
+      template <typename U>
+      friend class Coroutine;
+
+      public:
+
+        Coroutine<void> get_return_object();
+
+        void return_void() noexcept {
+        }
+
+      private:
+
+        void _result() {
+          if(_exception) {
+            std::rethrow_exception(_exception);
+          }
+        }
+    };
+
+    // ----------------------------------------------------------------------------
+    // Coroutine
+    // ----------------------------------------------------------------------------
+
+    /**
+    @class Coroutine
+
+    @tparam T result type of the coroutine
+
+    @brief class to create a coroutine task that suspends without blocking
+           a worker
+
+    A coroutine task is a C++20 coroutine whose return type is
+    dubhe::Coroutine. It runs on the workers of the executor that spawns it
+    with dubhe::Executor::co_spawn and can @c co_await the following objects,
+    releasing the worker while it is suspended:
+
+    + a dubhe::AsyncTask, resuming once the task has finished;
+    + a dubhe::Future or a @std_future, resuming once the result is ready;
+    + a dubhe::Semaphore, resuming once the semaphore has been acquired
+      (release it with <tt>co_await dubhe::release(semaphore)</tt>);
+    + dubhe::sleep_for and dubhe::sleep_until, resuming at the given time;
+    + another dubhe::Coroutine, which runs on the same worker in place of
+      the caller and yields its result to the caller.
+
+    @code{.cpp}
+    dubhe::Coroutine<int> fetch(dubhe::Executor& executor, int key) {
+      auto task = executor.silent_dependent_async([key](){ load(key); });
+      co_await task;
+      co_await dubhe::sleep_for(std::chrono::milliseconds(1));
+      co_return key;
+    }
+
+    dubhe::Coroutine<int> sum(dubhe::Executor& executor) {
+      int s = 0;
+      for(int i=0; i<10; i++) {
+        s += co_await fetch(executor, i);
+      }
+      co_return s;
+    }
+
+    std::future<int> fu = executor.co_spawn(sum(executor));
+    @endcode
+
+    Thousands of coroutine tasks can be in flight on a few workers, since a
+    suspended coroutine occupies its frame only. Frames are recycled through
+    a per-thread pool. A coroutine task starts only when it is spawned or
+    awaited, and an exception that escapes it is rethrown to the awaiting
+    coroutine or stored in the future returned by dubhe::Executor::co_spawn.
+    */
+    template <typename T = void>
+    class Coroutine {
+
+      friend class Executor;
+      friend class CoroutinePromise<T>;
+
+      public:
+
+        /**
+        @brief promise type of the coroutine
+        */
+        using promise_type = CoroutinePromise<T>;
+
+        /**
+        @brief move constructor
+        */
+        Coroutine(Coroutine&& rhs) noexcept : _handle {std::exchange(rhs._handle, nullptr)} {
+        }
+
+        /**
+        @brief move assignment
+        */
+        Coroutine& operator = (Coroutine&& rhs) noexcept {
+          if(this != &rhs) {
+            if(_handle) {
+              _handle.destroy();
+            }
+            _handle = std::exchange(rhs._handle, nullptr);
+          }
+          return *this;
+        }
+
+        /**
+        @brief disabled copy constructor
+        */
+        Coroutine(const Coroutine&) = delete;
+
+        /**
+        @brief disabled copy assignment
+        */
+        Coroutine& operator = (const Coroutine&) = delete;
+
+        /**
+        @brief destroys the coroutine frame
+        */
+        ~Coroutine() {
+          if(_handle) {
+            _handle.destroy();
+          }
+        }
+
+        /**
+        @private
+        */
+        bool await_ready() const noexcept {
+          return false;
+        }
+
+        /**
+        @private
+        */
+        template <typename P>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<P> caller) noexcept {
+          _handle.promise()._executor = caller.promise()._executor;
+          _handle.promise()._continuation = caller;
+          return _handle;
+        }
+
+        /**
+        @private
+        */
+        T await_resume() {
+          return _handle.promise()._result();
+        }
+
+      private:
+
+        explicit Coroutine(std::coroutine_handle<promise_type> handle) : _handle {handle} {
+        }
+
+        std::coroutine_handle<promise_type> _handle;
+    };
+
+    // Function: get_return_object
+    template <typename T>
+    Coroutine<T> CoroutinePromise<T>::get_return_object() {
+      return Coroutine<T>(std::coroutine_handle<CoroutinePromise<T>>::from_promise(*this));
+    }
+
+    // Function: get_return_object
+    inline Coroutine<void> CoroutinePromise<void>::get_return_object() {
+      return Coroutine<void>(std::coroutine_handle<CoroutinePromise<void>>::from_promise(*this));
+    }
+
+    namespace detail {
+
+      // Function: co_root
+      // the detached coroutine that runs a spawned coroutine task and
+      // carries out its result to the future
+      template <typename T>
+      Coroutine<void> co_root(Coroutine<T> coro, std::promise<T> promise) {
+        try {
+          if constexpr(std::is_void_v<T>) {
+            co_await std::move(coro);
+            promise.set_value();
+          }
+          else {
+            promise.set_value(co_await std::move(coro));
+          }
+        }
+        catch(...) {
+          promise.set_exception(std::current_exception());
+        }
+      }
+
+    }  // namespace detail
+
+    // ----------------------------------------------------------------------------
+    // Executor::co_spawn
+    // ----------------------------------------------------------------------------
+
+    // Function: co_spawn
+    template <typename T>
+    std::future<T> Executor::co_spawn(Coroutine<T> coro) {
+
+      _reserve(nullptr, 1, false);
+      _increment_topology();
+
+      std::promise<T> promise;
+      auto future = promise.get_future();
+
+      auto root = detail::co_root(std::move(coro), std::move(promise));
+      auto handle = std::exchange(root._handle, nullptr);
+
+      handle.promise()._executor = this;
+      handle.promise()._detached = true;
+
+      CoroutinePromiseBase::_resume(this, handle);
+
+      return future;
+    }
+
+}  // namespace dubhe
+
+#endif
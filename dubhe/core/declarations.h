@@ -27,6 +27,10 @@ namespace dubhe {
     class Graph;
     class FlowBuilder;
     class Semaphore;
+    class Tenant;
+    class Timer;
+    class CoroutinePromiseBase;
+    class OverlappedRun;
     class Subflow;
     class Runtime;
     class Task;
@@ -45,6 +49,12 @@ namespace dubhe {
     template <typename T>
     class Future;
 
+    template <typename T>
+    class Coroutine;
+
+    template <typename T>
+    class LightFuture;
+
     template <typename...Fs>
     class Pipeline;
 
@@ -20,6 +20,8 @@
 #include <dubhe/core/observer.h>
 #include <dubhe/core/taskflow.h>
 #include <dubhe/core/async_task.h>
+#include <dubhe/core/executor_options.h>
+#include <dubhe/core/timer_wheel.h>
 
 /**
 @file executor.hpp
@@ -70,6 +72,17 @@ namespace dubhe {
       friend class FlowBuilder;
       friend class Subflow;
       friend class Runtime;
+      friend class CoroutinePromiseBase;
+      friend class OverlappedRun;
+
+      template <typename T>
+      friend class Future;
+
+      template <typename I>
+      friend auto when_all(I, I);
+
+      template <typename I>
+      friend auto when_any(I, I);
 
       public:
 
@@ -86,6 +99,30 @@ namespace dubhe {
       */
       explicit Executor(size_t N = std::thread::hardware_concurrency());
 
+      /**
+      @brief constructs the executor with @c N worker threads and the given options
+
+      @param N the number of workers
+      @param options scheduling options of the executor
+
+      With dubhe::ExecutorOptions::numa_aware enabled, the workers are split
+      into one group per NUMA node. Each group owns a shared queue for tasks
+      submitted from outside the executor, and a worker runs out of tasks
+      steals from its own group first, escalating to remote groups only after
+      dubhe::ExecutorOptions::num_local_steals failed attempts.
+      dubhe::ExecutorOptions::wait_policy decides how long an idle worker
+      keeps looking for tasks before it parks on the notifier.
+      dubhe::ExecutorOptions::elastic_policy lets the executor grow up to
+      dubhe::ElasticPolicy::max_workers workers at runtime.
+
+      @code{.cpp}
+      dubhe::ExecutorOptions options;
+      options.numa_aware = true;
+      dubhe::Executor executor(std::thread::hardware_concurrency(), options);
+      @endcode
+      */
+      Executor(size_t N, const ExecutorOptions& options);
+
       /**
       @brief destructs the executor
 
@@ -140,6 +177,149 @@ namespace dubhe {
       */
       dubhe::Future<void> run(Taskflow&& taskflow);
 
+      /**
+      @brief runs a taskflow once and returns a dubhe::LightFuture
+
+      @param taskflow a dubhe::Taskflow object
+
+      @return a dubhe::LightFuture that holds the result of the execution
+
+      This member function is equivalent to dubhe::Executor::run(Taskflow&)
+      but completes a pooled state rather than a @c std::promise, which
+      spares an allocation and a mutex per run (see dubhe::LightFuture).
+
+      @code{.cpp}
+      dubhe::LightFuture<void> future = executor.run(dubhe::light_future, taskflow);
+      future.wait();
+      @endcode
+
+      This member function is thread-safe.
+
+      @attention
+      The executor does not own the given taskflow. It is your responsibility to
+      ensure the taskflow remains alive during its execution.
+      */
+      LightFuture<void> run(LightFutureTag, Taskflow& taskflow);
+
+      /**
+      @brief runs a taskflow once with an absolute deadline
+
+      @param taskflow a dubhe::Taskflow object
+      @param deadline the absolute deadline of the run
+
+      @return a dubhe::Future that holds the result of the execution
+
+      Every task of this run without a deadline of its own (see
+      dubhe::Task::deadline) inherits the deadline of the run. Ready tasks
+      with a deadline are served in earliest-deadline-first order before
+      any task without a deadline, and a task completing after its deadline
+      is reported to dubhe::ObserverInterface::on_deadline_miss.
+
+      @code{.cpp}
+      auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(10);
+      dubhe::Future<void> future = executor.run(taskflow, deadline);
+      future.wait();
+      @endcode
+
+      This member function is thread-safe.
+
+      @attention
+      The executor does not own the given taskflow. It is your responsibility to
+      ensure the taskflow remains alive during its execution.
+      */
+      dubhe::Future<void> run(Taskflow& taskflow, std::chrono::steady_clock::time_point deadline);
+
+      /**
+      @brief runs a moved taskflow once with an absolute deadline
+
+      @param taskflow a moved dubhe::Taskflow object
+      @param deadline the absolute deadline of the run
+
+      @return a dubhe::Future that holds the result of the execution
+
+      This member function is thread-safe.
+      */
+      dubhe::Future<void> run(Taskflow&& taskflow, std::chrono::steady_clock::time_point deadline);
+
+      /**
+      @brief runs a taskflow once on behalf of a tenant
+
+      @param taskflow a dubhe::Taskflow object
+      @param tenant the tenant to run the taskflow for
+
+      @return a dubhe::Future that holds the result of the execution
+
+      Every task of this run without a tenant of its own (see
+      dubhe::Task::tenant) belongs to the given tenant. Ready tasks of all
+      tenants share the workers in proportion to the tenant weights
+      (see dubhe::Tenant).
+
+      @code{.cpp}
+      dubhe::Tenant tenant(2);
+      dubhe::Future<void> future = executor.run(taskflow, tenant);
+      future.wait();
+      @endcode
+
+      This member function is thread-safe.
+
+      @attention
+      The executor does not own the given taskflow and tenant. It is your
+      responsibility to ensure both remain alive during the execution.
+      */
+      dubhe::Future<void> run(Taskflow& taskflow, Tenant& tenant);
+
+      /**
+      @brief runs a moved taskflow once on behalf of a tenant
+
+      @param taskflow a moved dubhe::Taskflow object
+      @param tenant the tenant to run the taskflow for
+
+      @return a dubhe::Future that holds the result of the execution
+
+      This member function is thread-safe.
+      */
+      dubhe::Future<void> run(Taskflow&& taskflow, Tenant& tenant);
+
+      /**
+      @brief runs a taskflow once unless the bound of pending tasks is reached
+
+      @param taskflow a dubhe::Taskflow object
+
+      @return a dubhe::Future that holds the result of the execution, or
+              @std_nullopt if the run would exceed the bound of the executor
+              (see dubhe::BackpressurePolicy)
+
+      @code{.cpp}
+      if(auto future = executor.try_run(taskflow); future) {
+        future->wait();
+      }
+      else {
+        // shed the load
+      }
+      @endcode
+
+      This member function is thread-safe.
+
+      @attention
+      The executor does not own the given taskflow. It is your responsibility to
+      ensure the taskflow remains alive during its execution.
+      */
+      std::optional<dubhe::Future<void>> try_run(Taskflow& taskflow);
+
+      /**
+      @brief runs a taskflow once on behalf of a tenant unless the bound of
+             pending tasks of the executor or of the tenant is reached
+
+      @param taskflow a dubhe::Taskflow object
+      @param tenant the tenant to run the taskflow for
+
+      @return a dubhe::Future that holds the result of the execution, or
+              @std_nullopt if the run would exceed a bound
+
+      This member function is thread-safe.
+      */
+      std::optional<dubhe::Future<void>> try_run(Taskflow& taskflow, Tenant& tenant);
+
       /**
       @brief runs a taskflow once and invoke a callback upon completion
 
@@ -304,6 +484,88 @@ namespace dubhe {
       template<typename C>
       dubhe::Future<void> run_n(Taskflow&& taskflow, size_t N, C&& callable);
 
+      /**
+      @brief runs a taskflow for @c N times on behalf of a tenant
+
+      @param taskflow a dubhe::Taskflow object
+      @param N number of runs
+      @param tenant the tenant to run the taskflow for
+
+      @return a dubhe::Future that holds the result of the execution
+
+      Every task of these runs without a tenant of its own belongs to the
+      given tenant (see dubhe::Executor::run(Taskflow&, Tenant&)).
+
+      @code{.cpp}
+      dubhe::Tenant tenant(2);
+      executor.run_n(taskflow, 10, tenant).wait();
+      @endcode
+
+      This member function is thread-safe.
+
+      @attention
+      The executor does not own the given taskflow and tenant. It is your
+      responsibility to ensure both remain alive during the execution.
+      */
+      dubhe::Future<void> run_n(Taskflow& taskflow, size_t N, Tenant& tenant);
+
+      /**
+      @brief runs a moved taskflow for @c N times on behalf of a tenant
+
+      @param taskflow a moved dubhe::Taskflow object
+      @param N number of runs
+      @param tenant the tenant to run the taskflow for
+
+      @return a dubhe::Future that holds the result of the execution
+
+      This member function is thread-safe.
+      */
+      dubhe::Future<void> run_n(Taskflow&& taskflow, size_t N, Tenant& tenant);
+
+      /**
+      @brief runs a taskflow for @c N times with up to @c K iterations
+             in flight at once
+
+      @param taskflow a dubhe::Taskflow object
+      @param N number of runs
+      @param K maximum number of iterations that run concurrently
+
+      @return a dubhe::Future that holds the result of the execution
+
+      Unlike dubhe::Executor::run_n, which starts an iteration only after
+      the previous one has drained, this member function lets a task of
+      the next iteration run as soon as its dependencies allow,
+      such that the next iteration fills the workers idle during the tail
+      of the current one. A task of iteration @c j runs after its
+      dependents of iteration @c j and after itself of iteration
+      <tt>j-1</tt>. Dependencies that cross iterations are declared
+      with dubhe::Task::precede_next.
+
+      @code{.cpp}
+      auto read  = taskflow.emplace([](){ read_frame(); });
+      auto work  = taskflow.emplace([](){ process_frame(); });
+      auto write = taskflow.emplace([](){ write_frame(); });
+      read.precede(work);
+      work.precede(write);
+      write.precede_next(read);    // the next read waits for this write
+      executor.run_n_overlapped(taskflow, 100, 4).wait();
+      @endcode
+
+      Only static tasks and placeholders can be run this way. The tasks
+      run as asynchronous tasks of the executor at the priority of their
+      nodes, and an exception stops the remaining tasks from running and
+      is carried by the returned future. The returned future cannot be
+      cancelled.
+
+      This member function is thread-safe.
+
+      @attention
+      The executor does not own the given taskflow. It is your responsibility
+      to ensure the taskflow remains alive and is neither modified nor run
+      otherwise during its execution.
+      */
+      dubhe::Future<void> run_n_overlapped(Taskflow& taskflow, size_t N, size_t K);
+
       /**
       @brief runs a taskflow multiple times until the predicate becomes true
 
@@ -515,7 +777,8 @@ namespace dubhe {
       @brief queries the number of worker threads
 
       Each worker represents one unique thread spawned by an executor
-      upon its construction time.
+      upon its construction time or by Executor::add_workers.
+      Workers being retired by Executor::remove_workers are not counted.
 
       @code{.cpp}
       dubhe::Executor executor(4);
@@ -524,6 +787,66 @@ namespace dubhe {
       */
       size_t num_workers() const noexcept;
 
+      /**
+      @brief queries the maximum number of worker threads
+
+      The executor preallocates this many worker slots at its construction
+      time, as given by dubhe::ElasticPolicy::max_workers or otherwise the
+      initial number of workers.
+      */
+      size_t max_num_workers() const noexcept;
+
+      /**
+      @brief adds workers to the executor
+
+      @param n the number of workers to add
+
+      @return the number of workers actually added, which is limited by
+              Executor::max_num_workers
+
+      New workers are placed in the worker group with the fewest active
+      workers relative to its size and start stealing tasks at once.
+      A worker that is being retired but has not yet exited is revived
+      instead of spawning a new thread.
+
+      @code{.cpp}
+      dubhe::ExecutorOptions options;
+      options.elastic_policy.max_workers = 8;
+      dubhe::Executor executor(2, options);
+      executor.add_workers(4);
+      std::cout << executor.num_workers();    // 6
+      @endcode
+
+      This member function is thread-safe.
+      */
+      size_t add_workers(size_t n);
+
+      /**
+      @brief retires workers from the executor
+
+      @param n the number of workers to retire
+
+      @return the number of workers actually retired, which keeps at least
+              one worker in the executor
+
+      A retired worker finishes its running task and the tasks in its own
+      queue before its thread exits, and it never parks again. The call
+      does not wait for the retired threads to exit and can therefore be
+      made from a worker of the executor.
+
+      This member function is thread-safe.
+      */
+      size_t remove_workers(size_t n);
+
+      /**
+      @brief queries the number of worker groups
+
+      Without dubhe::ExecutorOptions::numa_aware, all workers form a single
+      group. Otherwise, there is one group per NUMA node that has been
+      given at least one worker.
+      */
+      size_t num_worker_groups() const noexcept;
+
       /**
       @brief queries the number of running topologies at the time of this call
 
@@ -549,11 +872,28 @@ namespace dubhe {
       */
       size_t num_taskflows() const;
 
+      /**
+      @brief queries the number of tasks that have completed past their
+             deadline since the executor was created
+      */
+      size_t num_deadline_misses() const noexcept;
+
+      /**
+      @brief queries the number of pending tasks bounded by
+             dubhe::BackpressurePolicy
+
+      @code{.cpp}
+      executor.silent_async([](){});
+      std::cout << executor.num_pending();  // 0 or 1 (task still pending)
+      @endcode
+      */
+      size_t num_pending() const noexcept;
+
       /**
       @brief queries the id of the caller thread in this executor
 
       Each worker has an unique id in the range of @c 0 to @c N-1 associated with
-      its parent executor.
+      its parent executor, where @c N is Executor::max_num_workers.
       If the caller thread does not belong to the executor, @c -1 is returned.
 
       @code{.cpp}
@@ -618,14 +958,14 @@ namespace dubhe {
       @param params task parameters
       @param func callable object
 
-      @return a @std_future that will hold the result of the execution
+      @return a dubhe::Future that will hold the result of the execution
 
       The method creates a parameterized asynchronous task
-      to run the given function and return a @std_future object
+      to run the given function and return a dubhe::Future object
       that eventually will hold the result of the execution.
 
       @code{.cpp}
-      std::future<int> future = executor.async("name", [](){
+      dubhe::Future<int> future = executor.async("name", [](){
         std::cout << "create an asynchronous task with a name and returns 1\n";
         return 1;
       });
@@ -644,14 +984,14 @@ namespace dubhe {
 
       @param func callable object
 
-      @return a @std_future that will hold the result of the execution
+      @return a dubhe::Future that will hold the result of the execution
 
       The method creates an asynchronous task to run the given function
-      and return a @std_future object that eventually will hold the result
+      and return a dubhe::Future object that eventually will hold the result
       of the return value.
 
       @code{.cpp}
-      std::future<int> future = executor.async([](){
+      dubhe::Future<int> future = executor.async([](){
         std::cout << "create an asynchronous task and returns 1\n";
         return 1;
       });
@@ -663,6 +1003,50 @@ namespace dubhe {
       template <typename F>
       auto async(F&& func);
 
+      /**
+      @brief runs a given function asynchronously and returns a
+             dubhe::LightFuture
+
+      @tparam F callable type
+
+      @param func callable object
+
+      @return a dubhe::LightFuture that will hold the result of the execution
+
+      This member function is equivalent to dubhe::Executor::async(F&&) but
+      keeps the result in a pooled state rather than a @std_future,
+      which spares the allocations and the mutex of a @c std::promise
+      (see dubhe::LightFuture).
+
+      @code{.cpp}
+      dubhe::LightFuture<int> future = executor.async(dubhe::light_future, [](){
+        return 1;
+      });
+      assert(future.get() == 1);
+      @endcode
+
+      This member function is thread-safe.
+      */
+      template <typename F>
+      auto async(LightFutureTag, F&& func);
+
+      /**
+      @brief runs a given function asynchronously with the given task
+             parameters and returns a dubhe::LightFuture
+
+      @tparam P task parameter type
+      @tparam F callable type
+
+      @param params task parameters
+      @param func callable object
+
+      @return a dubhe::LightFuture that will hold the result of the execution
+
+      This member function is thread-safe.
+      */
+      template <typename P, typename F>
+      auto async(LightFutureTag, P&& params, F&& func);
+
       /**
       @brief similar to dubhe::Executor::async but does not return a future object
 
@@ -714,59 +1098,372 @@ namespace dubhe {
       template <typename F>
       void silent_async(F&& func);
 
-      // --------------------------------------------------------------------------
-      // Silent Dependent Async Methods
-      // --------------------------------------------------------------------------
-
       /**
-      @brief runs the given function asynchronously
-             when the given dependents finish
-
-      @tparam F callable type
-      @tparam Tasks task types convertible to dubhe::AsyncTask
+      @brief creates a batch of asynchronous tasks from a range of callables
 
-      @param func callable object
-      @param tasks asynchronous tasks on which this execution depends
+      @tparam P task parameters type
+      @tparam I iterator type
 
-      @return a dubhe::AsyncTask handle
+      @param params task parameters shared by all tasks
+      @param first iterator to the beginning of the callables (inclusive)
+      @param last iterator to the end of the callables (exclusive)
 
-      This member function is more efficient than dubhe::Executor::dependent_async
-      and is encouraged to use when you do not want a @std_future to
-      acquire the result or synchronize the execution.
-      The example below creates three asynchronous tasks, @c A, @c B, and @c C,
-      in which task @c C runs after task @c A and task @c B.
+      The method is equivalent to calling dubhe::Executor::silent_async
+      on every callable in the range, but it allocates all task nodes
+      under a single lock of the node pool, pushes them to the queue in one batch,
+      and wakes up the workers with one notification.
+      Each callable is copied (or moved, given a move iterator) into its task.
 
       @code{.cpp}
-      dubhe::AsyncTask A = executor.silent_dependent_async([](){ printf("A\n"); });
-      dubhe::AsyncTask B = executor.silent_dependent_async([](){ printf("B\n"); });
-      executor.silent_dependent_async([](){ printf("C runs after A and B\n"); }, A, B);
+      std::vector<std::function<void()>> funcs(1000, [](){ do_work(); });
+      executor.silent_async_bulk("batch", funcs.begin(), funcs.end());
       executor.wait_for_all();
       @endcode
 
       This member function is thread-safe.
       */
-      template <typename F, typename... Tasks,
-        std::enable_if_t<all_same_v<AsyncTask, std::decay_t<Tasks>...>, void>* = nullptr
+      template <typename P, typename I,
+        std::enable_if_t<is_task_params_v<P>, void>* = nullptr
       >
-      dubhe::AsyncTask silent_dependent_async(F&& func, Tasks&&... tasks);
+      void silent_async_bulk(P&& params, I first, I last);
 
       /**
-      @brief runs the given function asynchronously
-             when the given dependents finish
+      @brief creates a batch of asynchronous tasks from a range of callables
 
-      @tparam F callable type
-      @tparam Tasks task types convertible to dubhe::AsyncTask
+      @tparam I iterator type
 
-      @param params task parameters
-      @param func callable object
-      @param tasks asynchronous tasks on which this execution depends
+      @param first iterator to the beginning of the callables (inclusive)
+      @param last iterator to the end of the callables (exclusive)
 
-      @return a dubhe::AsyncTask handle
+      This member function is thread-safe.
+      */
+      template <typename I>
+      void silent_async_bulk(I first, I last);
 
-      This member function is more efficient than dubhe::Executor::dependent_async
-      and is encouraged to use when you do not want a @std_future to
-      acquire the result or synchronize the execution.
-      The example below creates three asynchronous tasks, @c A, @c B, and @c C,
+      /**
+      @brief creates a batch of asynchronous tasks over an index range
+
+      @tparam P task parameters type
+      @tparam F callable type
+
+      @param params task parameters shared by all tasks
+      @param beg beginning index (inclusive)
+      @param end ending index (exclusive)
+      @param func callable object invoked as @c func(i) for each index
+
+      The method creates one asynchronous task per index @c i in the range
+      <tt>[beg, end)</tt>, where each task holds its own copy of @c func.
+      Like dubhe::Executor::silent_async_bulk over callables, all task nodes
+      are submitted in one batch with a single notification.
+
+      @code{.cpp}
+      std::vector<int> data(1000);
+      executor.silent_async_bulk("fill", 0, data.size(), [&](size_t i){
+        data[i] = i;
+      });
+      executor.wait_for_all();
+      @endcode
+
+      This member function is thread-safe.
+      */
+      template <typename P, typename F,
+        std::enable_if_t<is_task_params_v<P>, void>* = nullptr
+      >
+      void silent_async_bulk(P&& params, size_t beg, size_t end, F&& func);
+
+      /**
+      @brief creates a batch of asynchronous tasks over an index range
+
+      @tparam F callable type
+
+      @param beg beginning index (inclusive)
+      @param end ending index (exclusive)
+      @param func callable object invoked as @c func(i) for each index
+
+      This member function is thread-safe.
+      */
+      template <typename F>
+      void silent_async_bulk(size_t beg, size_t end, F&& func);
+
+      /**
+      @brief runs a given function asynchronously unless the bound of
+             pending tasks is reached
+
+      @tparam P task parameter type
+      @tparam F callable type
+
+      @param params task parameters
+      @param func callable object
+
+      @return a dubhe::Future that will hold the result of the execution, or
+              @std_nullopt if the task would exceed the bound of the executor
+              or of the tenant in @c params (see dubhe::BackpressurePolicy)
+
+      @code{.cpp}
+      if(auto future = executor.try_async("name", [](){ return 1; }); future) {
+        future->get();
+      }
+      @endcode
+
+      This member function is thread-safe.
+      */
+      template <typename P, typename F>
+      auto try_async(P&& params, F&& func);
+
+      /**
+      @brief runs a given function asynchronously unless the bound of
+             pending tasks is reached
+
+      @tparam F callable type
+
+      @param func callable object
+
+      @return a dubhe::Future that will hold the result of the execution, or
+              @std_nullopt if the task would exceed the bound of the executor
+
+      This member function is thread-safe.
+      */
+      template <typename F>
+      auto try_async(F&& func);
+
+      /**
+      @brief similar to dubhe::Executor::try_async but does not return a
+             future object
+
+      @tparam P task parameter type
+      @tparam F callable type
+
+      @param params task parameters
+      @param func callable object
+
+      @return @c true if the task was submitted or @c false if the task
+              would exceed the bound of the executor or of the tenant in
+              @c params
+
+      @code{.cpp}
+      while(!executor.try_silent_async([](){ process(); })) {
+        drop_or_retry_later();
+      }
+      @endcode
+
+      This member function is thread-safe.
+      */
+      template <typename P, typename F>
+      bool try_silent_async(P&& params, F&& func);
+
+      /**
+      @brief similar to dubhe::Executor::try_async but does not return a
+             future object
+
+      @tparam F callable type
+
+      @param func callable object
+
+      @return @c true if the task was submitted or @c false if the task
+              would exceed the bound of the executor
+
+      This member function is thread-safe.
+      */
+      template <typename F>
+      bool try_silent_async(F&& func);
+
+      // --------------------------------------------------------------------------
+      // Timer Methods
+      // --------------------------------------------------------------------------
+
+      /**
+      @brief runs the given function asynchronously at the given time
+
+      @tparam F callable type
+
+      @param tp time at which the function becomes ready
+      @param func callable object
+
+      @return a dubhe::Future that will hold the result of the execution
+
+      The function runs as an asynchronous task no earlier than @c tp and,
+      with a worker free, at most about one tick of
+      dubhe::ExecutorOptions::timer_resolution later. A time in the past
+      schedules the function right away.
+      The timer counts as a pending execution of the executor, such that
+      dubhe::Executor::wait_for_all waits for it to fire and complete.
+
+      @code{.cpp}
+      auto fu = executor.schedule_at(std::chrono::steady_clock::now() + 1s, [](){
+        return 42;
+      });
+      assert(fu.get() == 42);
+      @endcode
+
+      This member function is thread-safe.
+      */
+      template <typename F>
+      auto schedule_at(std::chrono::steady_clock::time_point tp, F&& func);
+
+      /**
+      @brief runs the given function asynchronously after the given delay
+
+      @tparam Rep arithmetic type of the delay
+      @tparam Period tick period of the delay
+      @tparam F callable type
+
+      @param delay time to wait from now on
+      @param func callable object
+
+      @return a dubhe::Future that will hold the result of the execution
+
+      This member function is equivalent to
+      <tt>schedule_at(std::chrono::steady_clock::now() + delay, func)</tt>
+      and is thread-safe.
+      */
+      template <typename Rep, typename Period, typename F>
+      auto schedule_after(const std::chrono::duration<Rep, Period>& delay, F&& func);
+
+      /**
+      @brief runs the given function asynchronously once every period
+
+      @tparam Rep arithmetic type of the period
+      @tparam Period tick period of the period
+      @tparam F callable type
+
+      @param period positive time between two runs
+      @param func callable object
+
+      @return a dubhe::Timer to cancel the periodic task
+
+      The first run is one period from now. Each run is due one period after
+      the due time of the previous run rather than after its completion,
+      such that the schedule does not drift, and periods missed entirely,
+      for example because the previous run took longer than a period, are
+      skipped. Runs of the same timer never overlap.
+      A periodic timer does not count as a pending execution while it waits
+      and must be cancelled by the application; timers left at the
+      destruction of the executor are dropped.
+
+      @code{.cpp}
+      dubhe::Timer timer = executor.schedule_every(100ms, [](){ poll(); });
+      // ...
+      timer.cancel();
+      @endcode
+
+      This member function is thread-safe.
+      */
+      template <typename Rep, typename Period, typename F>
+      Timer schedule_every(const std::chrono::duration<Rep, Period>& period, F&& func);
+
+      /**
+      @brief runs the given function asynchronously once every period starting
+             from the given time
+
+      @tparam Rep arithmetic type of the period
+      @tparam Period tick period of the period
+      @tparam F callable type
+
+      @param first time of the first run
+      @param period positive time between two runs
+      @param func callable object
+
+      @return a dubhe::Timer to cancel the periodic task
+
+      This member function is thread-safe.
+      */
+      template <typename Rep, typename Period, typename F>
+      Timer schedule_every(
+        std::chrono::steady_clock::time_point first,
+        const std::chrono::duration<Rep, Period>& period,
+        F&& func
+      );
+
+      /**
+      @brief queries the number of timers waiting to fire
+      */
+      size_t num_timers() const noexcept;
+
+      // --------------------------------------------------------------------------
+      // Coroutine Methods
+      // --------------------------------------------------------------------------
+
+      /**
+      @brief runs the given coroutine task on the executor
+
+      @tparam T result type of the coroutine
+
+      @param coro coroutine task to run
+
+      @return a @std_future that will hold the result of the coroutine
+
+      The coroutine starts as an asynchronous task and runs on the workers
+      between its suspension points, without holding a worker while it is
+      suspended (see dubhe::Coroutine).
+      The coroutine counts as a pending execution of the executor until it
+      completes.
+
+      @code{.cpp}
+      dubhe::Coroutine<int> answer() {
+        co_await dubhe::sleep_for(std::chrono::milliseconds(10));
+        co_return 42;
+      }
+      assert(executor.co_spawn(answer()).get() == 42);
+      @endcode
+
+      This member function is thread-safe and requires C++20.
+      */
+      template <typename T>
+      std::future<T> co_spawn(Coroutine<T> coro);
+
+      // --------------------------------------------------------------------------
+      // Silent Dependent Async Methods
+      // --------------------------------------------------------------------------
+
+      /**
+      @brief runs the given function asynchronously
+             when the given dependents finish
+
+      @tparam F callable type
+      @tparam Tasks task types convertible to dubhe::AsyncTask
+
+      @param func callable object
+      @param tasks asynchronous tasks on which this execution depends
+
+      @return a dubhe::AsyncTask handle
+
+      This member function is more efficient than dubhe::Executor::dependent_async
+      and is encouraged to use when you do not want a @std_future to
+      acquire the result or synchronize the execution.
+      The example below creates three asynchronous tasks, @c A, @c B, and @c C,
+      in which task @c C runs after task @c A and task @c B.
+
+      @code{.cpp}
+      dubhe::AsyncTask A = executor.silent_dependent_async([](){ printf("A\n"); });
+      dubhe::AsyncTask B = executor.silent_dependent_async([](){ printf("B\n"); });
+      executor.silent_dependent_async([](){ printf("C runs after A and B\n"); }, A, B);
+      executor.wait_for_all();
+      @endcode
+
+      This member function is thread-safe.
+      */
+      template <typename F, typename... Tasks,
+        std::enable_if_t<all_same_v<AsyncTask, std::decay_t<Tasks>...>, void>* = nullptr
+      >
+      dubhe::AsyncTask silent_dependent_async(F&& func, Tasks&&... tasks);
+
+      /**
+      @brief runs the given function asynchronously
+             when the given dependents finish
+
+      @tparam F callable type
+      @tparam Tasks task types convertible to dubhe::AsyncTask
+
+      @param params task parameters
+      @param func callable object
+      @param tasks asynchronous tasks on which this execution depends
+
+      @return a dubhe::AsyncTask handle
+
+      This member function is more efficient than dubhe::Executor::dependent_async
+      and is encouraged to use when you do not want a @std_future to
+      acquire the result or synchronize the execution.
+      The example below creates three asynchronous tasks, @c A, @c B, and @c C,
       in which task @c C runs after task @c A and task @c B.
       Assigned task names will appear in the observers of the executor.
 
@@ -1050,41 +1747,172 @@ namespace dubhe {
 
       private:
 
-      const size_t _MAX_STEALS;
+      // bounds of failed steal attempts, which follow the number of active
+      // workers as the executor grows and shrinks; the wait policy may set
+      // its own bound for idle workers, which leaves these two unchanged
+      std::atomic<size_t> _MAX_STEALS;
+      std::atomic<size_t> _MAX_LOCAL_STEALS;
+
+      const size_t _num_local_steals;
+
+      const WaitPolicy _wait_policy;
+
+      const bool _shrink_on_idle;
+
+      const size_t _priority_aging;
+
+      const bool _replay_affinity;
+
+      const ElasticPolicy _elastic_policy;
 
-      std::mutex _wsq_mutex;
       std::mutex _taskflows_mutex;
 
     #ifdef __cpp_lib_atomic_wait
       std::atomic<size_t> _num_topologies {0};
-      std::atomic_flag _all_spawned = ATOMIC_FLAG_INIT;
     #else
       std::condition_variable _topology_cv;
       std::mutex _topology_mutex;
       size_t _num_topologies {0};
     #endif
 
-      std::unordered_map<std::thread::id, size_t> _wids;
       std::vector<std::thread> _threads;
       std::vector<Worker> _workers;
+      std::vector<WorkerGroup> _groups;
+      std::vector<size_t> _cpu_groups;
       std::list<Taskflow> _taskflows;
 
       Notifier _notifier;
 
-      TaskQueue<Node*> _wsq;
+      std::atomic<size_t> _next_group {0};
 
       std::atomic<bool> _done {0};
 
+      std::mutex _elastic_mutex;
+      std::condition_variable _elastic_cv;
+      std::thread _controller;
+      std::atomic<size_t> _num_workers {0};
+      std::unique_ptr<std::atomic<size_t>[]> _active_workers;
+      std::atomic<size_t> _num_parked {0};
+
+      // epoch of the arrays retired by the worker queues: a worker frees
+      // its retired arrays once every other worker has announced an epoch
+      // past the one it began to wait at
+      std::atomic<size_t> _steal_epoch {1};
+
+      std::atomic<size_t> _num_deadline_misses {0};
+
+      // tasks of a tenant beyond its share are held back in a queue of the
+      // tenant until tasks of the tenant finish
+      struct TenantQueue {
+        Tenant* tenant;
+        size_t weight;
+        std::deque<Node*> nodes;
+      };
+
+      std::mutex _tenant_mutex;
+      std::vector<TenantQueue> _tenant_queues;
+      uint64_t _tenant_vtime {0};
+      std::atomic<size_t> _held_weight {0};
+      std::atomic<size_t> _num_held_tasks {0};
+      std::atomic<size_t> _num_admitted {0};
+      std::atomic<bool> _tenant_keeper {false};
+
+      const BackpressurePolicy _backpressure;
+      std::atomic<size_t> _num_pending {0};
+      std::atomic<size_t> _num_blocked {0};
+      std::mutex _pending_mutex;
+      std::condition_variable _pending_cv;
+
+      // the flag of a timer tells whether its task is counted as a
+      // topology already, which is the case for one-shot timers only;
+      // periodic timers are no longer armed once the timers are stopped
+      std::mutex _timer_mutex;
+      TimerWheel<std::pair<Node*, bool>> _timers;
+      bool _timers_stopped {false};
+      std::atomic<size_t> _num_timers {0};
+      std::atomic<int64_t> _next_timer {INT64_MAX};
+      std::atomic<bool> _timer_keeper {false};
+
       std::unordered_set<std::shared_ptr<ObserverInterface>> _observers;
 
-      Worker* _this_worker();
+      Worker* _this_worker() const;
+
+      static Worker*& _per_thread_worker();
 
       bool _wait_for_task(Worker&, Node*&);
+      void _reclaim_arrays(Worker&);
       bool _invoke_module_task_internal(Worker&, Node*);
 
       void _observer_prologue(Worker&, Node*);
       void _observer_epilogue(Worker&, Node*);
       void _spawn(size_t);
+      size_t _grow(size_t);
+      size_t _shrink(size_t);
+      void _activate(size_t);
+      void _deactivate(size_t);
+      void _set_up_steals();
+      size_t _num_queued_tasks() const;
+      void _control();
+      bool _retire(Worker&);
+      void _set_up_groups(size_t, const ExecutorOptions&);
+      void _set_up_affinity(const ExecutorOptions&);
+      void _select_victim(Worker&, size_t);
+      void _push_to_group(size_t, Node*, unsigned);
+      Worker* _mailbox_of(Node*);
+      bool _runs_here(Worker&, Node*);
+      Node* _steal_from_mailbox(Worker&);
+      void _push_to_mailbox(Worker&, Node*, unsigned);
+      Node* _take_from_mailbox(Worker&);
+      size_t _injection_group();
+      Node* _steal_from_victim(Worker&);
+      Node* _steal_from_group(Worker&, size_t);
+      Node* _pop_task(Worker&);
+
+      template <typename Q, typename F>
+      Node* _take_aged(Q&, size_t*, F&&);
+
+      void _push_deadline_tasks(size_t, Node* const*, size_t, std::chrono::steady_clock::time_point);
+      Node* _pop_deadline_task(size_t);
+      void _check_deadline(Worker&, Node*);
+      size_t _tenant_cap(Tenant*) const;
+      bool _admit_tenant_task(Node*, Tenant*);
+      bool _tenants_admitted_elsewhere();
+      void _hold_tenant_tasks(size_t, Node* const*, size_t, Tenant*);
+      Node* _take_held_task(bool);
+      void _finish_tenant_task(Worker&, Node*, Tenant*);
+      void _charge_tenant(Worker&, Node*, Tenant*, std::chrono::steady_clock::time_point, int64_t);
+      bool _yield_cached(Worker&, Node*);
+      bool _yield_to_tenants(Worker&, Node*);
+
+      bool _try_reserve(Tenant*, size_t);
+      bool _reserve(Tenant*, size_t, bool);
+      void _release(Tenant*, size_t = 1);
+
+      template <typename P>
+      static Tenant* _params_tenant(const P&);
+
+      bool _timer_due() const;
+      void _arm_timer(std::chrono::steady_clock::time_point, Node*, bool);
+      void _stop_timers();
+      void _arm_periodic(std::shared_ptr<Timer::State>);
+      Node* _fire_timers(Worker&);
+
+      template <typename P, typename F>
+      auto _async(P&&, F&&);
+
+      template <typename P, typename F>
+      auto _make_async(P&&, F&&, Node*&);
+
+      void _schedule_deferred(Node*);
+
+      template <typename P, typename F>
+      void _silent_async(P&&, F&&);
+
+      template <typename P, typename C>
+      dubhe::Future<void> _run_until(
+        Taskflow&, P&&, C&&, std::chrono::steady_clock::time_point, Tenant* = nullptr, bool = false,
+        LightState<void>* = nullptr
+      );
       void _exploit_task(Worker&, Node*&);
       void _explore_task(Worker&, Node*&);
       void _schedule(Worker&, Node*);
@@ -1097,10 +1925,11 @@ namespace dubhe {
       void _tear_down_async(Node*);
       void _tear_down_dependent_async(Worker&, Node*);
       void _tear_down_invoke(Worker&, Node*);
-      void _increment_topology();
+      void _increment_topology(size_t = 1);
       void _decrement_topology();
       void _invoke(Worker&, Node*);
       void _invoke_static_task(Worker&, Node*);
+      Node* _invoke_fused_tasks(Worker&, Node*);
       void _invoke_subflow_task(Worker&, Node*);
       void _detach_subflow_task(Worker&, Node*, Graph&);
       void _invoke_condition_task(Worker&, Node*, SmallVector<int>&);
@@ -1111,6 +1940,10 @@ namespace dubhe {
       void _process_async_dependent(Node*, dubhe::AsyncTask&, size_t&);
       void _process_exception(Worker&, Node*);
       void _schedule_async_task(Node*);
+      void _schedule_async_tasks(Node**, size_t, unsigned);
+
+      template <typename P, typename G>
+      void _silent_async_bulk(P&&, size_t, G&&);
       void _corun_graph(Worker&, Node*, Graph&);
 
       template <typename P>
@@ -1118,17 +1951,38 @@ namespace dubhe {
     };
 
     // Constructor
-    inline Executor::Executor(size_t N) :
-      _MAX_STEALS {((N+1) << 1)},
-      _threads    {N},
-      _workers    {N},
-      _notifier   {N} {
+    inline Executor::Executor(size_t N) : Executor(N, ExecutorOptions{}) {
+    }
+
+    // Constructor
+    inline Executor::Executor(size_t N, const ExecutorOptions& options) :
+      _num_local_steals {options.num_local_steals},
+      _wait_policy {options.wait_policy},
+      _shrink_on_idle {options.shrink_on_idle},
+      _priority_aging {options.priority_aging},
+      _replay_affinity {options.replay_affinity},
+      _elastic_policy {options.elastic_policy},
+      _threads    {std::max(N, options.elastic_policy.max_workers)},
+      _workers    {std::max(N, options.elastic_policy.max_workers)},
+      _notifier   {std::max(N, options.elastic_policy.max_workers)},
+      _backpressure {options.backpressure},
+      _timers {options.timer_resolution} {
 
       if(N == 0) {
         DUBHE_THROW("executor must define at least one worker");
       }
 
-      _spawn(N);
+      _set_up_groups(_workers.size(), options);
+      _set_up_affinity(options);
+
+      {
+        std::scoped_lock lock(_elastic_mutex);
+        _grow(N);
+      }
+
+      if(_elastic_policy.automatic) {
+        _controller = std::thread([this](){ _control(); });
+      }
 
       // initialize the default observer if requested
       if(has_env(DUBHE_ENABLE_PROFILER)) {
@@ -1139,24 +1993,63 @@ namespace dubhe {
     // Destructor
     inline Executor::~Executor() {
 
-      // wait for all topologies to complete
+      // stop the periodic timers first, which would otherwise keep adding
+      // runs while and after we wait
+      _stop_timers();
+
+      // wait for all topologies to complete, including one-shot timers
       wait_for_all();
 
-      // shut down the scheduler
-      _done = true;
+      // shut down the controller and then the scheduler
+      {
+        std::scoped_lock lock(_elastic_mutex);
+        _done = true;
+      }
+      _elastic_cv.notify_one();
+
+      if(_controller.joinable()) {
+        _controller.join();
+      }
 
       _notifier.notify(true);
 
       for(auto& t : _threads){
-        t.join();
+        if(t.joinable()) {
+          t.join();
+        }
       }
+
+      // every timer left has fired or been dropped by now
+      assert(_timers.empty());
     }
 
     // Function: num_workers
     inline size_t Executor::num_workers() const noexcept {
+      return _num_workers.load(std::memory_order_relaxed);
+    }
+
+    // Function: max_num_workers
+    inline size_t Executor::max_num_workers() const noexcept {
       return _workers.size();
     }
 
+    // Function: add_workers
+    inline size_t Executor::add_workers(size_t n) {
+      std::scoped_lock lock(_elastic_mutex);
+      return _grow(n);
+    }
+
+    // Function: remove_workers
+    inline size_t Executor::remove_workers(size_t n) {
+      std::scoped_lock lock(_elastic_mutex);
+      return _shrink(n);
+    }
+
+    // Function: num_worker_groups
+    inline size_t Executor::num_worker_groups() const noexcept {
+      return _groups.size();
+    }
+
     // Function: num_topologies
     inline size_t Executor::num_topologies() const {
     #ifdef __cpp_lib_atomic_wait
@@ -1171,106 +2064,755 @@ namespace dubhe {
       return _taskflows.size();
     }
 
-    // Function: _this_worker
-    inline Worker* Executor::_this_worker() {
-      auto itr = _wids.find(std::this_thread::get_id());
-      return itr == _wids.end() ? nullptr : &_workers[itr->second];
+    // Function: num_deadline_misses
+    inline size_t Executor::num_deadline_misses() const noexcept {
+      return _num_deadline_misses.load(std::memory_order_relaxed);
     }
 
-    // Function: this_worker_id
-    inline int Executor::this_worker_id() const {
-      auto i = _wids.find(std::this_thread::get_id());
-      return i == _wids.end() ? -1 : static_cast<int>(_workers[i->second]._id);
+    // Function: num_pending
+    inline size_t Executor::num_pending() const noexcept {
+      return _num_pending.load(std::memory_order_relaxed);
     }
 
-    // Procedure: _spawn
-    inline void Executor::_spawn(size_t N) {
+    // Function: num_timers
+    inline size_t Executor::num_timers() const noexcept {
+      return _num_timers.load(std::memory_order_relaxed);
+    }
 
-    #ifdef __cpp_lib_atomic_wait
-    #else
-      std::mutex mutex;
-      std::condition_variable cond;
-      size_t n=0;
-    #endif
+    // Function: _per_thread_worker
+    // the worker run by the calling thread, or nullptr for a non-worker thread
+    inline Worker*& Executor::_per_thread_worker() {
+      thread_local Worker* worker {nullptr};
+      return worker;
+    }
+
+    // Function: _this_worker
+    inline Worker* Executor::_this_worker() const {
+      auto w = _per_thread_worker();
+      return (w && w->_executor == this) ? w : nullptr;
+    }
+
+    // Function: this_worker_id
+    inline int Executor::this_worker_id() const {
+      auto w = _this_worker();
+      return w ? static_cast<int>(w->_id) : -1;
+    }
+
+    // Procedure: _set_up_groups
+    inline void Executor::_set_up_groups(size_t N, const ExecutorOptions& options) {
+
+      // classic mode: a single group of all workers
+      if(!options.numa_aware) {
+        _groups = std::vector<WorkerGroup>(1);
+        _groups[0]._workers.resize(N);
+        _groups[0]._cpus = allowed_cpus();
+        std::iota(_groups[0]._workers.begin(), _groups[0]._workers.end(), 0);
+        _groups[0]._active = std::make_unique<std::atomic<size_t>[]>(N);
+        _active_workers = std::make_unique<std::atomic<size_t>[]>(N);
+        return;
+      }
+
+      auto nodes = discover_numa_nodes(options.numa_sysfs_root);
+
+      // only the cpus of a node this process is allowed to run on count, and
+      // a node without any of them receives no workers
+      const auto allowed = allowed_cpus();
+
+      for(auto& node : nodes) {
+        std::vector<size_t> cpus;
+        std::set_intersection(
+          node.cpus.begin(), node.cpus.end(), allowed.begin(), allowed.end(),
+          std::back_inserter(cpus)
+        );
+        node.cpus = std::move(cpus);
+      }
+
+      nodes.erase(
+        std::remove_if(nodes.begin(), nodes.end(), [](auto& node){ return node.cpus.empty(); }),
+        nodes.end()
+      );
+
+      // the allowed cpus lie outside all discovered nodes
+      if(nodes.empty()) {
+        nodes.resize(1);
+        nodes[0].cpus = allowed;
+      }
+
+      // we cannot have more groups than workers
+      if(nodes.size() > N) {
+        nodes.resize(N);
+      }
+
+      // split the workers in proportion to the allowed cpu count of each
+      // node, where every node receives at least one worker
+      size_t num_cpus = 0;
+      for(auto& node : nodes) {
+        num_cpus += node.cpus.size();
+      }
+
+      std::vector<size_t> counts(nodes.size());
+      size_t total = 0;
+      for(size_t g=0; g<nodes.size(); ++g) {
+        counts[g] = std::max<size_t>(1, N * nodes[g].cpus.size() / num_cpus);
+        total += counts[g];
+      }
+
+      // the remaining workers go to the most under-served node (relative
+      // to its cpu count) and the extra ones come from the most over-served
+      while(total < N) {
+        size_t g = 0;
+        for(size_t k=1; k<nodes.size(); ++k) {
+          if(counts[k] * nodes[g].cpus.size() < counts[g] * nodes[k].cpus.size()) {
+            g = k;
+          }
+        }
+        ++counts[g];
+        ++total;
+      }
+
+      while(total > N) {
+        size_t g = nodes.size();
+        for(size_t k=0; k<nodes.size(); ++k) {
+          if(counts[k] > 1 && (g == nodes.size() ||
+             counts[k] * nodes[g].cpus.size() > counts[g] * nodes[k].cpus.size())) {
+            g = k;
+          }
+        }
+        --counts[g];
+        --total;
+      }
 
+      _groups = std::vector<WorkerGroup>(nodes.size());
+      _active_workers = std::make_unique<std::atomic<size_t>[]>(N);
+
+      // Worker ids go round the groups in the order _grow activates the
+      // slots, such that the first workers spread over all groups and the
+      // active workers keep the lowest ids.
       for(size_t id=0; id<N; ++id) {
+        size_t g = nodes.size();
+        for(size_t k=0; k<nodes.size(); ++k) {
+          if(_groups[k]._workers.size() < counts[k] && (g == nodes.size() ||
+             _groups[k]._workers.size() * counts[g] < _groups[g]._workers.size() * counts[k])) {
+            g = k;
+          }
+        }
+        _groups[g]._workers.push_back(id);
+        _workers[id]._group = g;
+        _workers[id]._numa_node = nodes[g].id;
+      }
 
-        _workers[id]._id = id;
-        _workers[id]._vtm = id;
-        _workers[id]._executor = this;
-        _workers[id]._waiter = &_notifier._waiters[id];
+      for(size_t g=0; g<nodes.size(); ++g) {
 
-        _threads[id] = std::thread([&, &w=_workers[id]] () {
+        _groups[g]._numa_node = nodes[g].id;
+        _groups[g]._cpus = nodes[g].cpus;
+        _groups[g]._active = std::make_unique<std::atomic<size_t>[]>(counts[g]);
 
-    #ifdef __cpp_lib_atomic_wait
-          // wait for the caller thread to initialize the ID mapping
-          _all_spawned.wait(false, std::memory_order_acquire);
-          w._thread = &_threads[w._id];
-    #else
-          // update the ID mapping of this thread
-          w._thread = &_threads[w._id];
-          {
-            std::scoped_lock lock(mutex);
-            _wids[std::this_thread::get_id()] = w._id;
-            if(n++; n == num_workers()) {
-              cond.notify_one();
-            }
+        for(auto c : nodes[g].cpus) {
+          if(c >= _cpu_groups.size()) {
+            _cpu_groups.resize(c + 1, _groups.size());
           }
-    #endif
+          _cpu_groups[c] = g;
+        }
+      }
+
+    }
+
+    // Procedure: _set_up_affinity
+    inline void Executor::_set_up_affinity(const ExecutorOptions& options) {
+
+      if(options.affinity == AffinityPolicy::NONE) {
+        return;
+      }
+
+      for(auto& group : _groups) {
+
+        auto cpus = order_cpus(
+          discover_cpus(group._cpus, options.cpu_sysfs_root),
+          options.affinity, options.affinity_cpus
+        );
+
+        if(cpus.empty()) {
+          DUBHE_THROW("no allowed cpu matches the worker affinity policy");
+        }
+
+        for(size_t k=0; k<group._workers.size(); ++k) {
+          _workers[group._workers[k]]._cpu = static_cast<int>(cpus[k % cpus.size()]);
+        }
+      }
+    }
+
+    // Procedure: _spawn
+    // spawns the thread of the given worker slot
+    inline void Executor::_spawn(size_t id) {
+
+      auto& w = _workers[id];
+
+      // an exited thread of a retired worker must be joined before its
+      // slot is reused
+      if(_threads[id].joinable()) {
+        _threads[id].join();
+      }
+
+      w._id = id;
+      w._vtm = id;
+      w._executor = this;
+      w._thread = &_threads[id];
+      w._waiter = &_notifier._waiters[id];
+      w._state.store(Worker::ACTIVE, std::memory_order_relaxed);
+
+      _threads[id] = std::thread([this, &w] () {
+
+        _per_thread_worker() = &w;
+
+        Node* t = nullptr;
+
+        while(1) {
+
+          // execute the tasks.
+          _exploit_task(w, t);
+
+          // wait for tasks
+          if(_wait_for_task(w, t) == false) {
+            break;
+          }
+        }
+
+        // an exited worker steals no more
+        w._epoch.store(SIZE_MAX, std::memory_order_release);
+
+        _per_thread_worker() = nullptr;
+      });
+
+      // pin the worker to its cpu chosen by the affinity policy, or
+      // otherwise keep it on the cpus of its NUMA node
+      if(auto cpu = w._cpu; cpu >= 0) {
+        if(!bind_thread_to_cpus(_threads[id], {static_cast<size_t>(cpu)})) {
+          w._cpu = -1;
+        }
+      }
+      else if(_groups.size() > 1 && !_groups[w._group]._cpus.empty()) {
+        bind_thread_to_cpus(_threads[id], _groups[w._group]._cpus);
+      }
+    }
 
-          Node* t = nullptr;
+    // Function: _grow
+    // activates up to n worker slots, one at a time in the group with the
+    // fewest active workers relative to its size; the caller holds
+    // _elastic_mutex
+    inline size_t Executor::_grow(size_t n) {
 
-          while(1) {
+      size_t num_added = 0;
 
-            // execute the tasks.
-            _exploit_task(w, t);
+      for(; num_added < n && _num_workers.load(std::memory_order_relaxed) < _workers.size();
+          ++num_added) {
 
-            // wait for tasks
-            if(_wait_for_task(w, t) == false) {
+        size_t g = _groups.size();
+        for(size_t k=0; k<_groups.size(); ++k) {
+          if(_groups[k]._num_active < _groups[k]._workers.size() && (g == _groups.size() ||
+             _groups[k]._num_active * _groups[g]._workers.size() <
+             _groups[g]._num_active * _groups[k]._workers.size())) {
+            g = k;
+          }
+        }
+
+        // revive a retiring worker that has not yet exited, or otherwise
+        // spawn a thread on the first inactive slot
+        size_t id = _workers.size();
+        for(auto k : _groups[g]._workers) {
+          int state = Worker::RETIRING;
+          if(_workers[k]._state.compare_exchange_strong(state, Worker::ACTIVE,
+                                                        std::memory_order_relaxed)) {
+            id = k;
+            break;
+          }
+        }
+
+        if(id == _workers.size()) {
+          for(auto k : _groups[g]._workers) {
+            if(_workers[k]._state.load(std::memory_order_relaxed) != Worker::ACTIVE) {
+              id = k;
               break;
             }
           }
+          _spawn(id);
+        }
+
+        _activate(id);
+      }
+
+      _set_up_steals();
+
+      return num_added;
+    }
+
+    // Function: _shrink
+    // retires up to n active workers, one at a time from the group with the
+    // most active workers relative to its size, keeping at least one worker;
+    // the caller holds _elastic_mutex
+    inline size_t Executor::_shrink(size_t n) {
+
+      size_t num_removed = 0;
+
+      for(; num_removed < n && _num_workers.load(std::memory_order_relaxed) > 1;
+          ++num_removed) {
+
+        size_t g = _groups.size();
+        for(size_t k=0; k<_groups.size(); ++k) {
+          if(_groups[k]._num_active > 0 && (g == _groups.size() ||
+             _groups[k]._num_active * _groups[g]._workers.size() >
+             _groups[g]._num_active * _groups[k]._workers.size())) {
+            g = k;
+          }
+        }
+
+        for(auto itr = _groups[g]._workers.rbegin(); itr != _groups[g]._workers.rend(); ++itr) {
+          int state = Worker::ACTIVE;
+          if(_workers[*itr]._state.compare_exchange_strong(state, Worker::RETIRING,
+                                                           std::memory_order_relaxed)) {
+            _deactivate(*itr);
+            break;
+          }
+        }
+      }
+
+      _set_up_steals();
+
+      // wake up the parked workers such that the retired ones can exit
+      if(num_removed) {
+        _notifier.notify(true);
+      }
+
+      return num_removed;
+    }
+
+    // Procedure: _activate
+    // appends a worker to the active workers of the executor and of its
+    // group; the caller holds _elastic_mutex
+    inline void Executor::_activate(size_t id) {
+      auto& g = _groups[_workers[id]._group];
+      auto n = g._num_active.load(std::memory_order_relaxed);
+      g._active[n].store(id, std::memory_order_relaxed);
+      g._num_active.store(n + 1, std::memory_order_release);
+      n = _num_workers.load(std::memory_order_relaxed);
+      _active_workers[n].store(id, std::memory_order_relaxed);
+      _num_workers.store(n + 1, std::memory_order_release);
+    }
+
+    // Procedure: _deactivate
+    // removes a worker from the active workers of the executor and of its
+    // group, where the last active worker takes its slot; a thief reading
+    // a slot meanwhile gets a valid, if outdated, worker id; the caller
+    // holds _elastic_mutex
+    inline void Executor::_deactivate(size_t id) {
+      auto remove = [id](std::atomic<size_t>* active, std::atomic<size_t>& num_active) {
+        auto n = num_active.load(std::memory_order_relaxed);
+        for(size_t i=0; i<n; ++i) {
+          if(active[i].load(std::memory_order_relaxed) == id) {
+            active[i].store(active[n-1].load(std::memory_order_relaxed), std::memory_order_relaxed);
+            break;
+          }
+        }
+        num_active.store(n - 1, std::memory_order_release);
+      };
+      auto& g = _groups[_workers[id]._group];
+      remove(g._active.get(), g._num_active);
+      remove(_active_workers.get(), _num_workers);
+    }
+
+    // Procedure: _set_up_steals
+    // bounds the failed steal attempts of a worker by the number of active
+    // workers, in the executor and in the largest group; the caller holds
+    // _elastic_mutex
+    inline void Executor::_set_up_steals() {
+
+      auto n = _num_workers.load(std::memory_order_relaxed);
+      auto max_steals = (n+1) << 1;
+      _MAX_STEALS.store(max_steals, std::memory_order_relaxed);
+
+      // a single group is identical to the classic mode
+      if(_groups.size() == 1) {
+        _MAX_LOCAL_STEALS.store(max_steals, std::memory_order_relaxed);
+        return;
+      }
+
+      size_t max_group_size = 0;
+      for(auto& g : _groups) {
+        max_group_size = std::max(max_group_size, g._num_active.load(std::memory_order_relaxed));
+      }
+
+      _MAX_LOCAL_STEALS.store(
+        _num_local_steals ? _num_local_steals : ((max_group_size+1) << 1),
+        std::memory_order_relaxed
+      );
+    }
+
+    // Function: _retire
+    // lets a retiring worker exit; a retiring worker owns no tasks because
+    // it only gets here after _exploit_task has emptied its queue
+    inline bool Executor::_retire(Worker& w) {
+      int state = Worker::RETIRING;
+      if(w._state.load(std::memory_order_relaxed) == state &&
+         w._state.compare_exchange_strong(state, Worker::RETIRED,
+                                          std::memory_order_relaxed)) {
+        assert(w._wsq.empty());
+        return true;
+      }
+      return false;
+    }
+
+    // Function: _num_queued_tasks
+    // estimates the number of tasks waiting in the queues of the executor
+    inline size_t Executor::_num_queued_tasks() const {
+      size_t n = 0;
+      for(auto& g : _groups) {
+        n += g._wsq.size() + g._num_deadline_tasks.load(std::memory_order_relaxed);
+      }
+      for(auto& w : _workers) {
+        n += w._wsq.size() + w._num_mailed.load(std::memory_order_relaxed);
+      }
+      n += _num_held_tasks.load(std::memory_order_relaxed);
+      return n;
+    }
+
+    // Procedure: _control
+    // samples the executor every interval and adds a worker when all
+    // workers are busy and tasks pile up, or retires a worker when some
+    // workers stayed parked for a number of consecutive intervals
+    inline void Executor::_control() {
+
+      const size_t min_workers = std::max<size_t>(1, _elastic_policy.min_workers);
+      size_t num_idle = 0;
+
+      std::unique_lock<std::mutex> lock(_elastic_mutex);
+
+      while(!_elastic_cv.wait_for(lock, _elastic_policy.interval, [this](){
+        return _done.load(std::memory_order_relaxed);
+      })) {
+
+        auto num_workers = _num_workers.load(std::memory_order_relaxed);
+
+        if(_num_parked.load(std::memory_order_relaxed) == 0) {
+          num_idle = 0;
+          if(num_workers < _workers.size() && _num_queued_tasks() > num_workers) {
+            _grow(1);
+          }
+        }
+        else if(++num_idle >= _elastic_policy.idle_intervals) {
+          num_idle = 0;
+          if(num_workers > min_workers) {
+            _shrink(1);
+          }
+        }
+      }
+    }
+
+    // Function: _steal_from_victim
+    // A victim id in [0, N) denotes a worker, where the worker itself stands
+    // for the injection queue of its own group, and a victim id in [N, N+G)
+    // denotes the injection queue of a (possibly remote) group.
+    // A worker victim loses up to half of its tasks to the thief at once,
+    // such that a wide fan-out does not make every thief go back to the
+    // same victim for each task.
+    inline Node* Executor::_steal_from_victim(Worker& w) {
+      if(auto t = _pop_deadline_task(w._group); t) {
+        return t;
+      }
+      // tasks with a deadline of a remote group go with its other tasks
+      if(w._vtm >= _workers.size()) {
+        if(auto t = _pop_deadline_task(w._vtm - _workers.size()); t) {
+          return t;
+        }
+      }
+      if(auto t = _take_from_mailbox(w); t) {
+        return t;
+      }
+      if(w._vtm == w._id) {
+        return _steal_from_group(w, w._group);
+      }
+      if(w._vtm < _workers.size()) {
+        return _workers[w._vtm]._wsq.steal_half(w._wsq);
+      }
+      return _steal_from_group(w, w._vtm - _workers.size());
+    }
+
+    // Function: _steal_from_group
+    inline Node* Executor::_steal_from_group(Worker& w, size_t g) {
+      auto& q = _groups[g]._wsq;
+      if(_priority_aging == 0) {
+        return q.steal();
+      }
+      return _take_aged(q, w._steal_ages, [&q](unsigned p){ return q.steal(p); });
+    }
+
+    // Function: _pop_task
+    inline Node* Executor::_pop_task(Worker& w) {
+      if(auto t = _pop_deadline_task(w._group); t) {
+        return t;
+      }
+      if(auto t = _take_from_mailbox(w); t) {
+        return t;
+      }
+      if(_priority_aging == 0) {
+        return w._wsq.pop();
+      }
+      return _take_aged(w._wsq, w._pop_ages, [&w](unsigned p){ return w._wsq.pop(p); });
+    }
+
+    // Procedure: _push_deadline_tasks
+    inline void Executor::_push_deadline_tasks(
+      size_t g, Node* const* nodes, size_t n, std::chrono::steady_clock::time_point d
+    ) {
+      auto& group = _groups[g];
+      {
+        std::scoped_lock lock(group._deadline_mutex);
+        for(size_t i=0; i<n; ++i) {
+          group._deadline_heap.emplace_back(d, group._deadline_seq++, nodes[i]);
+          std::push_heap(group._deadline_heap.begin(), group._deadline_heap.end(), std::greater<>{});
+        }
+      }
+      group._num_deadline_tasks.fetch_add(n, std::memory_order_release);
+    }
+
+    // Function: _pop_deadline_task
+    // pops the ready task of the earliest deadline of group g, where tasks
+    // of the same deadline leave in the order they arrived
+    inline Node* Executor::_pop_deadline_task(size_t g) {
+      auto& group = _groups[g];
+      if(group._num_deadline_tasks.load(std::memory_order_relaxed) == 0) {
+        return nullptr;
+      }
+      std::scoped_lock lock(group._deadline_mutex);
+      if(group._deadline_heap.empty()) {
+        return nullptr;
+      }
+      std::pop_heap(group._deadline_heap.begin(), group._deadline_heap.end(), std::greater<>{});
+      auto node = std::get<2>(group._deadline_heap.back());
+      group._deadline_heap.pop_back();
+      group._num_deadline_tasks.fetch_sub(1, std::memory_order_relaxed);
+      return node;
+    }
+
+    // Procedure: _check_deadline
+    inline void Executor::_check_deadline(Worker& worker, Node* node) {
+      auto d = node->_effective_deadline();
+      if(d == std::chrono::steady_clock::time_point::max() ||
+         std::chrono::steady_clock::now() <= d) {
+        return;
+      }
+      _num_deadline_misses.fetch_add(1, std::memory_order_relaxed);
+      for(auto& observer : _observers) {
+        observer->on_deadline_miss(WorkerView(worker), TaskView(*node), d);
+      }
+    }
+
+    // Function: _tenant_cap
+    // bounds the tasks of a tenant admitted to the task queues at a time by
+    // its share of a few tasks per worker, where the share is taken among
+    // the tenants that have tasks held back
+    inline size_t Executor::_tenant_cap(Tenant* tenant) const {
+      auto w = tenant->_weight.load(std::memory_order_relaxed);
+      auto h = std::max(_held_weight.load(std::memory_order_relaxed), w);
+      return std::max<size_t>(4 * _num_workers.load(std::memory_order_relaxed) * w / h, 1);
+    }
 
+    // Function: _admit_tenant_task
+    // admits a ready task of a tenant to the task queues unless the tenant
+    // has used up its share, in which case the task must be held back
+    inline bool Executor::_admit_tenant_task(Node* node, Tenant* tenant) {
+      // tasks nested in a running task, such as the tasks of a subflow, are
+      // always admitted since the running task waits for them
+      if(node->_parent) {
+        return true;
+      }
+      if(tenant->_num_admitted.fetch_add(1, std::memory_order_seq_cst) < _tenant_cap(tenant)) {
+        node->_state.fetch_or(Node::ADMITTED, std::memory_order_relaxed);
+        _num_admitted.fetch_add(1, std::memory_order_seq_cst);
+        return true;
+      }
+      tenant->_num_admitted.fetch_sub(1, std::memory_order_seq_cst);
+      return false;
+    }
+
+    // Procedure: _hold_tenant_tasks
+    // holds back ready tasks of a tenant beyond its share and lets in what
+    // the share allows now to the queue of group g, since the admitted
+    // tasks of the tenant may all have finished in the meantime
+    inline void Executor::_hold_tenant_tasks(size_t g, Node* const* nodes, size_t n, Tenant* tenant) {
+      {
+        std::scoped_lock lock(_tenant_mutex);
+        auto itr = std::find_if(_tenant_queues.begin(), _tenant_queues.end(), [tenant](auto& q){
+          return q.tenant == tenant;
         });
+        if(itr == _tenant_queues.end()) {
+          // a tenant becoming active starts no earlier than the virtual time
+          // being served, such that it cannot make up for its idle time by
+          // taking over the workers
+          auto v = tenant->_vtime.load(std::memory_order_relaxed);
+          while(v < _tenant_vtime && !tenant->_vtime.compare_exchange_weak(
+            v, _tenant_vtime, std::memory_order_relaxed, std::memory_order_relaxed
+          ));
+          auto w = tenant->_weight.load(std::memory_order_relaxed);
+          itr = _tenant_queues.insert(_tenant_queues.end(), TenantQueue{tenant, w, {}});
+          _held_weight.fetch_add(w, std::memory_order_relaxed);
+        }
+        itr->nodes.insert(itr->nodes.end(), nodes, nodes + n);
+        _num_held_tasks.fetch_add(n, std::memory_order_seq_cst);
+      }
+      while(auto t = _take_held_task(false)) {
+        _push_to_group(g, t, priority_bucket(t->_priority));
+        _notifier.notify(false);
+      }
+    }
 
-        // POSIX-like system can use the following to affine threads to cores
-        //cpu_set_t cpuset;
-        //CPU_ZERO(&cpuset);
-        //CPU_SET(id, &cpuset);
-        //pthread_setaffinity_np(
-        //  _threads[id].native_handle(), sizeof(cpu_set_t), &cpuset
-        //);
+    // Function: _take_held_task
+    // admits the oldest held task of the tenant of the least virtual time,
+    // i.e., the least worker time consumed per unit of weight, among the
+    // tenants below their share, or among all tenants if forced
+    inline Node* Executor::_take_held_task(bool force) {
+      if(_num_held_tasks.load(std::memory_order_seq_cst) == 0) {
+        return nullptr;
+      }
+      std::scoped_lock lock(_tenant_mutex);
+      auto min = _tenant_queues.end();
+      uint64_t min_v = 0;
+      for(auto itr = _tenant_queues.begin(); itr != _tenant_queues.end(); ++itr) {
+        if(!force && itr->tenant->_num_admitted.load(std::memory_order_seq_cst) >=
+                     _tenant_cap(itr->tenant)) {
+          continue;
+        }
+        if(auto v = itr->tenant->_vtime.load(std::memory_order_relaxed);
+           min == _tenant_queues.end() || v < min_v) {
+          min = itr;
+          min_v = v;
+        }
+      }
+      if(min == _tenant_queues.end()) {
+        return nullptr;
+      }
+      _tenant_vtime = std::max(_tenant_vtime, min_v);
+      auto node = min->nodes.front();
+      min->nodes.pop_front();
+      node->_state.fetch_or(Node::ADMITTED, std::memory_order_relaxed);
+      min->tenant->_num_admitted.fetch_add(1, std::memory_order_seq_cst);
+      _num_admitted.fetch_add(1, std::memory_order_seq_cst);
+      // a tenant without held tasks leaves the queues such that a tenant is
+      // only referenced while it has tasks held back
+      if(min->nodes.empty()) {
+        _held_weight.fetch_sub(min->weight, std::memory_order_relaxed);
+        if(min != std::prev(_tenant_queues.end())) {
+          *min = std::move(_tenant_queues.back());
+        }
+        _tenant_queues.pop_back();
+      }
+      _num_held_tasks.fetch_sub(1, std::memory_order_seq_cst);
+      return node;
+    }
 
-    #ifdef __cpp_lib_atomic_wait
-        //_wids[_threads[id].get_id()] = id;
-        _wids.emplace(std::piecewise_construct,
-          std::forward_as_tuple(_threads[id].get_id()), std::forward_as_tuple(id)
-        );
-    #endif
+    // Procedure: _finish_tenant_task
+    // gives back the share taken by an admitted task and lets in the held
+    // tasks the shares allow now to the group of the worker, waking a
+    // parked worker for each
+    inline void Executor::_finish_tenant_task(Worker& worker, Node* node, Tenant* tenant) {
+      if(!(node->_state.load(std::memory_order_relaxed) & Node::ADMITTED)) {
+        return;
       }
+      node->_state.fetch_and(~Node::ADMITTED, std::memory_order_relaxed);
+      tenant->_num_admitted.fetch_sub(1, std::memory_order_seq_cst);
+      _num_admitted.fetch_sub(1, std::memory_order_seq_cst);
+      while(auto t = _take_held_task(false)) {
+        _push_to_group(worker._group, t, priority_bucket(t->_priority));
+        _notifier.notify(false);
+      }
+    }
 
-    #ifdef __cpp_lib_atomic_wait
-      _all_spawned.test_and_set(std::memory_order_release);
-      _all_spawned.notify_all();
-    #else
-      std::unique_lock<std::mutex> lock(mutex);
-      cond.wait(lock, [&](){ return n==N; });
-    #endif
+    // Function: _tenants_admitted_elsewhere
+    // tells whether the tenants with held tasks have more tasks admitted
+    // than this executor has admitted of any tenant, in which case some are
+    // admitted by another executor that shares the tenant and does not tell
+    // this one when they finish
+    inline bool Executor::_tenants_admitted_elsewhere() {
+      if(_num_held_tasks.load(std::memory_order_seq_cst) == 0) {
+        return false;
+      }
+      std::scoped_lock lock(_tenant_mutex);
+      size_t n = 0;
+      for(auto& q : _tenant_queues) {
+        n += q.tenant->_num_admitted.load(std::memory_order_seq_cst);
+      }
+      return n > _num_admitted.load(std::memory_order_seq_cst);
+    }
+
+    // Function: _take_aged
+    // Takes a task from the highest non-empty priority bucket of the queue
+    // unless a lower bucket has reached the aging limit, in which case the
+    // lowest such bucket is served first. Taking a task ages every non-empty
+    // bucket below it and resets the age of its own bucket.
+    template <typename Q, typename F>
+    Node* Executor::_take_aged(Q& queue, size_t* ages, F&& take) {
+
+      for(unsigned p=DUBHE_NUM_PRIORITY_BUCKETS-1; p>0; --p) {
+        if(ages[p] >= _priority_aging) {
+          if(auto t = take(p); t) {
+            ages[p] = 0;
+            return t;
+          }
+          if(queue.empty(p)) {
+            ages[p] = 0;
+          }
+        }
+      }
+
+      for(unsigned p=0; p<DUBHE_NUM_PRIORITY_BUCKETS; ++p) {
+        if(auto t = take(p); t) {
+          ages[p] = 0;
+          for(unsigned q=p+1; q<DUBHE_NUM_PRIORITY_BUCKETS; ++q) {
+            if(!queue.empty(q)) {
+              ++ages[q];
+            }
+          }
+          return t;
+        }
+      }
+
+      return nullptr;
+    }
+
+    // Procedure: _select_victim
+    // Picks the next victim uniformly at random from the active workers of
+    // the local group first, where the worker itself stands for the
+    // injection queue of the group. After _MAX_LOCAL_STEALS failed attempts,
+    // the victim is drawn from all active workers and group injection queues.
+    inline void Executor::_select_victim(Worker& w, size_t num_steals) {
+      if(_groups.size() == 1 || num_steals < _MAX_LOCAL_STEALS.load(std::memory_order_relaxed)) {
+        auto& local = _groups[w._group];
+        auto n = local._num_active.load(std::memory_order_acquire);
+        if(n == 0) {
+          w._vtm = w._id;
+          return;
+        }
+        std::uniform_int_distribution<size_t> rdvtm(0, n-1);
+        w._vtm = local._active[rdvtm(w._rdgen)].load(std::memory_order_relaxed);
+      }
+      else {
+        auto n = _num_workers.load(std::memory_order_acquire);
+        std::uniform_int_distribution<size_t> rdvtm(0, n + _groups.size() - 1);
+        auto r = rdvtm(w._rdgen);
+        w._vtm = r < n ? _active_workers[r].load(std::memory_order_relaxed) :
+                         _workers.size() + (r - n);
+      }
     }
 
     // Function: _corun_until
     template <typename P>
     void Executor::_corun_until(Worker& w, P&& stop_predicate) {
 
-      std::uniform_int_distribution<size_t> rdvtm(0, _workers.size()-1);
-
       exploit:
 
       while(!stop_predicate()) {
 
         //exploit:
 
-        if(auto t = w._wsq.pop(); t) {
+        if(auto t = _pop_task(w); t) {
           _invoke(w, t);
         }
         else {
@@ -1278,17 +2820,27 @@ namespace dubhe {
 
           explore:
 
-          t = (w._id == w._vtm) ? _wsq.steal() : _workers[w._vtm]._wsq.steal();
+          t = _steal_from_victim(w);
 
           if(t) {
             _invoke(w, t);
             goto exploit;
           }
           else if(!stop_predicate()) {
-            if(num_steals++ > _MAX_STEALS) {
+            if(num_steals++ > _MAX_STEALS.load(std::memory_order_relaxed)) {
+              if(t = _steal_from_mailbox(w); t) {
+                _invoke(w, t);
+                goto exploit;
+              }
+              // the tasks waited for may be held back for their tenant,
+              // which is let in over its share rather than blocking the worker
+              if(t = _take_held_task(true); t) {
+                _invoke(w, t);
+                goto exploit;
+              }
               std::this_thread::yield();
             }
-            w._vtm = rdvtm(w._rdgen);
+            _select_victim(w, num_steals);
             goto explore;
           }
           else {
@@ -1306,26 +2858,63 @@ namespace dubhe {
 
       size_t num_steals = 0;
       size_t num_yields = 0;
+      size_t num_pauses = 1;
+
+      const size_t max_steals = _wait_policy.num_steals ?
+        _wait_policy.num_steals : _MAX_STEALS.load(std::memory_order_relaxed);
 
-      std::uniform_int_distribution<size_t> rdvtm(0, _workers.size()-1);
+      std::chrono::steady_clock::time_point deadline;
 
       // Here, we write do-while to make the worker steal at once
       // from the assigned victim.
       do {
-        t = (w._id == w._vtm) ? _wsq.steal() : _workers[w._vtm]._wsq.steal();
+        t = _steal_from_victim(w);
 
         if(t) {
           break;
         }
 
-        if(num_steals++ > _MAX_STEALS) {
-          std::this_thread::yield();
-          if(num_yields++ > 100) {
+        if(_wait_policy.mode == WaitMode::PARK) {
+          break;
+        }
+
+        if(num_steals++ > max_steals) {
+          // tasks hinted to another worker are taken only as a last resort
+          if(t = _steal_from_mailbox(w); t) {
+            break;
+          }
+          switch(_wait_policy.mode) {
+
+            case WaitMode::SPIN:
+            case WaitMode::BACKOFF:
+              // the budget starts when the round of steal attempts fails
+              if(num_steals == max_steals + 2) {
+                deadline = std::chrono::steady_clock::now() + _wait_policy.spin_budget;
+              }
+              else if(std::chrono::steady_clock::now() >= deadline) {
+                return;
+              }
+              if(_wait_policy.mode == WaitMode::SPIN) {
+                relax_cpu();
+              }
+              else {
+                for(size_t i=0; i<num_pauses; i++) {
+                  relax_cpu();
+                }
+                num_pauses = std::min(num_pauses << 1, _wait_policy.max_backoff);
+              }
+            break;
+
+            default:
+              std::this_thread::yield();
+              if(num_yields++ > _wait_policy.num_yields) {
+                return;
+              }
             break;
           }
         }
 
-        w._vtm = rdvtm(w._rdgen);
+        _select_victim(w, num_steals);
       } while(!_done);
 
     }
@@ -1334,7 +2923,18 @@ namespace dubhe {
     inline void Executor::_exploit_task(Worker& w, Node*& t) {
       while(t) {
         _invoke(w, t);
-        t = w._wsq.pop();
+        // a busy worker fires the due timers as well, ahead of its own queue,
+        // reading the clock once every DUBHE_TIMER_POLL_INTERVAL tasks
+        if(_num_timers.load(std::memory_order_relaxed) != 0 &&
+           w._timer_countdown-- == 0) {
+          w._timer_countdown = DUBHE_TIMER_POLL_INTERVAL - 1;
+          if(_timer_due()) {
+            if(auto f = _fire_timers(w); f) {
+              _schedule(w, f);
+            }
+          }
+        }
+        t = _pop_task(w);
       }
     }
 
@@ -1343,8 +2943,22 @@ namespace dubhe {
 
       explore_task:
 
+      // announce the epoch before any steal of this round, which thereby
+      // reads only the arrays that are current at this epoch
+      worker._epoch.store(
+        _steal_epoch.load(std::memory_order_acquire), std::memory_order_release
+      );
+
+      if(_retire(worker)) {
+        return false;
+      }
+
       _explore_task(worker, t);
 
+      if(!t && _timer_due()) {
+        t = _fire_timers(worker);
+      }
+
       // The last thief who successfully stole a task will wake up
       // another thief worker to avoid starvation.
       if(t) {
@@ -1352,10 +2966,31 @@ namespace dubhe {
         return true;
       }
 
+      // the queue is empty now and can give back its memory
+      if(_shrink_on_idle) {
+        worker._wsq.shrink();
+      }
+
+      _reclaim_arrays(worker);
+
       // ---- 2PC guard ----
       _notifier.prepare_wait(worker._waiter);
 
-      if(!_wsq.empty()) {
+      for(size_t g=0; g<_groups.size(); g++) {
+        if(_groups[g]._num_deadline_tasks.load(std::memory_order_relaxed) != 0) {
+          _notifier.cancel_wait(worker._waiter);
+          worker._vtm = g == worker._group ? worker._id : _workers.size() + g;
+          goto explore_task;
+        }
+      }
+
+      if((t = _take_held_task(false)) != nullptr) {
+        _notifier.cancel_wait(worker._waiter);
+        _notifier.notify(false);
+        return true;
+      }
+
+      if(!_groups[worker._group]._wsq.empty()) {
         _notifier.cancel_wait(worker._waiter);
         worker._vtm = worker._id;
         goto explore_task;
@@ -1367,6 +3002,20 @@ namespace dubhe {
         return false;
       }
 
+      if(_retire(worker)) {
+        _notifier.cancel_wait(worker._waiter);
+        return false;
+      }
+
+      // injection queues of remote groups
+      for(size_t g=0; g<_groups.size(); g++) {
+        if(g != worker._group && !_groups[g]._wsq.empty()) {
+          _notifier.cancel_wait(worker._waiter);
+          worker._vtm = _workers.size() + g;
+          goto explore_task;
+        }
+      }
+
       // We need to use index-based scanning to avoid data race
       // with _spawn which may initialize a worker at the same time.
       for(size_t vtm=0; vtm<_workers.size(); vtm++) {
@@ -1377,12 +3026,92 @@ namespace dubhe {
         }
       }
 
+      // Mailboxes come last. A parked worker takes a task hinted to another
+      // worker right away since it does not explore long enough to steal
+      // from mailboxes otherwise.
+      for(size_t vtm=0; vtm<_workers.size(); vtm++) {
+        if(_workers[vtm]._num_mailed.load(std::memory_order_relaxed) != 0) {
+          _notifier.cancel_wait(worker._waiter);
+          if(vtm != worker._id && (t = _take_from_mailbox(_workers[vtm])) != nullptr) {
+            _notifier.notify(false);
+            return true;
+          }
+          goto explore_task;
+        }
+      }
+
+      // a sleeping worker does not hold up the arrays retired by others
+      worker._epoch.store(SIZE_MAX, std::memory_order_release);
+
+      // With timers armed, one idle worker keeps them: it sleeps until the
+      // next timer is due, a notification arrives, or an earlier timer is
+      // armed, and then explores again to fire what is due.
+      if(_num_timers.load(std::memory_order_relaxed) != 0 &&
+         !_timer_keeper.exchange(true, std::memory_order_acquire)) {
+        _notifier.cancel_wait(worker._waiter);
+        auto next = _next_timer.load(std::memory_order_relaxed);
+        _notifier.sleep_until(
+          std::chrono::steady_clock::time_point(std::chrono::steady_clock::duration(next)),
+          [&](){
+            return _done.load(std::memory_order_relaxed) ||
+                   _next_timer.load(std::memory_order_relaxed) < next ||
+                   _num_queued_tasks() != 0;
+          }
+        );
+        _timer_keeper.store(false, std::memory_order_release);
+        goto explore_task;
+      }
+
+      // Held tasks of a tenant are let in as admitted tasks of the tenant
+      // finish, which wakes a parked worker. Another executor sharing the
+      // tenant does not tell this one when its tasks finish, so while held
+      // tasks wait for those, one idle worker keeps them and looks again
+      // every millisecond.
+      if(_tenants_admitted_elsewhere() &&
+         !_tenant_keeper.exchange(true, std::memory_order_acquire)) {
+        _notifier.cancel_wait(worker._waiter);
+        _notifier.sleep_until(
+          std::chrono::steady_clock::now() + std::chrono::milliseconds(1),
+          [&](){ return _done.load(std::memory_order_relaxed); }
+        );
+        _tenant_keeper.store(false, std::memory_order_release);
+        goto explore_task;
+      }
+
       // Now I really need to relinguish my self to others
+      _num_parked.fetch_add(1, std::memory_order_relaxed);
       _notifier.commit_wait(worker._waiter);
+      _num_parked.fetch_sub(1, std::memory_order_relaxed);
 
       goto explore_task;
     }
 
+    // Procedure: _reclaim_arrays
+    // Thieves read the arrays of a queue without announcing each steal. The
+    // owner instead waits for a grace period: it advances the steal epoch
+    // after retiring arrays, and every worker that announces the new epoch
+    // afterwards reads only the current arrays, while a sleeping or exited
+    // worker reads none.
+    inline void Executor::_reclaim_arrays(Worker& w) {
+
+      if(w._num_grace == 0) {
+        if((w._num_grace = w._wsq.num_retired()) == 0) {
+          return;
+        }
+        w._grace_epoch = _steal_epoch.fetch_add(1, std::memory_order_acq_rel) + 1;
+      }
+
+      for(size_t i=0; i<_workers.size(); i++) {
+        if(i != w._id &&
+           _workers[i]._epoch.load(std::memory_order_acquire) < w._grace_epoch) {
+          return;
+        }
+      }
+
+      w._wsq.reclaim(w._num_grace);
+      w._num_grace = 0;
+    }
+
     // Function: make_observer
     template<typename Observer, typename... ArgsT>
     std::shared_ptr<Observer> Executor::make_observer(ArgsT&&... args) {
@@ -1411,12 +3140,88 @@ namespace dubhe {
         "Observer must be derived from ObserverInterface"
       );
 
-      _observers.erase(std::static_pointer_cast<ObserverInterface>(ptr));
+      _observers.erase(std::static_pointer_cast<ObserverInterface>(ptr));
+    }
+
+    // Function: num_observers
+    inline size_t Executor::num_observers() const noexcept {
+      return _observers.size();
+    }
+
+    // Function: _injection_group
+    // External submissions go to the group of the cpu the caller runs on,
+    // or round-robin over the groups if that cpu is unknown.
+    inline size_t Executor::_injection_group() {
+
+      if(_groups.size() == 1) {
+        return 0;
+      }
+
+      if(auto cpu = current_cpu(); cpu >= 0 && static_cast<size_t>(cpu) < _cpu_groups.size()) {
+        if(auto g = _cpu_groups[cpu]; g < _groups.size()) {
+          return g;
+        }
+      }
+
+      return _next_group.fetch_add(1, std::memory_order_relaxed) % _groups.size();
+    }
+
+    // Procedure: _push_to_group
+    inline void Executor::_push_to_group(size_t g, Node* node, unsigned p) {
+      _groups[g]._wsq.push(node, p);
+    }
+
+    // Function: _mailbox_of
+    // returns the worker a ready task is hinted to, or nullptr if the task
+    // has no hint or the hinted worker is not running
+    inline Worker* Executor::_mailbox_of(Node* node) {
+      auto id = node->_affinity;
+      if(id == Node::NO_AFFINITY && _replay_affinity) {
+        id = node->_last_worker;
+      }
+      if(id >= _workers.size() ||
+         _workers[id]._state.load(std::memory_order_relaxed) != Worker::ACTIVE) {
+        return nullptr;
+      }
+      return &_workers[id];
+    }
+
+    // Function: _runs_here
+    // queries if a ready task may run on the given worker right away, i.e.,
+    // without going through the earliest-deadline-first heap or the mailbox
+    // of another worker
+    inline bool Executor::_runs_here(Worker& w, Node* node) {
+      if(node->_effective_deadline() != std::chrono::steady_clock::time_point::max()) {
+        return false;
+      }
+      auto m = _mailbox_of(node);
+      return m == nullptr || m == &w;
+    }
+
+    // Function: _steal_from_mailbox
+    inline Node* Executor::_steal_from_mailbox(Worker& w) {
+      if(w._vtm < _workers.size() && w._vtm != w._id) {
+        return _take_from_mailbox(_workers[w._vtm]);
+      }
+      return nullptr;
     }
 
-    // Function: num_observers
-    inline size_t Executor::num_observers() const noexcept {
-      return _observers.size();
+    // Procedure: _push_to_mailbox
+    inline void Executor::_push_to_mailbox(Worker& m, Node* node, unsigned p) {
+      m._num_mailed.fetch_add(1, std::memory_order_relaxed);
+      m._mailbox.push(node, p);
+    }
+
+    // Function: _take_from_mailbox
+    inline Node* Executor::_take_from_mailbox(Worker& m) {
+      if(m._num_mailed.load(std::memory_order_relaxed) == 0) {
+        return nullptr;
+      }
+      auto t = m._mailbox.steal();
+      if(t) {
+        m._num_mailed.fetch_sub(1, std::memory_order_relaxed);
+      }
+      return t;
     }
 
     // Procedure: _schedule
@@ -1425,10 +3230,33 @@ namespace dubhe {
       // We need to fetch p before the release such that the read
       // operation is synchronized properly with other thread to
       // void data race.
-      auto p = node->_priority;
+      auto p = priority_bucket(node->_priority);
+      auto d = node->_effective_deadline();
+      auto t = node->_effective_tenant();
 
       node->_state.fetch_or(Node::READY, std::memory_order_release);
 
+      if(d != std::chrono::steady_clock::time_point::max()) {
+        _push_deadline_tasks(
+          worker._executor == this ? worker._group : _injection_group(), &node, 1, d
+        );
+        _notifier.notify(false);
+        return;
+      }
+
+      if(t && !_admit_tenant_task(node, t)) {
+        _hold_tenant_tasks(
+          worker._executor == this ? worker._group : _injection_group(), &node, 1, t
+        );
+        return;
+      }
+
+      if(auto m = _mailbox_of(node); m && m != &worker) {
+        _push_to_mailbox(*m, node, p);
+        _notifier.notify(false);
+        return;
+      }
+
       // caller is a worker to this pool - starting at v3.5 we do not use
       // any complicated notification mechanism as the experimental result
       // has shown no significant advantage.
@@ -1438,10 +3266,7 @@ namespace dubhe {
         return;
       }
 
-      {
-        std::lock_guard<std::mutex> lock(_wsq_mutex);
-        _wsq.push(node, p);
-      }
+      _push_to_group(_injection_group(), node, p);
 
       _notifier.notify(false);
     }
@@ -1452,13 +3277,23 @@ namespace dubhe {
       // We need to fetch p before the release such that the read
       // operation is synchronized properly with other thread to
       // void data race.
-      auto p = node->_priority;
+      auto p = priority_bucket(node->_priority);
+      auto d = node->_effective_deadline();
+      auto t = node->_effective_tenant();
 
       node->_state.fetch_or(Node::READY, std::memory_order_release);
 
-      {
-        std::lock_guard<std::mutex> lock(_wsq_mutex);
-        _wsq.push(node, p);
+      if(d != std::chrono::steady_clock::time_point::max()) {
+        _push_deadline_tasks(_injection_group(), &node, 1, d);
+      }
+      else if(t && !_admit_tenant_task(node, t)) {
+        _hold_tenant_tasks(_injection_group(), &node, 1, t);
+      }
+      else if(auto m = _mailbox_of(node); m) {
+        _push_to_mailbox(*m, node, p);
+      }
+      else {
+        _push_to_group(_injection_group(), node, p);
       }
 
       _notifier.notify(false);
@@ -1483,20 +3318,43 @@ namespace dubhe {
           // We need to fetch p before the release such that the read
           // operation is synchronized properly with other thread to
           // void data race.
-          auto p = nodes[i]->_priority;
+          auto p = priority_bucket(nodes[i]->_priority);
+          auto d = nodes[i]->_effective_deadline();
+          auto t = nodes[i]->_effective_tenant();
           nodes[i]->_state.fetch_or(Node::READY, std::memory_order_release);
-          worker._wsq.push(nodes[i], p);
+          if(d != std::chrono::steady_clock::time_point::max()) {
+            _push_deadline_tasks(worker._group, &nodes[i], 1, d);
+          }
+          else if(t && !_admit_tenant_task(nodes[i], t)) {
+            _hold_tenant_tasks(worker._group, &nodes[i], 1, t);
+          }
+          else if(auto m = _mailbox_of(nodes[i]); m && m != &worker) {
+            _push_to_mailbox(*m, nodes[i], p);
+          }
+          else {
+            worker._wsq.push(nodes[i], p);
+          }
           _notifier.notify(false);
         }
         return;
       }
 
-      {
-        std::lock_guard<std::mutex> lock(_wsq_mutex);
-        for(size_t k=0; k<num_nodes; ++k) {
-          auto p = nodes[k]->_priority;
-          nodes[k]->_state.fetch_or(Node::READY, std::memory_order_release);
-          _wsq.push(nodes[k], p);
+      for(size_t k=0, g=_injection_group(); k<num_nodes; ++k) {
+        auto p = priority_bucket(nodes[k]->_priority);
+        auto d = nodes[k]->_effective_deadline();
+        auto t = nodes[k]->_effective_tenant();
+        nodes[k]->_state.fetch_or(Node::READY, std::memory_order_release);
+        if(d != std::chrono::steady_clock::time_point::max()) {
+          _push_deadline_tasks(g, &nodes[k], 1, d);
+        }
+        else if(t && !_admit_tenant_task(nodes[k], t)) {
+          _hold_tenant_tasks(g, &nodes[k], 1, t);
+        }
+        else if(auto m = _mailbox_of(nodes[k]); m) {
+          _push_to_mailbox(*m, nodes[k], p);
+        }
+        else {
+          _push_to_group(g, nodes[k], p);
         }
       }
 
@@ -1516,12 +3374,22 @@ namespace dubhe {
       // We need to fetch p before the release such that the read
       // operation is synchronized properly with other thread to
       // void data race.
-      {
-        std::lock_guard<std::mutex> lock(_wsq_mutex);
-        for(size_t k=0; k<num_nodes; ++k) {
-          auto p = nodes[k]->_priority;
-          nodes[k]->_state.fetch_or(Node::READY, std::memory_order_release);
-          _wsq.push(nodes[k], p);
+      for(size_t k=0, g=_injection_group(); k<num_nodes; ++k) {
+        auto p = priority_bucket(nodes[k]->_priority);
+        auto d = nodes[k]->_effective_deadline();
+        auto t = nodes[k]->_effective_tenant();
+        nodes[k]->_state.fetch_or(Node::READY, std::memory_order_release);
+        if(d != std::chrono::steady_clock::time_point::max()) {
+          _push_deadline_tasks(g, &nodes[k], 1, d);
+        }
+        else if(t && !_admit_tenant_task(nodes[k], t)) {
+          _hold_tenant_tasks(g, &nodes[k], 1, t);
+        }
+        else if(auto m = _mailbox_of(nodes[k]); m) {
+          _push_to_mailbox(*m, nodes[k], p);
+        }
+        else {
+          _push_to_group(g, nodes[k], p);
         }
       }
 
@@ -1538,30 +3406,61 @@ namespace dubhe {
 
       SmallVector<int> conds;
 
+      if(_replay_affinity) {
+        node->_last_worker = static_cast<unsigned>(worker._id);
+      }
+
+      auto tenant = node->_effective_tenant();
+
       // no need to do other things if the topology is cancelled
       if(node->_is_cancelled()) {
+        if(tenant) {
+          _finish_tenant_task(worker, node, tenant);
+        }
         _tear_down_invoke(worker, node);
         return;
       }
 
       // if acquiring semaphore(s) exists, acquire them first
-      if(node->_semaphores && !node->_semaphores->to_acquire.empty()) {
+      if(auto s = node->_semaphores(); s && !s->to_acquire.empty()) {
         SmallVector<Node*> nodes;
         if(!node->_acquire_all(nodes)) {
+          if(tenant) {
+            _finish_tenant_task(worker, node, tenant);
+          }
           _schedule(worker, nodes);
           return;
         }
         node->_state.fetch_or(Node::ACQUIRED, std::memory_order_release);
       }
 
+      // The worker time of a tenant task is charged to its tenant. Tasks
+      // nested in a tenant task on the same worker, such as its subflow,
+      // are timed as well and their time is taken off the enclosing task.
+      auto timed = tenant != nullptr || worker._num_timed != 0;
+      std::chrono::steady_clock::time_point beg;
+      int64_t nested = 0;
+      if(timed) {
+        beg = std::chrono::steady_clock::now();
+        nested = worker._nested_time;
+        ++worker._num_timed;
+      }
+
       // condition task
       //int cond = -1;
 
+      // the last task run in the fused chain of a static task, whose
+      // successors are released in place of those of the node
+      auto tail = node;
+
       // switch is faster than nested if-else due to jump table
       switch(node->_handle.index()) {
         // static task
         case Node::STATIC:{
           _invoke_static_task(worker, node);
+          if(node->_meta && !node->_meta->fused.empty()) {
+            tail = _invoke_fused_tasks(worker, node);
+          }
         }
         break;
 
@@ -1592,6 +3491,10 @@ namespace dubhe {
         // async task
         case Node::ASYNC: {
           _invoke_async_task(worker, node);
+          _check_deadline(worker, node);
+          if(timed) {
+            _charge_tenant(worker, node, tenant, beg, nested);
+          }
           _tear_down_async(node);
           return ;
         }
@@ -1600,9 +3503,16 @@ namespace dubhe {
         // dependent async task
         case Node::DEPENDENT_ASYNC: {
           _invoke_dependent_async_task(worker, node);
+          _check_deadline(worker, node);
+          if(timed) {
+            _charge_tenant(worker, node, tenant, beg, nested);
+          }
           _tear_down_dependent_async(worker, node);
           if(worker._cache) {
             node = worker._cache;
+            if(_yield_cached(worker, node)) {
+              return;
+            }
             goto begin_invoke;
           }
           return;
@@ -1614,10 +3524,16 @@ namespace dubhe {
         break;
       }
 
+      _check_deadline(worker, node);
+
+      if(timed) {
+        _charge_tenant(worker, node, tenant, beg, nested);
+      }
+
       //invoke_successors:
 
       // if releasing semaphores exist, release them
-      if(node->_semaphores && !node->_semaphores->to_release.empty()) {
+      if(auto s = node->_semaphores(); s && !s->to_release.empty()) {
         _schedule(worker, node->_release_all());
       }
 
@@ -1654,7 +3570,7 @@ namespace dubhe {
               // zeroing the join counter for invariant
               s->_join_counter.store(0, std::memory_order_relaxed);
               j.fetch_add(1, std::memory_order_relaxed);
-              if(s->_priority <= max_p) {
+              if(s->_priority <= max_p && _runs_here(worker, s)) {
                 if(worker._cache) {
                   _schedule(worker, worker._cache);
                 }
@@ -1669,14 +3585,16 @@ namespace dubhe {
         }
         break;
 
-        // non-condition task
+        // non-condition task, where a fused chain continues with the
+        // successors of its last task
         default: {
-          for(size_t i=0; i<node->_successors.size(); ++i) {
+          auto& successors = tail->_successors;
+          for(size_t i=0; i<successors.size(); ++i) {
             //if(auto s = node->_successors[i]; --(s->_join_counter) == 0) {
-            if(auto s = node->_successors[i];
+            if(auto s = successors[i];
               s->_join_counter.fetch_sub(1, std::memory_order_acq_rel) == 1) {
               j.fetch_add(1, std::memory_order_relaxed);
-              if(s->_priority <= max_p) {
+              if(s->_priority <= max_p && _runs_here(worker, s)) {
                 if(worker._cache) {
                   _schedule(worker, worker._cache);
                 }
@@ -1699,11 +3617,68 @@ namespace dubhe {
       // the number of expensive pop/push operations through the task queue
       if(worker._cache) {
         node = worker._cache;
+        if(_yield_cached(worker, node)) {
+          return;
+        }
         //node->_state.fetch_or(Node::READY, std::memory_order_release);
         goto begin_invoke;
       }
     }
 
+    // Procedure: _charge_tenant
+    // charges a tenant task for its time less the time of the tasks nested
+    // in it, and accounts its whole time as nested in the enclosing task
+    inline void Executor::_charge_tenant(
+      Worker& worker, Node* node, Tenant* tenant,
+      std::chrono::steady_clock::time_point beg, int64_t nested
+    ) {
+      auto elapsed = (std::chrono::steady_clock::now() - beg).count();
+      if(tenant) {
+        tenant->_charge(std::chrono::nanoseconds(elapsed - (worker._nested_time - nested)));
+        _finish_tenant_task(worker, node, tenant);
+      }
+      worker._nested_time = nested + elapsed;
+      --worker._num_timed;
+    }
+
+    // Function: _yield_cached
+    // A cached successor goes through the task queues rather than running
+    // right away when tasks with a deadline wait in the group of the worker,
+    // since those come first, or when its tenant has to take turns.
+    inline bool Executor::_yield_cached(Worker& worker, Node* node) {
+      if(_groups[worker._group]._num_deadline_tasks.load(std::memory_order_relaxed) != 0) {
+        worker._cache = nullptr;
+        _schedule(worker, node);
+        return true;
+      }
+      return _yield_to_tenants(worker, node);
+    }
+
+    // Function: _yield_to_tenants
+    // A cached successor of a tenant task is admitted like any ready task of
+    // its tenant, and it goes to the back of the queue of the group rather
+    // than running right away when tasks wait there, such that a long chain
+    // of one tenant cannot keep the worker to itself.
+    inline bool Executor::_yield_to_tenants(Worker& worker, Node* node) {
+      auto t = node->_effective_tenant();
+      if(t == nullptr) {
+        return false;
+      }
+      node->_state.fetch_or(Node::READY, std::memory_order_release);
+      if(!_admit_tenant_task(node, t)) {
+        worker._cache = nullptr;
+        _hold_tenant_tasks(worker._group, &node, 1, t);
+        return true;
+      }
+      if(_groups[worker._group]._wsq.empty()) {
+        return false;
+      }
+      worker._cache = nullptr;
+      _push_to_group(worker._group, node, priority_bucket(node->_priority));
+      _notifier.notify(false);
+      return true;
+    }
+
     // Procedure: _tear_down_invoke
     inline void Executor::_tear_down_invoke(Worker& worker, Node* node) {
       // we must check parent first before subtracting the join counter,
@@ -1753,7 +3728,7 @@ namespace dubhe {
       // if the node has a parent, we store the exception in its parent
       if(auto parent = node->_parent; parent) {
         if ((parent->_state.fetch_or(Node::EXCEPTION, std::memory_order_relaxed) & Node::EXCEPTION) == 0) {
-          parent->_exception_ptr = std::current_exception();
+          parent->_meta_data().exception_ptr = std::current_exception();
         }
         // TODO if the node has a topology, cancel it to enable early stop
         //if(auto tpg = node->_topology; tpg) {
@@ -1789,14 +3764,43 @@ namespace dubhe {
       _observer_epilogue(worker, node);
     }
 
+    // Function: _invoke_fused_tasks
+    // runs the tasks fused after the head of a chain in order, each seen by
+    // the observers under its own name, and returns the last task of the
+    // chain. The chain ends early at a link broken by an edge added after
+    // fusion, whose successors are then released as usual. Once the
+    // topology is cancelled or a task stores an exception in the parent (a
+    // subflow or a module), which cancels nothing, the rest is skipped.
+    inline Node* Executor::_invoke_fused_tasks(Worker& worker, Node* head) {
+      auto parent = head->_parent;
+      auto tail = head;
+      auto stopped = false;
+      for(auto node : head->_meta->fused) {
+        if(!tail->_is_linked_to(node)) {
+          break;
+        }
+        stopped = stopped || node->_is_cancelled() ||
+          (parent && (parent->_state.load(std::memory_order_relaxed) & Node::EXCEPTION));
+        if(!stopped) {
+          _invoke_static_task(worker, node);
+        }
+        tail = node;
+      }
+      return tail;
+    }
+
     // Procedure: _invoke_subflow_task
     inline void Executor::_invoke_subflow_task(Worker& w, Node* node) {
       _observer_prologue(w, node);
       DUBHE_EXECUTOR_EXCEPTION_HANDLER(w, node, {
         auto handle = std::get_if<Node::Subflow>(&node->_handle);
         handle->subgraph._clear();
+        // children are spawned from the arena of this worker, which takes
+        // no lock, and their chunks are reused in bulk once they are gone
+        handle->subgraph._arena = &w._arena;
         Subflow sf(*this, w, node, handle->subgraph);
         handle->work(sf);
+        handle->subgraph._arena = nullptr;
         if(sf._joinable) {
           _corun_graph(w, node, handle->subgraph);
         }
@@ -1963,11 +3967,77 @@ namespace dubhe {
       return run_n(f, 1, [](){});
     }
 
+    // Function: run
+    inline LightFuture<void> Executor::run(LightFutureTag, Taskflow& f) {
+      auto state = LightState<void>::_make();
+      LightFuture<void> future(state);
+      _run_until(
+        f, [repeat=size_t{1}]() mutable { return repeat-- == 0; }, [](){},
+        std::chrono::steady_clock::time_point::max(), nullptr, false, state
+      );
+      return future;
+    }
+
     // Function: run
     inline dubhe::Future<void> Executor::run(Taskflow&& f) {
       return run_n(std::move(f), 1, [](){});
     }
 
+    // Function: run
+    inline dubhe::Future<void> Executor::run(
+      Taskflow& f, std::chrono::steady_clock::time_point deadline
+    ) {
+      return _run_until(f, [repeat=size_t{1}]() mutable { return repeat-- == 0; }, [](){}, deadline);
+    }
+
+    // Function: run
+    inline dubhe::Future<void> Executor::run(
+      Taskflow&& f, std::chrono::steady_clock::time_point deadline
+    ) {
+
+      std::list<Taskflow>::iterator itr;
+
+      {
+        std::scoped_lock<std::mutex> lock(_taskflows_mutex);
+        itr = _taskflows.emplace(_taskflows.end(), std::move(f));
+        itr->_satellite = itr;
+      }
+
+      return run(*itr, deadline);
+    }
+
+    // Function: run
+    inline dubhe::Future<void> Executor::run(Taskflow& f, Tenant& tenant) {
+      return run_n(f, 1, tenant);
+    }
+
+    // Function: run
+    inline dubhe::Future<void> Executor::run(Taskflow&& f, Tenant& tenant) {
+      return run_n(std::move(f), 1, tenant);
+    }
+
+    // Function: try_run
+    inline std::optional<dubhe::Future<void>> Executor::try_run(Taskflow& f) {
+      if(!_try_reserve(nullptr, 1)) {
+        return std::nullopt;
+      }
+      return _run_until(
+        f, [repeat=size_t{1}]() mutable { return repeat-- == 0; }, [](){},
+        std::chrono::steady_clock::time_point::max(), nullptr, true
+      );
+    }
+
+    // Function: try_run
+    inline std::optional<dubhe::Future<void>> Executor::try_run(Taskflow& f, Tenant& tenant) {
+      if(!_try_reserve(&tenant, 1)) {
+        return std::nullopt;
+      }
+      return _run_until(
+        f, [repeat=size_t{1}]() mutable { return repeat-- == 0; }, [](){},
+        std::chrono::steady_clock::time_point::max(), &tenant, true
+      );
+    }
+
     // Function: run
     template <typename C>
     dubhe::Future<void> Executor::run(Taskflow& f, C&& c) {
@@ -2006,6 +4076,28 @@ namespace dubhe {
       );
     }
 
+    // Function: run_n
+    inline dubhe::Future<void> Executor::run_n(Taskflow& f, size_t repeat, Tenant& tenant) {
+      return _run_until(
+        f, [repeat]() mutable { return repeat-- == 0; }, [](){},
+        std::chrono::steady_clock::time_point::max(), &tenant
+      );
+    }
+
+    // Function: run_n
+    inline dubhe::Future<void> Executor::run_n(Taskflow&& f, size_t repeat, Tenant& tenant) {
+
+      std::list<Taskflow>::iterator itr;
+
+      {
+        std::scoped_lock<std::mutex> lock(_taskflows_mutex);
+        itr = _taskflows.emplace(_taskflows.end(), std::move(f));
+        itr->_satellite = itr;
+      }
+
+      return run_n(*itr, repeat, tenant);
+    }
+
     // Function: run_until
     template<typename P>
     dubhe::Future<void> Executor::run_until(Taskflow& f, P&& pred) {
@@ -2021,6 +4113,22 @@ namespace dubhe {
     // Function: run_until
     template <typename P, typename C>
     dubhe::Future<void> Executor::run_until(Taskflow& f, P&& p, C&& c) {
+      return _run_until(
+        f, std::forward<P>(p), std::forward<C>(c), std::chrono::steady_clock::time_point::max()
+      );
+    }
+
+    // Function: _run_until
+    template <typename P, typename C>
+    dubhe::Future<void> Executor::_run_until(
+      Taskflow& f, P&& p, C&& c, std::chrono::steady_clock::time_point deadline,
+      Tenant* tenant, bool reserved, LightState<void>* light
+    ) {
+
+      // a taskflow needs the workers to run and cannot be run inline
+      if(!reserved) {
+        _reserve(tenant, 1, false);
+      }
 
       _increment_topology();
 
@@ -2035,17 +4143,32 @@ namespace dubhe {
       // No need to create a real topology but returns an dummy future
       if(empty || p()) {
         c();
+        _release(tenant);
+        _decrement_topology();
+        if(light) {
+          light->_set_value();
+          light->_release();
+          return dubhe::Future<void>();
+        }
         std::promise<void> promise;
         promise.set_value();
-        _decrement_topology();
-        return dubhe::Future<void>(promise.get_future());
+        return dubhe::Future<void>(promise.get_future(), this);
       }
 
       // create a topology for this run
       auto t = std::make_shared<Topology>(f, std::forward<P>(p), std::forward<C>(c));
+      t->_deadline = deadline;
+      t->_tenant = tenant;
+      t->_light = light;
 
       // need to create future before the topology got torn down quickly
-      dubhe::Future<void> future(t->_promise.get_future(), t);
+      dubhe::Future<void> future;
+      if(light == nullptr) {
+        future = dubhe::Future<void>(
+          t->_promise.emplace().get_future(), this,
+          std::shared_ptr<Continuations>(t, &t->_continuations), t
+        );
+      }
 
       // modifying topology needs to be protected under the lock
       {
@@ -2104,13 +4227,235 @@ namespace dubhe {
       // TODO: exception?
     }
 
+    // Function: _try_reserve
+    // Reserves n pending tasks within the bound of the executor and the
+    // bound of the tenant. A batch larger than a bound is admitted once
+    // nothing else is pending, and the workers of this executor always
+    // succeed.
+    inline bool Executor::_try_reserve(Tenant* tenant, size_t n) {
+
+      auto try_add = [n, force=_this_worker() != nullptr](std::atomic<size_t>& c, size_t max) {
+        auto v = c.load(std::memory_order_seq_cst);
+        do {
+          if(!force && max != 0 && v != 0 && v + n > max) {
+            return false;
+          }
+        } while(!c.compare_exchange_weak(v, v + n, std::memory_order_seq_cst));
+        return true;
+      };
+
+      if(!try_add(_num_pending, _backpressure.max_pending)) {
+        return false;
+      }
+
+      // Undoing the reservation needs no notification: the tenant bound is
+      // only hit with tasks of the tenant pending, whose release notifies
+      // anyone refused in between.
+      if(tenant && !try_add(tenant->_num_pending, tenant->max_pending())) {
+        _num_pending.fetch_sub(n, std::memory_order_seq_cst);
+        return false;
+      }
+
+      return true;
+    }
+
+    // Function: _reserve
+    // reserves n pending tasks by the overflow mode, where false means the
+    // caller is to run the work inline
+    inline bool Executor::_reserve(Tenant* tenant, size_t n, bool inlinable) {
+
+      if(_try_reserve(tenant, n)) {
+        return true;
+      }
+
+      switch(_backpressure.mode) {
+        case OverflowMode::FAIL:
+          DUBHE_THROW("executor has reached its bound of pending tasks");
+        break;
+
+        case OverflowMode::INLINE:
+          if(inlinable) {
+            return false;
+          }
+        break;
+
+        default:
+        break;
+      }
+
+      // The blocked count is raised before the retry such that a release
+      // either sees the blocked submitter or frees room for its retry.
+      std::unique_lock<std::mutex> lock(_pending_mutex);
+      _num_blocked.fetch_add(1, std::memory_order_seq_cst);
+      _pending_cv.wait(lock, [&](){ return _try_reserve(tenant, n); });
+      _num_blocked.fetch_sub(1, std::memory_order_relaxed);
+
+      return true;
+    }
+
+    // Procedure: _release
+    inline void Executor::_release(Tenant* tenant, size_t n) {
+      _num_pending.fetch_sub(n, std::memory_order_seq_cst);
+      if(tenant) {
+        tenant->_num_pending.fetch_sub(n, std::memory_order_seq_cst);
+      }
+      if(_num_blocked.load(std::memory_order_seq_cst) != 0) {
+        std::scoped_lock<std::mutex> lock(_pending_mutex);
+        _pending_cv.notify_all();
+      }
+    }
+
+    // Function: _params_tenant
+    template <typename P>
+    Tenant* Executor::_params_tenant(const P& params) {
+      if constexpr(std::is_same_v<std::decay_t<P>, TaskParams>) {
+        return params.tenant;
+      }
+      else {
+        return nullptr;
+      }
+    }
+
+    // Function: _timer_due
+    inline bool Executor::_timer_due() const {
+      return _num_timers.load(std::memory_order_relaxed) != 0 &&
+             std::chrono::steady_clock::now().time_since_epoch().count() >=
+             _next_timer.load(std::memory_order_relaxed);
+    }
+
+    // Procedure: _arm_timer
+    // puts the task of a timer into the wheel, or schedules it right away if
+    // it is due already
+    inline void Executor::_arm_timer(
+      std::chrono::steady_clock::time_point tp, Node* node, bool counted
+    ) {
+      {
+        std::scoped_lock<std::mutex> lock(_timer_mutex);
+        if(!counted && _timers_stopped) {
+          node_pool.recycle(node);
+          return;
+        }
+        if(_timers.insert(tp, {node, counted})) {
+          _num_timers.fetch_add(1, std::memory_order_relaxed);
+          _next_timer.store(
+            _timers.next_due().time_since_epoch().count(), std::memory_order_relaxed
+          );
+          node = nullptr;
+        }
+      }
+
+      // an armed timer wakes the keeper to sleep until the new time, or a
+      // worker to become the keeper if there is none
+      if(node == nullptr) {
+        if(_timer_keeper.load(std::memory_order_acquire)) {
+          _notifier.wake_sleepers();
+        }
+        else {
+          _notifier.notify(false);
+        }
+        return;
+      }
+
+      if(!counted) {
+        _increment_topology();
+      }
+      _num_pending.fetch_add(1, std::memory_order_relaxed);
+      _schedule_async_task(node);
+    }
+
+    // Procedure: _arm_periodic
+    // arms the next run of a periodic timer; each run re-arms the timer
+    // after its work is done, such that runs never overlap
+    inline void Executor::_arm_periodic(std::shared_ptr<Timer::State> state) {
+      auto node = node_pool.animate(
+        DefaultTaskParams{}, nullptr, nullptr, 0,
+        // handle
+        std::in_place_type_t<Node::Async>{},
+        [this, state]() {
+          if(state->cancelled.load(std::memory_order_relaxed)) {
+            return;
+          }
+          state->work();
+          state->next += state->period;
+          if(auto now = std::chrono::steady_clock::now(); state->next < now) {
+            state->next += ((now - state->next) / state->period + 1) * state->period;
+          }
+          if(!state->cancelled.load(std::memory_order_relaxed)) {
+            _arm_periodic(state);
+          }
+        }
+      );
+      _arm_timer(state->next, node, false);
+    }
+
+    // Procedure: _stop_timers
+    // drops the periodic timers the application has not cancelled and keeps
+    // the runs in flight from arming them again, whereas one-shot timers
+    // stay in the wheel to fire as wait_for_all expects
+    inline void Executor::_stop_timers() {
+
+      std::vector<std::pair<Node*, bool>> dropped;
+
+      {
+        std::scoped_lock<std::mutex> lock(_timer_mutex);
+        _timers_stopped = true;
+        _timers.drain_if([](auto& timer){ return !timer.second; }, dropped);
+        _num_timers.fetch_sub(dropped.size(), std::memory_order_relaxed);
+        _next_timer.store(
+          _timers.next_due().time_since_epoch().count(), std::memory_order_relaxed
+        );
+      }
+
+      for(auto [node, counted] : dropped) {
+        node_pool.recycle(node);
+      }
+    }
+
+    // Function: _fire_timers
+    // advances the wheel to now and turns the due timers into ready tasks,
+    // returning one of them to the caller and scheduling the rest; a worker
+    // that finds the wheel busy leaves the timers to its holder
+    inline Node* Executor::_fire_timers(Worker& worker) {
+
+      std::vector<std::pair<Node*, bool>> expired;
+
+      if(std::unique_lock<std::mutex> lock(_timer_mutex, std::try_to_lock); lock) {
+        _timers.advance(std::chrono::steady_clock::now(), expired);
+        _num_timers.fetch_sub(expired.size(), std::memory_order_relaxed);
+        _next_timer.store(
+          _timers.next_due().time_since_epoch().count(), std::memory_order_relaxed
+        );
+      }
+
+      if(expired.empty()) {
+        return nullptr;
+      }
+
+      for(auto [node, counted] : expired) {
+        if(!counted) {
+          _increment_topology();
+        }
+      }
+      _num_pending.fetch_add(expired.size(), std::memory_order_relaxed);
+
+      // the wheel hands back the timers in due order; push them in reverse
+      // such that the owner pops them from its queue in that order
+      for(size_t i=expired.size(); i-- > 1;) {
+        _schedule(worker, expired[i].first);
+      }
+
+      auto node = expired[0].first;
+      node->_state.fetch_or(Node::READY, std::memory_order_release);
+      return node;
+    }
+
     // Procedure: _increment_topology
-    inline void Executor::_increment_topology() {
+    inline void Executor::_increment_topology(size_t n) {
     #ifdef __cpp_lib_atomic_wait
-      _num_topologies.fetch_add(1, std::memory_order_relaxed);
+      _num_topologies.fetch_add(n, std::memory_order_relaxed);
     #else
       std::lock_guard<std::mutex> lock(_topology_mutex);
-      ++_num_topologies;
+      _num_topologies += n;
     #endif
     }
 
@@ -2164,6 +4509,33 @@ namespace dubhe {
     inline void Executor::_set_up_graph(
       Graph& g, Node* parent, Topology* tpg, int state, SmallVector<Node*>& src
     ) {
+
+      // a frozen graph has its join counters and sources at hand, unless a
+      // dependency was added or a task turned into or from a condition task
+      // through dubhe::Task after freezing
+      if(auto frozen = g._frozen.get(); frozen) {
+        auto stale = false;
+        for(auto& [node, join_counter, flags, num_dependents, conditioner] : frozen->entries) {
+          if(node->num_dependents() != num_dependents ||
+             node->_is_conditioner() != conditioner) {
+            stale = true;
+            break;
+          }
+          node->_topology = tpg;
+          node->_parent = parent;
+          node->_state.store(state | flags, std::memory_order_relaxed);
+          node->_join_counter.store(join_counter, std::memory_order_relaxed);
+          if(node->_meta) {
+            node->_meta->exception_ptr = nullptr;
+          }
+        }
+        if(!stale) {
+          src.insert(src.end(), frozen->sources.begin(), frozen->sources.end());
+          return;
+        }
+        g._frozen.reset();
+      }
+
       for(auto node : g._nodes) {
         node->_topology = tpg;
         node->_parent = parent;
@@ -2172,7 +4544,9 @@ namespace dubhe {
           src.push_back(node);
         }
         node->_set_up_join_counter();
-        node->_exception_ptr = nullptr;
+        if(node->_meta) {
+          node->_meta->exception_ptr = nullptr;
+        }
       }
     }
 
@@ -2202,8 +4576,12 @@ namespace dubhe {
         if(std::unique_lock<std::mutex> lock(f._mutex); f._topologies.size()>1) {
           //assert(tpg->_join_counter == 0);
 
+          // The pending run is released before the promise is set, after
+          // which the tenant may be gone.
+          _release(tpg->_tenant);
+
           // Set the promise
-          tpg->_promise.set_value();
+          tpg->_carry_out_promise();
           f._topologies.pop();
           tpg = f._topologies.front().get();
 
@@ -2224,7 +4602,8 @@ namespace dubhe {
           lock.unlock();
 
           // Soon after we carry out the promise, there is no longer any guarantee
-          // for the lifetime of the associated taskflow.
+          // for the lifetime of the associated taskflow and tenant.
+          _release(fetched_tpg->_tenant);
           fetched_tpg->_carry_out_promise();
 
           _decrement_topology();
@@ -2332,7 +4711,7 @@ namespace dubhe {
 
       _parent->_join_counter.fetch_add(1, std::memory_order_relaxed);
 
-      auto node = node_pool.animate(
+      auto node = w._arena.animate(
         std::forward<P>(params), _parent->_topology, _parent, 0,
         std::in_place_type_t<Node::Async>{}, std::forward<F>(f)
       );
@@ -2379,10 +4758,10 @@ namespace dubhe {
       std::packaged_task<R()> p(std::forward<F>(f));
       auto fu{p.get_future()};
 
-      auto node = node_pool.animate(
+      auto node = w._arena.animate(
         std::forward<P>(params), _parent->_topology, _parent, 0,
         std::in_place_type_t<Node::Async>{},
-        [p=make_moc(std::move(p))] () mutable { p.object(); }
+        std::move(p)
       );
 
       _executor._schedule(w, node);
@@ -0,0 +1,376 @@
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <dubhe/utility/affinity.h>
+#include <chrono>
+
+/**
+@file executor_options.h
+@brief executor options include file
+*/
+
+namespace dubhe {
+
+    // ----------------------------------------------------------------------------
+    // WaitPolicy
+    // ----------------------------------------------------------------------------
+
+    /**
+    @enum WaitMode
+
+    @brief enumeration of the ways an idle worker waits for tasks
+
+    Every idle worker first makes a round of steal attempts over its victims.
+    The mode decides what happens when that round fails and before the worker
+    parks itself on the notifier.
+    */
+    enum class WaitMode : int {
+      /** @brief yields the thread between steal attempts and parks after
+                 WaitPolicy::num_yields yields (the classic behavior) */
+      YIELD = 0,
+      /** @brief keeps stealing with a cpu pause in between for
+                 WaitPolicy::spin_budget before parking (lowest latency) */
+      SPIN,
+      /** @brief pauses for an exponentially growing number of cpu pauses
+                 between steal attempts for WaitPolicy::spin_budget before parking */
+      BACKOFF,
+      /** @brief parks as soon as one steal attempt fails (lowest energy) */
+      PARK
+    };
+
+    /**
+    @struct WaitPolicy
+
+    @brief structure to configure how idle workers wait for tasks
+
+    Latency-critical services typically prefer WaitMode::SPIN, which burns
+    cpu cycles to react to a new task within nanoseconds, whereas batch
+    services prefer WaitMode::PARK to give the cpus back to the system as
+    soon as there is nothing to run.
+
+    @code{.cpp}
+    dubhe::ExecutorOptions options;
+    options.wait_policy.mode = dubhe::WaitMode::SPIN;
+    options.wait_policy.spin_budget = std::chrono::microseconds(200);
+    dubhe::Executor executor(8, options);
+    @endcode
+    */
+    struct WaitPolicy {
+
+      /**
+      @brief wait mode of idle workers
+      */
+      WaitMode mode {WaitMode::YIELD};
+
+      /**
+      @brief number of failed steal attempts before the worker starts
+             to back off
+
+      A value of zero selects the default of <tt>2*(N+1)</tt> for an
+      executor of @c N workers. The value has no effect under WaitMode::PARK.
+      It bounds the steals of idle workers only: workers joining a subflow
+      or a corun and the steals within a NUMA group keep the default bounds.
+      */
+      size_t num_steals {0};
+
+      /**
+      @brief number of yields before parking under WaitMode::YIELD
+      */
+      size_t num_yields {100};
+
+      /**
+      @brief time to keep stealing before parking under WaitMode::SPIN
+             and WaitMode::BACKOFF
+      */
+      std::chrono::nanoseconds spin_budget {std::chrono::microseconds(50)};
+
+      /**
+      @brief maximum number of cpu pauses between two steal attempts
+             under WaitMode::BACKOFF
+      */
+      size_t max_backoff {1024};
+    };
+
+    // ----------------------------------------------------------------------------
+    // ElasticPolicy
+    // ----------------------------------------------------------------------------
+
+    /**
+    @struct ElasticPolicy
+
+    @brief structure to configure how an executor grows and shrinks its
+           worker count at runtime
+
+    An executor created with @c N workers preallocates
+    ElasticPolicy::max_workers worker slots, of which @c N are spawned at
+    construction. Workers can be added or retired by
+    dubhe::Executor::add_workers and dubhe::Executor::remove_workers, or
+    automatically by a controller thread when ElasticPolicy::automatic is
+    enabled.
+
+    @code{.cpp}
+    dubhe::ExecutorOptions options;
+    options.elastic_policy.max_workers = 32;
+    options.elastic_policy.min_workers = 2;
+    options.elastic_policy.automatic = true;
+    dubhe::Executor executor(4, options);   // 4 workers, between 2 and 32
+    @endcode
+    */
+    struct ElasticPolicy {
+
+      /**
+      @brief maximum number of workers
+
+      A value smaller than the initial worker count (including the default
+      zero) fixes the executor at its initial size.
+      */
+      size_t max_workers {0};
+
+      /**
+      @brief minimum number of workers the controller retires down to
+
+      The executor always keeps at least one worker.
+      */
+      size_t min_workers {1};
+
+      /**
+      @brief enables the controller thread that resizes the executor
+
+      Every ElasticPolicy::interval, the controller adds one worker if no
+      worker is parked and more tasks are queued than there are workers, and
+      retires one worker if some workers have been parked for
+      ElasticPolicy::idle_intervals consecutive intervals.
+      */
+      bool automatic {false};
+
+      /**
+      @brief sampling interval of the controller
+      */
+      std::chrono::microseconds interval {std::chrono::milliseconds(1)};
+
+      /**
+      @brief number of consecutive idle intervals before the controller
+             retires a worker
+      */
+      size_t idle_intervals {100};
+    };
+
+    // ----------------------------------------------------------------------------
+    // BackpressurePolicy
+    // ----------------------------------------------------------------------------
+
+    /**
+    @enum OverflowMode
+
+    @brief enumeration of the ways a submission is handled once the bound
+           of pending tasks is reached
+    */
+    enum class OverflowMode : int {
+      /** @brief blocks the submitter until enough pending tasks finish */
+      BLOCK = 0,
+      /** @brief throws a dubhe exception to the submitter */
+      FAIL,
+      /** @brief runs the submitted work on the calling thread instead of
+                 queuing it; taskflow runs block as they need the workers */
+      INLINE
+    };
+
+    /**
+    @struct BackpressurePolicy
+
+    @brief structure to bound the work submitted to an executor
+
+    A pending task is an asynchronous task created by dubhe::Executor::async,
+    dubhe::Executor::silent_async, or dubhe::Executor::silent_async_bulk, or
+    a taskflow run submitted by dubhe::Executor::run and its variants, from
+    its submission until it finishes. Once the executor holds
+    BackpressurePolicy::max_pending pending tasks, a further submission is
+    handled by BackpressurePolicy::mode, whereas the @c try_ variants of the
+    submission methods (e.g., dubhe::Executor::try_async) return without
+    submitting. A dubhe::Tenant can impose a bound of its own on its pending
+    tasks in the same way.
+
+    Submissions from the workers of the executor itself are never held
+    back, since a blocked worker could keep the very tasks it waits for from
+    running, but they do count as pending.
+
+    @code{.cpp}
+    dubhe::ExecutorOptions options;
+    options.backpressure.max_pending = 10000;
+    options.backpressure.mode = dubhe::OverflowMode::INLINE;
+    dubhe::Executor executor(8, options);
+    @endcode
+    */
+    struct BackpressurePolicy {
+
+      /**
+      @brief maximum number of pending tasks
+
+      A value of zero leaves the executor unbounded. A batch larger than
+      the bound is admitted once nothing else is pending.
+      */
+      size_t max_pending {0};
+
+      /**
+      @brief handling of a submission beyond the bound
+      */
+      OverflowMode mode {OverflowMode::BLOCK};
+    };
+
+    // ----------------------------------------------------------------------------
+    // ExecutorOptions
+    // ----------------------------------------------------------------------------
+
+    /**
+    @struct ExecutorOptions
+
+    @brief structure to configure the scheduling behavior of an executor
+
+    The default-constructed options give the classic flat work-stealing
+    executor, where all workers form a single group and steal from each
+    other uniformly at random.
+
+    @code{.cpp}
+    dubhe::ExecutorOptions options;
+    options.numa_aware = true;          // one worker group per NUMA node
+    options.num_local_steals = 32;      // escalate after 32 failed local steals
+    options.affinity = dubhe::AffinityPolicy::NO_SMT;  // one worker per core
+    dubhe::Executor executor(16, options);
+    @endcode
+    */
+    struct ExecutorOptions {
+
+      /**
+      @brief groups workers by NUMA node
+
+      When enabled, the executor discovers the NUMA nodes from
+      ExecutorOptions::numa_sysfs_root, splits the workers among the nodes
+      in proportion to the CPUs of each node that the process is allowed to
+      run on, and restricts every worker to those CPUs of its node. Nodes
+      without allowed CPUs receive no workers. Each group owns a shared injection queue for tasks
+      submitted from outside the executor, and workers steal inside their own
+      group before escalating to remote groups.
+      */
+      bool numa_aware {false};
+
+      /**
+      @brief number of failed steal attempts inside the local group
+             before a worker starts stealing from remote groups
+
+      A value of zero selects a default proportional to the group size.
+      The value has no effect when there is only one group.
+      */
+      size_t num_local_steals {0};
+
+      /**
+      @brief sysfs directory to discover the NUMA nodes from
+      */
+      std::string numa_sysfs_root {DUBHE_NUMA_SYSFS_ROOT};
+
+      /**
+      @brief placement policy of the workers
+
+      Workers are pinned at spawn time to cpus in the affinity mask of the
+      process. When ExecutorOptions::numa_aware is enabled, the policy is
+      applied within the cpus of each worker group. The chosen cpu of a
+      worker is reported by dubhe::WorkerView::cpu.
+      */
+      AffinityPolicy affinity {AffinityPolicy::NONE};
+
+      /**
+      @brief cpus to pin the workers to under AffinityPolicy::EXPLICIT
+
+      Worker @c i is pinned to the <tt>i%M</tt>-th of the @c M listed cpus
+      that the process is allowed to run on.
+      */
+      std::vector<size_t> affinity_cpus;
+
+      /**
+      @brief sysfs directory to discover the cpu topology (SMT siblings and
+             packages) from
+      */
+      std::string cpu_sysfs_root {DUBHE_CPU_SYSFS_ROOT};
+
+      /**
+      @brief policy of idle workers waiting for tasks
+      */
+      WaitPolicy wait_policy;
+
+      /**
+      @brief shrinks the task queue of a worker every time it parks
+
+      A deep recursion can grow the queue of a worker far beyond its usual
+      size. When enabled, a worker about to park gives the memory of its
+      queue back down to the initial capacity, so the memory of the
+      executor follows its working set rather than its historical peak.
+      The memory of the larger array is freed once every other worker has
+      started a new round of steals or is parked.
+      */
+      bool shrink_on_idle {false};
+
+      /**
+      @brief number of times a worker may pass over a waiting priority
+             bucket before it serves that bucket first
+
+      By default, workers always take a task of the highest non-empty
+      priority bucket, such that a steady stream of high-priority tasks
+      starves the low-priority ones. A non-zero value @c K ages the waiting
+      buckets instead: every time a worker takes a task from its queue or a
+      group queue while a lower-priority bucket of that queue is non-empty,
+      the age of that bucket grows by one, and a bucket of age @c K is
+      served next. The waiting of a low-priority task is thereby bounded
+      by about @c K tasks per higher-priority bucket on every queue it
+      passes through.
+      */
+      size_t priority_aging {0};
+
+      /**
+      @brief sends a task without an affinity hint to the worker that ran
+             it last time
+
+      A taskflow run many times over the same data then keeps the
+      assignment of its tasks to workers from one run to the next, such
+      that a task finds its data in the caches of the worker that touched
+      it before. Tasks reach the worker through its mailbox as with
+      dubhe::Task::affinity, and other workers take them only when they
+      have nothing else to do.
+      */
+      bool replay_affinity {false};
+
+      /**
+      @brief policy of growing and shrinking the worker count at runtime
+      */
+      ElasticPolicy elastic_policy;
+
+      /**
+      @brief policy of bounding the submitted work
+      */
+      BackpressurePolicy backpressure;
+
+      /**
+      @brief tick of the timer wheel behind dubhe::Executor::schedule_at,
+             dubhe::Executor::schedule_after, and dubhe::Executor::schedule_every
+
+      A timer never fires before its due time and fires about one tick
+      late at most, as long as a worker is free to run it.
+      */
+      std::chrono::nanoseconds timer_resolution {std::chrono::microseconds(100)};
+    };
+
+}  // namespace dubhe
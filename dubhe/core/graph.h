@@ -21,14 +21,18 @@
 #include <dubhe/utility/traits.h>
 #include <dubhe/utility/iterator.h>
 #include <dubhe/utility/object_pool.h>
+#include <dubhe/utility/object_arena.h>
 #include <dubhe/utility/os.h>
 #include <dubhe/utility/math.h>
 #include <dubhe/utility/small_vector.h>
+#include <dubhe/utility/small_function.h>
 #include <dubhe/utility/serializer.h>
 #include <dubhe/core/error.h>
 #include <dubhe/core/declarations.h>
 #include <dubhe/core/semaphore.h>
+#include <dubhe/core/tenant.h>
 #include <dubhe/core/environment.h>
+#include <dubhe/core/light_future.h>
 #include <dubhe/core/topology.h>
 #include <dubhe/core/tsq.h>
 
@@ -66,6 +70,7 @@ class Graph {
   friend class Subflow;
   friend class Taskflow;
   friend class Executor;
+  friend class OverlappedRun;
 
   public:
 
@@ -116,12 +121,35 @@ class Graph {
 
   private:
 
+    // the set-up of a run precomputed by dubhe::Taskflow::freeze
+    struct Frozen {
+
+      struct Entry {
+        Node* node;
+        size_t join_counter;
+        int state;
+        size_t num_dependents;
+        bool conditioner;
+      };
+
+      std::vector<Entry> entries;
+      std::vector<Node*> sources;
+    };
+
     std::vector<Node*> _nodes;
 
+    std::unique_ptr<Frozen> _frozen;
+
+    // arena of the worker running the subflow that builds this graph
+    ObjectArena<Node>* _arena {nullptr};
+
     void _clear();
     void _clear_detached();
     void _merge(Graph&&);
     void _erase(Node*);
+    void _freeze();
+    size_t _fuse();
+    void _unfuse();
     
     /**
     @private
@@ -560,6 +588,22 @@ struct TaskParams {
   @brief C-styled pointer to user data
   */
   void* data {nullptr};
+
+  /**
+  @brief absolute deadline of the task
+
+  A task with a deadline is scheduled in earliest-deadline-first order
+  ahead of tasks without one (see dubhe::Task::deadline).
+  */
+  std::chrono::steady_clock::time_point deadline {std::chrono::steady_clock::time_point::max()};
+
+  /**
+  @brief tenant the task belongs to
+
+  A task of a tenant shares the workers with other tenants in proportion
+  to the tenant weights (see dubhe::Tenant).
+  */
+  Tenant* tenant {nullptr};
 };
 
 /**
@@ -602,6 +646,8 @@ class Node {
   friend class FlowBuilder;
   friend class Subflow;
   friend class Runtime;
+  friend class CoroutinePromiseBase;
+  friend class OverlappedRun;
 
   enum class AsyncState : int {
     UNFINISHED = 0,
@@ -609,14 +655,15 @@ class Node {
     FINISHED = 2
   };
 
-  DUBHE_ENABLE_POOLABLE_ON_THIS;
-
   // state bit flag
   constexpr static int CONDITIONED = 1;
   constexpr static int DETACHED    = 2;
   constexpr static int ACQUIRED    = 4;
   constexpr static int READY       = 8;
   constexpr static int EXCEPTION   = 16;
+  constexpr static int ADMITTED    = 32;
+
+  constexpr static unsigned NO_AFFINITY = std::numeric_limits<unsigned>::max();
 
   using Placeholder = std::monostate;
 
@@ -627,7 +674,7 @@ class Node {
     Static(C&&);
 
     std::variant<
-      std::function<void()>, std::function<void(Runtime&)>
+      SmallFunction<void()>, SmallFunction<void(Runtime&)>
     > work;
   };
 
@@ -637,7 +684,7 @@ class Node {
     template <typename C>
     Subflow(C&&);
 
-    std::function<void(dubhe::Subflow&)> work;
+    SmallFunction<void(dubhe::Subflow&)> work;
     Graph subgraph;
   };
 
@@ -648,7 +695,7 @@ class Node {
     Condition(C&&);
     
     std::variant<
-      std::function<int()>, std::function<int(Runtime&)>
+      SmallFunction<int()>, SmallFunction<int(Runtime&)>
     > work;
   };
 
@@ -659,7 +706,7 @@ class Node {
     MultiCondition(C&&);
 
     std::variant<
-      std::function<SmallVector<int>()>, std::function<SmallVector<int>(Runtime&)>
+      SmallFunction<SmallVector<int>()>, SmallFunction<SmallVector<int>(Runtime&)>
     > work;
   };
 
@@ -679,7 +726,7 @@ class Node {
     Async(T&&);
 
     std::variant<
-      std::function<void()>, std::function<void(Runtime&)>
+      SmallFunction<void()>, SmallFunction<void(Runtime&)>
     > work;
   };
   
@@ -690,7 +737,7 @@ class Node {
     DependentAsync(C&&);
     
     std::variant<
-      std::function<void()>, std::function<void(Runtime&)>
+      SmallFunction<void()>, SmallFunction<void(Runtime&)>
     > work;
    
     std::atomic<size_t> use_count {1};
@@ -713,6 +760,17 @@ class Node {
     SmallVector<Semaphore*> to_release;
   };
 
+  // metadata the scheduler rarely touches, allocated on first use
+  struct Meta {
+    std::string name;
+    void* data {nullptr};
+    Semaphores semaphores;
+    std::exception_ptr exception_ptr {nullptr};
+    SmallVector<Node*> next_successors;
+    SmallVector<Node*> fused;
+    uint64_t cost {1};
+  };
+
   public:
 
   // variant index
@@ -750,31 +808,50 @@ class Node {
 
   private:
 
-  std::string _name;
-  
+  // fields read or written every time the node is scheduled, starting on
+  // a cache line of their own such that they span as few lines as possible
+  alignas(DUBHE_CACHELINE_SIZE) std::atomic<int> _state {0};
+
   unsigned _priority {0};
-  
-  void* _data {nullptr};
-  
+
+  // worker hinted by Task::affinity and the worker that ran the node last
+  unsigned _affinity {NO_AFFINITY};
+  unsigned _last_worker {NO_AFFINITY};
+
+  std::atomic<size_t> _join_counter {0};
+
   Topology* _topology {nullptr};
   Node* _parent {nullptr};
 
+  Tenant* _tenant {nullptr};
+
+  std::chrono::steady_clock::time_point _deadline {std::chrono::steady_clock::time_point::max()};
+
   SmallVector<Node*> _successors;
   SmallVector<Node*> _dependents;
 
-  std::atomic<int> _state {0};
-  std::atomic<size_t> _join_counter {0};
-
-  std::unique_ptr<Semaphores> _semaphores;
-  std::exception_ptr _exception_ptr {nullptr};
-  
   handle_t _handle;
 
+  // fields rarely or never touched by the scheduler
+  std::unique_ptr<Meta> _meta;
+
+  DUBHE_ENABLE_POOLABLE_ON_THIS;
+
+  static std::unique_ptr<Meta> _make_meta(const std::string&, void* = nullptr);
+
+  Meta& _meta_data();
+  Semaphores* _semaphores() const;
+  uint64_t _cost() const;
+  bool _is_fusible() const;
+  bool _is_linked_to(Node*) const;
+
   void _precede(Node*);
   void _set_up_join_counter();
   void _process_exception();
 
   bool _is_cancelled() const;
+  std::chrono::steady_clock::time_point _effective_deadline() const;
+  Tenant* _effective_tenant() const;
   bool _is_conditioner() const;
   bool _acquire_all(SmallVector<Node*>&);
 
@@ -790,6 +867,20 @@ class Node {
 */
 inline ObjectPool<Node> node_pool;
 
+/**
+@private
+
+returns a node to the worker arena or to the node pool it came from
+*/
+inline void recycle_node(Node* node) {
+  if(ObjectArena<Node>::owns(node)) {
+    ObjectArena<Node>::recycle(node);
+  }
+  else {
+    node_pool.recycle(node);
+  }
+}
+
 // ----------------------------------------------------------------------------
 // Definition for Node::Static
 // ----------------------------------------------------------------------------
@@ -867,12 +958,12 @@ Node::Node(
   size_t join_counter,
   Args&&... args
 ) :
-  _name         {name},
   _priority     {priority},
+  _join_counter {join_counter},
   _topology     {topology},
   _parent       {parent},
-  _join_counter {join_counter},
-  _handle       {std::forward<Args>(args)...} {
+  _handle       {std::forward<Args>(args)...},
+  _meta         {_make_meta(name)} {
 }
 
 // Constructor
@@ -884,11 +975,11 @@ Node::Node(
   size_t join_counter,
   Args&&... args
 ) :
-  _name         {name},
+  _join_counter {join_counter},
   _topology     {topology},
   _parent       {parent},
-  _join_counter {join_counter},
-  _handle       {std::forward<Args>(args)...} {
+  _handle       {std::forward<Args>(args)...},
+  _meta         {_make_meta(name)} {
 }
 
 // Constructor
@@ -900,13 +991,14 @@ Node::Node(
   size_t join_counter,
   Args&&... args
 ) :
-  _name         {params.name},
   _priority     {params.priority},
-  _data         {params.data},
+  _join_counter {join_counter},
   _topology     {topology},
   _parent       {parent},
-  _join_counter {join_counter},
-  _handle       {std::forward<Args>(args)...} {
+  _tenant       {params.tenant},
+  _deadline     {params.deadline},
+  _handle       {std::forward<Args>(args)...},
+  _meta         {_make_meta(params.name, params.data)} {
 }
 
 // Constructor
@@ -918,9 +1010,9 @@ Node::Node(
   size_t join_counter,
   Args&&... args
 ) :
+  _join_counter {join_counter},
   _topology     {topology},
   _parent       {parent},
-  _join_counter {join_counter},
   _handle       {std::forward<Args>(args)...} {
 }
 
@@ -959,7 +1051,7 @@ inline Node::~Node() {
 
     //auto& np = Graph::_node_pool();
     for(i=0; i<nodes.size(); ++i) {
-      node_pool.recycle(nodes[i]);
+      recycle_node(nodes[i]);
     }
   }
 }
@@ -1006,7 +1098,61 @@ inline size_t Node::num_strong_dependents() const {
 
 // Function: name
 inline const std::string& Node::name() const {
-  return _name;
+  static const std::string empty;
+  return _meta ? _meta->name : empty;
+}
+
+// Function: _make_meta
+// a node without a name or data needs no metadata until it is given
+// semaphores or catches an exception
+inline std::unique_ptr<Node::Meta> Node::_make_meta(const std::string& name, void* data) {
+  if(name.empty() && data == nullptr) {
+    return nullptr;
+  }
+  auto meta = std::make_unique<Meta>();
+  meta->name = name;
+  meta->data = data;
+  return meta;
+}
+
+// Function: _meta_data
+inline Node::Meta& Node::_meta_data() {
+  if(!_meta) {
+    _meta = std::make_unique<Meta>();
+  }
+  return *_meta;
+}
+
+// Function: _semaphores
+inline Node::Semaphores* Node::_semaphores() const {
+  return _meta ? &_meta->semaphores : nullptr;
+}
+
+// Function: _cost
+inline uint64_t Node::_cost() const {
+  return _meta ? _meta->cost : 1;
+}
+
+// Function: _is_fusible
+// only a static task that takes no runtime and has no semaphores can run
+// inside a fused chain
+inline bool Node::_is_fusible() const {
+  auto handle = std::get_if<Static>(&_handle);
+  if(handle == nullptr || handle->work.index() != 0) {
+    return false;
+  }
+  auto s = _semaphores();
+  return s == nullptr || (s->to_acquire.empty() && s->to_release.empty());
+}
+
+// Function: _is_linked_to
+// a node is linked to its only successor v if v has no other dependent and
+// both can run in one fused chain
+inline bool Node::_is_linked_to(Node* v) const {
+  return _successors.size() == 1 && _successors[0] == v &&
+         v->_dependents.size() == 1 &&
+         _is_fusible() && v->_is_fusible() &&
+         _tenant == v->_tenant && _deadline == v->_deadline;
 }
 
 // Function: _is_conditioner
@@ -1023,6 +1169,24 @@ inline bool Node::_is_cancelled() const {
          (_topology->_state.load(std::memory_order_relaxed) & Topology::CANCELLED);
 }
 
+// Function: _effective_deadline
+// the deadline of this node or otherwise the deadline of its run
+inline std::chrono::steady_clock::time_point Node::_effective_deadline() const {
+  if(_deadline != std::chrono::steady_clock::time_point::max() || _topology == nullptr) {
+    return _deadline;
+  }
+  return _topology->_deadline;
+}
+
+// Function: _effective_tenant
+// the tenant of this node or otherwise the tenant of its run
+inline Tenant* Node::_effective_tenant() const {
+  if(_tenant != nullptr || _topology == nullptr) {
+    return _tenant;
+  }
+  return _topology->_tenant;
+}
+
 // Procedure: _set_up_join_counter
 inline void Node::_set_up_join_counter() {
   size_t c = 0;
@@ -1040,9 +1204,9 @@ inline void Node::_set_up_join_counter() {
 
 // Procedure: _process_exception
 inline void Node::_process_exception() {
-  if(_exception_ptr) {
-    auto e = _exception_ptr;
-    _exception_ptr = nullptr;
+  if(_meta && _meta->exception_ptr) {
+    auto e = _meta->exception_ptr;
+    _meta->exception_ptr = nullptr;
     std::rethrow_exception(e);
   }
 }
@@ -1050,7 +1214,7 @@ inline void Node::_process_exception() {
 // Function: _acquire_all
 inline bool Node::_acquire_all(SmallVector<Node*>& nodes) {
 
-  auto& to_acquire = _semaphores->to_acquire;
+  auto& to_acquire = _meta->semaphores.to_acquire;
 
   for(size_t i = 0; i < to_acquire.size(); ++i) {
     if(!to_acquire[i]->_try_acquire_or_wait(this)) {
@@ -1067,7 +1231,7 @@ inline bool Node::_acquire_all(SmallVector<Node*>& nodes) {
 // Function: _release_all
 inline SmallVector<Node*> Node::_release_all() {
 
-  auto& to_release = _semaphores->to_release;
+  auto& to_release = _meta->semaphores.to_release;
 
   SmallVector<Node*> nodes;
   for(const auto& sem : to_release) {
@@ -1087,7 +1251,7 @@ inline SmallVector<Node*> Node::_release_all() {
 */
 struct NodeDeleter {
   void operator ()(Node* ptr) {
-    node_pool.recycle(ptr);
+    recycle_node(ptr);
   }
 };
 
@@ -1102,13 +1266,15 @@ inline Graph::~Graph() {
 
 // Move constructor
 inline Graph::Graph(Graph&& other) :
-  _nodes {std::move(other._nodes)} {
+  _nodes  {std::move(other._nodes)},
+  _frozen {std::move(other._frozen)} {
 }
 
 // Move assignment
 inline Graph& Graph::operator = (Graph&& other) {
   _clear();
   _nodes = std::move(other._nodes);
+  _frozen = std::move(other._frozen);
   return *this;
 }
 
@@ -1120,20 +1286,26 @@ inline void Graph::clear() {
 // Procedure: clear
 inline void Graph::_clear() {
   for(auto node : _nodes) {
-    node_pool.recycle(node);
+    recycle_node(node);
   }
   _nodes.clear();
+  _frozen.reset();
 }
 
 // Procedure: clear_detached
 inline void Graph::_clear_detached() {
 
+  // detached nodes are appended to a frozen graph after its own nodes
+  if(_frozen && _nodes.size() == _frozen->entries.size()) {
+    return;
+  }
+
   auto mid = std::partition(_nodes.begin(), _nodes.end(), [] (Node* node) {
     return !(node->_state.load(std::memory_order_relaxed) & Node::DETACHED);
   });
 
   for(auto itr = mid; itr != _nodes.end(); ++itr) {
-    node_pool.recycle(*itr);
+    recycle_node(*itr);
   }
   _nodes.resize(std::distance(_nodes.begin(), mid));
 }
@@ -1150,7 +1322,83 @@ inline void Graph::_merge(Graph&& g) {
 inline void Graph::_erase(Node* node) {
   if(auto I = std::find(_nodes.begin(), _nodes.end(), node); I != _nodes.end()) {
     _nodes.erase(I);
-    node_pool.recycle(node);
+    recycle_node(node);
+    _frozen.reset();
+    _unfuse();
+  }
+}
+
+// Procedure: _freeze
+// computes the join counter, the state and the sources of the nodes as
+// Executor::_set_up_graph would do at the beginning of every run
+inline void Graph::_freeze() {
+
+  _frozen.reset();
+  _clear_detached();
+
+  auto frozen = std::make_unique<Frozen>();
+  frozen->entries.reserve(_nodes.size());
+
+  for(auto node : _nodes) {
+    size_t join_counter = 0;
+    int state = 0;
+    for(auto p : node->_dependents) {
+      if(p->_is_conditioner()) {
+        state |= Node::CONDITIONED;
+      }
+      else {
+        join_counter++;
+      }
+    }
+    frozen->entries.push_back(
+      {node, join_counter, state, node->num_dependents(), node->_is_conditioner()}
+    );
+    if(node->num_dependents() == 0) {
+      frozen->sources.push_back(node);
+    }
+  }
+
+  _frozen = std::move(frozen);
+}
+
+// Function: _fuse
+// links each maximal chain of fusible tasks, in which a task has a single
+// successor that has no other dependent, to the first task of the chain
+inline size_t Graph::_fuse() {
+
+  _unfuse();
+  _clear_detached();
+
+  size_t num_fused = 0;
+
+  for(auto node : _nodes) {
+
+    // a node linked to its dependent continues a chain rather than heads it
+    if(node->_dependents.size() == 1 && node->_dependents[0]->_is_linked_to(node)) {
+      continue;
+    }
+
+    SmallVector<Node*> chain;
+    for(auto u = node; u->_successors.size() == 1 && u->_is_linked_to(u->_successors[0]);
+        u = u->_successors[0]) {
+      chain.push_back(u->_successors[0]);
+    }
+
+    if(!chain.empty()) {
+      num_fused += chain.size();
+      node->_meta_data().fused = std::move(chain);
+    }
+  }
+
+  return num_fused;
+}
+
+// Procedure: _unfuse
+inline void Graph::_unfuse() {
+  for(auto node : _nodes) {
+    if(node->_meta) {
+      node->_meta->fused.clear();
+    }
   }
 }
 
@@ -1169,7 +1417,11 @@ inline bool Graph::empty() const {
 */
 template <typename ...ArgsT>
 Node* Graph::_emplace_back(ArgsT&&... args) {
-  _nodes.push_back(node_pool.animate(std::forward<ArgsT>(args)...));
+  _frozen.reset();
+  _nodes.push_back(
+    _arena ? _arena->animate(std::forward<ArgsT>(args)...) :
+             node_pool.animate(std::forward<ArgsT>(args)...)
+  );
   return _nodes.back();
 }
 
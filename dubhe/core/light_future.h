@@ -0,0 +1,352 @@
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <future>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include <dubhe/core/declarations.h>
+#include <dubhe/utility/object_pool.h>
+#include <dubhe/utility/os.h>
+
+/**
+@file light_future.h
+@brief lightweight future include file
+*/
+
+namespace dubhe {
+
+    // ----------------------------------------------------------------------------
+    // LightState
+    // ----------------------------------------------------------------------------
+
+    /**
+    @private
+
+    @brief class to create the shared state of a dubhe::LightFuture
+
+    The state holds the result in place and is shared by the future and the
+    producer through a reference count of two, such that the state is
+    recycled once both have let go of it. States of up to 512 bytes come
+    from an object pool. Completion is an atomic store; a waiter blocks
+    on the state only after a short spin and only then makes the producer
+    notify it.
+    */
+    template <typename T>
+    class LightState {
+
+      // spelled out since the macro's parameter names clash with ours
+      template <typename, size_t> friend class ObjectPool;
+      void* _object_pool_block;
+
+      friend class Executor;
+      friend class Topology;
+
+      template <typename U>
+      friend class LightFuture;
+
+      constexpr static unsigned PENDING = 0;
+      constexpr static unsigned READY   = 1;
+      constexpr static unsigned WAITING = 2;
+
+      constexpr static size_t MAX_POOLED = 512;
+
+      using value_type = std::conditional_t<std::is_void_v<T>, char, T>;
+
+      public:
+
+        LightState() = default;
+
+      private:
+
+        std::atomic<unsigned> _status {PENDING};
+        std::atomic<unsigned> _refs {2};
+
+        std::optional<value_type> _value;
+        std::exception_ptr _exception;
+
+      #ifndef __cpp_lib_atomic_wait
+        std::mutex _mutex;
+        std::condition_variable _cv;
+      #endif
+
+        static auto& _pool() {
+          static ObjectPool<LightState> pool;
+          return pool;
+        }
+
+        static LightState* _make() {
+          if constexpr(sizeof(LightState) <= MAX_POOLED) {
+            return _pool().animate();
+          }
+          else {
+            return new LightState();
+          }
+        }
+
+        void _release() {
+          if(_refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            if constexpr(sizeof(LightState) <= MAX_POOLED) {
+              _pool().recycle(this);
+            }
+            else {
+              delete this;
+            }
+          }
+        }
+
+        // Procedure: _invoke
+        // runs the work and stores its result or exception
+        template <typename F>
+        void _invoke(F& f) {
+          try {
+            if constexpr(std::is_void_v<T>) {
+              f();
+              _value.emplace();
+            }
+            else {
+              _value.emplace(f());
+            }
+          }
+          catch(...) {
+            _exception = std::current_exception();
+          }
+          _notify();
+        }
+
+        void _set_value() {
+          _value.emplace();
+          _notify();
+        }
+
+        void _set_exception(std::exception_ptr e) {
+          _exception = std::move(e);
+          _notify();
+        }
+
+        bool _ready() const {
+          return _status.load(std::memory_order_acquire) == READY;
+        }
+
+        void _notify() {
+          if(_status.exchange(READY, std::memory_order_acq_rel) == WAITING) {
+          #ifdef __cpp_lib_atomic_wait
+            _status.notify_all();
+          #else
+            { std::scoped_lock lock(_mutex); }
+            _cv.notify_all();
+          #endif
+          }
+        }
+
+        void _wait() {
+
+          for(size_t i=0; i<64; ++i) {
+            if(_ready()) {
+              return;
+            }
+            relax_cpu();
+          }
+
+        #ifdef __cpp_lib_atomic_wait
+          unsigned s = PENDING;
+          if(_status.compare_exchange_strong(s, WAITING, std::memory_order_acq_rel) || s == WAITING) {
+            _status.wait(WAITING, std::memory_order_acquire);
+          }
+        #else
+          std::unique_lock lock(_mutex);
+          unsigned s = PENDING;
+          if(_status.compare_exchange_strong(s, WAITING, std::memory_order_acq_rel) || s == WAITING) {
+            _cv.wait(lock, [this](){ return _ready(); });
+          }
+        #endif
+        }
+    };
+
+    // ----------------------------------------------------------------------------
+    // LightFuture
+    // ----------------------------------------------------------------------------
+
+    /**
+    @brief tag type to select the submission methods that return a
+           dubhe::LightFuture
+    */
+    struct LightFutureTag {
+      explicit LightFutureTag() = default;
+    };
+
+    /**
+    @brief tag to select the submission methods that return a
+           dubhe::LightFuture
+
+    @code{.cpp}
+    dubhe::LightFuture<int> fu = executor.async(dubhe::light_future, [](){ return 1; });
+    @endcode
+    */
+    inline constexpr LightFutureTag light_future {};
+
+    /**
+    @class LightFuture
+
+    @tparam T result type
+
+    @brief class to access the result of an execution without the cost of
+           a @std_future
+
+    A @std_future shares a heap-allocated state with its @c std::promise and
+    completes through a mutex and a condition variable. At millions of
+    submissions per second, that allocation and synchronization dominates
+    the cost of a small task. A dubhe::LightFuture instead shares a pooled
+    state that holds the result in place and completes with a single atomic
+    store, while a waiter blocks only after a short spin.
+
+    The executor returns a light future from
+    dubhe::Executor::async(LightFutureTag, F&&) and
+    dubhe::Executor::run(LightFutureTag, Taskflow&):
+
+    @code{.cpp}
+    std::vector<dubhe::LightFuture<int>> futures;
+    for(int i=0; i<1000000; i++) {
+      futures.push_back(executor.async(dubhe::light_future, [i](){ return i; }));
+    }
+    for(auto& fu : futures) {
+      fu.get();
+    }
+    @endcode
+
+    A light future is move-only, has no continuations or cancellation
+    (see dubhe::Future for these), and may be dropped before the result is
+    ready.
+    */
+    template <typename T>
+    class LightFuture {
+
+      friend class Executor;
+
+      public:
+
+        /**
+        @brief constructs a light future that refers to no result
+        */
+        LightFuture() = default;
+
+        /**
+        @brief move constructor
+        */
+        LightFuture(LightFuture&& rhs) noexcept : _state {std::exchange(rhs._state, nullptr)} {
+        }
+
+        /**
+        @brief move assignment
+        */
+        LightFuture& operator = (LightFuture&& rhs) noexcept {
+          if(this != &rhs) {
+            if(_state) {
+              _state->_release();
+            }
+            _state = std::exchange(rhs._state, nullptr);
+          }
+          return *this;
+        }
+
+        /**
+        @brief disabled copy constructor
+        */
+        LightFuture(const LightFuture&) = delete;
+
+        /**
+        @brief disabled copy assignment
+        */
+        LightFuture& operator = (const LightFuture&) = delete;
+
+        /**
+        @brief releases the result, which the producer may still be computing
+        */
+        ~LightFuture() {
+          if(_state) {
+            _state->_release();
+          }
+        }
+
+        /**
+        @brief queries if the future refers to a result
+        */
+        bool valid() const noexcept {
+          return _state != nullptr;
+        }
+
+        /**
+        @brief queries if the result is ready without blocking
+        */
+        bool is_ready() const {
+          return _checked_state()->_ready();
+        }
+
+        /**
+        @brief blocks until the result is ready
+        */
+        void wait() const {
+          _checked_state()->_wait();
+        }
+
+        /**
+        @brief waits for the result and retrieves it
+
+        The future refers to no result afterwards. If the execution threw
+        an exception, the exception is rethrown.
+        */
+        T get() {
+          auto state = _checked_state();
+          state->_wait();
+          _state = nullptr;
+
+          struct Releaser {
+            LightState<T>* state;
+            ~Releaser() { state->_release(); }
+          } releaser {state};
+
+          if(state->_exception) {
+            std::rethrow_exception(state->_exception);
+          }
+          if constexpr(!std::is_void_v<T>) {
+            return std::move(*state->_value);
+          }
+        }
+
+      private:
+
+        LightState<T>* _state {nullptr};
+
+        explicit LightFuture(LightState<T>* state) : _state {state} {
+        }
+
+        LightState<T>* _checked_state() const {
+          if(_state == nullptr) {
+            throw std::future_error(std::future_errc::no_state);
+          }
+          return _state;
+        }
+    };
+
+}  // namespace dubhe
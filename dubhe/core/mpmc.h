@@ -0,0 +1,436 @@
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <dubhe/core/tsq.h>
+#include <deque>
+
+/**
+@file mpmc.h
+@brief multiple-producer multiple-consumer queue include file
+*/
+
+namespace dubhe {
+
+    // ----------------------------------------------------------------------------
+    // MPMC Queue
+    // ----------------------------------------------------------------------------
+
+    /**
+    @class: MPMCQueue
+
+    @tparam T data type (must be a pointer type)
+    @tparam DUBHE_MAX_PRIORITY maximum level of the priority
+
+    @brief class to create a lock-free multiple-producer multiple-consumer queue
+
+    Each priority level owns a bounded ring buffer implemented by the
+    algorithm of Dmitry Vyukov, in which producers and consumers only contend
+    on one atomic counter each. When a ring is full, items spill into a
+    mutex-protected overflow list of the same priority so that a push
+    never fails. Once a priority level spills, subsequent pushes to that level
+    also go to the overflow list until consumers drain it, which keeps the
+    items in FIFO order and prevents the spilled items from starving.
+
+    Any thread can push and steal concurrently. Priority starts from zero
+    (highest priority) to the template value `DUBHE_MAX_PRIORITY-1`
+    (lowest priority), and MPMCQueue::steal returns items of higher
+    priority first.
+
+    @code{.cpp}
+    dubhe::MPMCQueue<int*> queue;
+    int a, b;
+    queue.push(&a, 1);    // from any thread
+    queue.push(&b, 0);    // from any thread
+    assert(queue.steal() == &b);
+    assert(queue.steal() == &a);
+    @endcode
+    */
+    template <typename T, unsigned DUBHE_MAX_PRIORITY = DUBHE_NUM_PRIORITY_BUCKETS>
+    class MPMCQueue {
+
+      static_assert(DUBHE_MAX_PRIORITY > 0, "DUBHE_MAX_PRIORITY must be at least one");
+      static_assert(std::is_pointer_v<T>, "T must be a pointer type");
+
+      struct Cell {
+        std::atomic<size_t> sequence;
+        T data;
+      };
+
+      struct Ring {
+        CachelineAligned<std::atomic<size_t>> enqueue_pos;
+        CachelineAligned<std::atomic<size_t>> dequeue_pos;
+        std::unique_ptr<Cell[]> cells;
+      };
+
+      struct Overflow {
+        CachelineAligned<std::atomic<size_t>> size;
+        std::mutex mutex;
+        std::deque<T> items;
+      };
+
+      const size_t _mask;
+
+      Ring _rings[DUBHE_MAX_PRIORITY];
+      Overflow _overflows[DUBHE_MAX_PRIORITY];
+
+      public:
+
+        /**
+        @brief constructs the queue with the given ring capacity per priority
+
+        @param capacity the capacity of each ring (must be power of 2)
+        */
+        explicit MPMCQueue(size_t capacity = 1024);
+
+        /**
+        @brief queries if the queue is empty at the time of this call
+        */
+        bool empty() const noexcept;
+
+        /**
+        @brief queries if the queue is empty at a specific priority value
+        */
+        bool empty(unsigned priority) const noexcept;
+
+        /**
+        @brief queries the number of items at the time of this call
+        */
+        size_t size() const noexcept;
+
+        /**
+        @brief queries the number of items with the given priority
+               at the time of this call
+        */
+        size_t size(unsigned priority) const noexcept;
+
+        /**
+        @brief queries the capacity of the lock-free ring of each priority
+        */
+        size_t capacity() const noexcept;
+
+        /**
+        @brief inserts an item to the queue
+
+        @param item the item to push to the queue
+        @param priority priority value of the item to push
+
+        Any thread can insert an item to the queue.
+        */
+        void push(T item, unsigned priority);
+
+        /**
+        @brief tries to insert an item to the lock-free ring of the queue
+
+        @param item the item to push to the queue
+        @param priority priority value of the item to push
+
+        @return @c false if the ring is full or the priority level
+                has spilled to the overflow list
+
+        Any thread can insert an item to the queue.
+        */
+        bool try_push(T item, unsigned priority);
+
+        /**
+        @brief inserts a batch of items with the same priority to the queue
+
+        @param items pointer to the array of items to push to the queue
+        @param n number of items to push
+        @param priority priority value of the items to push
+
+        Any thread can insert items to the queue. Runs of free slots in the
+        ring are claimed with a single compare-and-swap each, and the items
+        that do not fit spill into the overflow list under one lock.
+        */
+        void bulk_push(const T* items, size_t n, unsigned priority);
+
+        /**
+        @brief steals an item from the queue
+
+        Any threads can try to steal an item from the queue.
+        The return can be a @c nullptr if this operation failed
+        (not necessary empty).
+        */
+        T steal();
+
+        /**
+        @brief steals an item with a specific priority value from the queue
+
+        @param priority priority of the item to steal
+
+        Any threads can try to steal an item from the queue.
+        The return can be a @c nullptr if this operation failed
+        (not necessary empty).
+        */
+        T steal(unsigned priority);
+
+      private:
+
+        bool _try_push(T, unsigned);
+        size_t _try_bulk_push(const T*, size_t, unsigned);
+        T _try_pop(unsigned);
+    };
+
+    // Constructor
+    template <typename T, unsigned DUBHE_MAX_PRIORITY>
+    MPMCQueue<T, DUBHE_MAX_PRIORITY>::MPMCQueue(size_t c) : _mask {c-1} {
+      assert(c >= 2 && (!(c & (c-1))));
+      for(unsigned p=0; p<DUBHE_MAX_PRIORITY; p++) {
+        _rings[p].cells.reset(new Cell[c]);
+        for(size_t i=0; i<c; i++) {
+          _rings[p].cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        _rings[p].enqueue_pos.data.store(0, std::memory_order_relaxed);
+        _rings[p].dequeue_pos.data.store(0, std::memory_order_relaxed);
+        _overflows[p].size.data.store(0, std::memory_order_relaxed);
+      }
+    }
+
+    // Function: empty
+    template <typename T, unsigned DUBHE_MAX_PRIORITY>
+    bool MPMCQueue<T, DUBHE_MAX_PRIORITY>::empty() const noexcept {
+      for(unsigned p=0; p<DUBHE_MAX_PRIORITY; p++) {
+        if(!empty(p)) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    // Function: empty
+    // An item whose push has claimed a ring slot but not yet published it
+    // already counts, which is conservative for the 2PC guard of workers.
+    template <typename T, unsigned DUBHE_MAX_PRIORITY>
+    bool MPMCQueue<T, DUBHE_MAX_PRIORITY>::empty(unsigned p) const noexcept {
+      return size(p) == 0;
+    }
+
+    // Function: size
+    template <typename T, unsigned DUBHE_MAX_PRIORITY>
+    size_t MPMCQueue<T, DUBHE_MAX_PRIORITY>::size() const noexcept {
+      size_t s = 0;
+      for(unsigned p=0; p<DUBHE_MAX_PRIORITY; p++) {
+        s += size(p);
+      }
+      return s;
+    }
+
+    // Function: size
+    template <typename T, unsigned DUBHE_MAX_PRIORITY>
+    size_t MPMCQueue<T, DUBHE_MAX_PRIORITY>::size(unsigned p) const noexcept {
+      size_t d = _rings[p].dequeue_pos.data.load(std::memory_order_relaxed);
+      size_t e = _rings[p].enqueue_pos.data.load(std::memory_order_relaxed);
+      size_t o = _overflows[p].size.data.load(std::memory_order_relaxed);
+      return (e > d ? e - d : 0) + o;
+    }
+
+    // Function: capacity
+    template <typename T, unsigned DUBHE_MAX_PRIORITY>
+    size_t MPMCQueue<T, DUBHE_MAX_PRIORITY>::capacity() const noexcept {
+      return _mask + 1;
+    }
+
+    // Function: try_push
+    template <typename T, unsigned DUBHE_MAX_PRIORITY>
+    bool MPMCQueue<T, DUBHE_MAX_PRIORITY>::try_push(T item, unsigned p) {
+      if(_overflows[p].size.data.load(std::memory_order_relaxed) != 0) {
+        return false;
+      }
+      return _try_push(item, p);
+    }
+
+    // Procedure: push
+    template <typename T, unsigned DUBHE_MAX_PRIORITY>
+    void MPMCQueue<T, DUBHE_MAX_PRIORITY>::push(T item, unsigned p) {
+
+      if(try_push(item, p)) {
+        return;
+      }
+
+      auto& o = _overflows[p];
+      std::lock_guard<std::mutex> lock(o.mutex);
+      o.items.push_back(item);
+      o.size.data.fetch_add(1, std::memory_order_release);
+    }
+
+    // Procedure: bulk_push
+    template <typename T, unsigned DUBHE_MAX_PRIORITY>
+    void MPMCQueue<T, DUBHE_MAX_PRIORITY>::bulk_push(const T* items, size_t n, unsigned p) {
+
+      auto& o = _overflows[p];
+
+      if(o.size.data.load(std::memory_order_relaxed) == 0) {
+        while(n) {
+          size_t k = _try_bulk_push(items, n, p);
+          if(k == 0) {
+            break;
+          }
+          items += k;
+          n -= k;
+        }
+      }
+
+      if(n) {
+        std::lock_guard<std::mutex> lock(o.mutex);
+        o.items.insert(o.items.end(), items, items + n);
+        o.size.data.fetch_add(n, std::memory_order_release);
+      }
+    }
+
+    // Function: _try_bulk_push
+    // Claims the longest run (up to n) of free slots starting at the enqueue
+    // position with one compare-and-swap. A slot stays free until its
+    // position is claimed, so the run cannot shrink before the swap.
+    template <typename T, unsigned DUBHE_MAX_PRIORITY>
+    size_t MPMCQueue<T, DUBHE_MAX_PRIORITY>::_try_bulk_push(const T* items, size_t n, unsigned p) {
+
+      auto& r = _rings[p];
+      size_t pos = r.enqueue_pos.data.load(std::memory_order_relaxed);
+
+      while(true) {
+
+        size_t k = 0;
+        for(; k < n && k <= _mask; ++k) {
+          if(r.cells[(pos + k) & _mask].sequence.load(std::memory_order_acquire) != pos + k) {
+            break;
+          }
+        }
+
+        // the ring is full or another producer has moved on
+        if(k == 0) {
+          auto seq = r.cells[pos & _mask].sequence.load(std::memory_order_acquire);
+          if(static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos) < 0) {
+            return 0;
+          }
+          pos = r.enqueue_pos.data.load(std::memory_order_relaxed);
+          continue;
+        }
+
+        if(r.enqueue_pos.data.compare_exchange_weak(pos, pos + k,
+                                                    std::memory_order_relaxed,
+                                                    std::memory_order_relaxed)) {
+          for(size_t i=0; i<k; ++i) {
+            Cell& cell = r.cells[(pos + i) & _mask];
+            cell.data = items[i];
+            cell.sequence.store(pos + i + 1, std::memory_order_release);
+          }
+          return k;
+        }
+      }
+    }
+
+    // Function: _try_push
+    template <typename T, unsigned DUBHE_MAX_PRIORITY>
+    bool MPMCQueue<T, DUBHE_MAX_PRIORITY>::_try_push(T item, unsigned p) {
+
+      auto& r = _rings[p];
+      size_t pos = r.enqueue_pos.data.load(std::memory_order_relaxed);
+
+      while(true) {
+        Cell& cell = r.cells[pos & _mask];
+        size_t seq = cell.sequence.load(std::memory_order_acquire);
+        auto dif = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+        if(dif == 0) {
+          if(r.enqueue_pos.data.compare_exchange_weak(pos, pos + 1,
+                                                      std::memory_order_relaxed,
+                                                      std::memory_order_relaxed)) {
+            cell.data = item;
+            cell.sequence.store(pos + 1, std::memory_order_release);
+            return true;
+          }
+        }
+        // the ring is full
+        else if(dif < 0) {
+          return false;
+        }
+        else {
+          pos = r.enqueue_pos.data.load(std::memory_order_relaxed);
+        }
+      }
+    }
+
+    // Function: _try_pop
+    template <typename T, unsigned DUBHE_MAX_PRIORITY>
+    T MPMCQueue<T, DUBHE_MAX_PRIORITY>::_try_pop(unsigned p) {
+
+      auto& r = _rings[p];
+      size_t pos = r.dequeue_pos.data.load(std::memory_order_relaxed);
+
+      while(true) {
+        Cell& cell = r.cells[pos & _mask];
+        size_t seq = cell.sequence.load(std::memory_order_acquire);
+        auto dif = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+        if(dif == 0) {
+          if(r.dequeue_pos.data.compare_exchange_weak(pos, pos + 1,
+                                                      std::memory_order_relaxed,
+                                                      std::memory_order_relaxed)) {
+            T item = cell.data;
+            cell.sequence.store(pos + _mask + 1, std::memory_order_release);
+            return item;
+          }
+        }
+        // the ring is empty or the next item is not yet published
+        else if(dif < 0) {
+          return nullptr;
+        }
+        else {
+          pos = r.dequeue_pos.data.load(std::memory_order_relaxed);
+        }
+      }
+    }
+
+    // Function: steal
+    template <typename T, unsigned DUBHE_MAX_PRIORITY>
+    T MPMCQueue<T, DUBHE_MAX_PRIORITY>::steal() {
+      for(unsigned p=0; p<DUBHE_MAX_PRIORITY; p++) {
+        if(auto t = steal(p); t) {
+          return t;
+        }
+      }
+      return nullptr;
+    }
+
+    // Function: steal
+    template <typename T, unsigned DUBHE_MAX_PRIORITY>
+    T MPMCQueue<T, DUBHE_MAX_PRIORITY>::steal(unsigned p) {
+
+      if(auto t = _try_pop(p); t) {
+        return t;
+      }
+
+      auto& o = _overflows[p];
+
+      if(o.size.data.load(std::memory_order_acquire) == 0) {
+        return nullptr;
+      }
+
+      std::lock_guard<std::mutex> lock(o.mutex);
+
+      if(o.items.empty()) {
+        return nullptr;
+      }
+
+      T item = o.items.front();
+      o.items.pop_front();
+      o.size.data.fetch_sub(1, std::memory_order_release);
+
+      return item;
+    }
+
+}  // namespace dubhe
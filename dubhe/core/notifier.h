@@ -28,6 +28,7 @@
 #include <deque>
 #include <mutex>
 #include <condition_variable>
+#include <chrono>
 #include <thread>
 #include <algorithm>
 #include <numeric>
@@ -184,14 +185,50 @@ namespace dubhe {
         }
       }
 
-      // notify wakes one or all waiting threads.
+      // sleep_until blocks the calling thread outside the waiter stack until
+      // the given time or the next notification that finds no waiter to
+      // take it, whichever comes first.
+      // The predicate is the wait predicate re-checked after the thread has
+      // announced its sleep, such that a notification cannot get lost.
+      template <typename P>
+      void sleep_until(std::chrono::steady_clock::time_point tp, P&& predicate) {
+        std::unique_lock<std::mutex> lock(_sleep_mutex);
+        _num_sleepers.fetch_add(1, std::memory_order_relaxed);
+        _sleep_pending.store(false, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if(!predicate()) {
+          auto epoch = _sleep_epoch;
+          _sleep_cv.wait_until(lock, tp, [&](){ return _sleep_epoch != epoch; });
+        }
+        _num_sleepers.fetch_sub(1, std::memory_order_relaxed);
+      }
+
+      // wake_sleepers wakes all sleeping threads, for a change of the wait
+      // predicate that only sleeping threads care about.
+      void wake_sleepers() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if(_num_sleepers.load(std::memory_order_relaxed) != 0) {
+          _wake_sleepers();
+        }
+      }
+
+      // notify wakes one or all waiting threads. Sleeping threads are woken
+      // by notify(true) and by a notify(false) that finds no waiter, at most
+      // once until one of them sleeps again, such that a notification costs
+      // no lock while the sleepers are awake or parked threads can take it.
       // Must be called after changing the associated wait predicate.
       void notify(bool all) {
         std::atomic_thread_fence(std::memory_order_seq_cst);
+        if(all) {
+          _wake_sleepers_once();
+        }
         uint64_t state = _state.load(std::memory_order_acquire);
         for (;;) {
           // Easy case: no waiters.
           if ((state & kStackMask) == kStackMask && (state & kWaiterMask) == 0) {
+            if(!all) {
+              _wake_sleepers_once();
+            }
             return;
           }
           uint64_t waiters = (state & kWaiterMask) >> kWaiterShift;
@@ -267,6 +304,27 @@ namespace dubhe {
       std::atomic<uint64_t> _state;
       std::vector<Waiter> _waiters;
 
+      std::atomic<size_t> _num_sleepers {0};
+      std::atomic<bool> _sleep_pending {false};
+      std::mutex _sleep_mutex;
+      std::condition_variable _sleep_cv;
+      uint64_t _sleep_epoch {0};
+
+      void _wake_sleepers() {
+        {
+          std::scoped_lock<std::mutex> lock(_sleep_mutex);
+          ++_sleep_epoch;
+        }
+        _sleep_cv.notify_all();
+      }
+
+      void _wake_sleepers_once() {
+        if(_num_sleepers.load(std::memory_order_relaxed) != 0 &&
+           !_sleep_pending.exchange(true, std::memory_order_relaxed)) {
+          _wake_sleepers();
+        }
+      }
+
       void _park(Waiter* w) {
     #ifdef __cpp_lib_atomic_wait
         unsigned target = Waiter::kNotSignaled;
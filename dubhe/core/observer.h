@@ -211,6 +211,23 @@ namespace dubhe {
       @param task_view a constant wrapper object to the task
       */
       virtual void on_exit(WorkerView wv, TaskView task_view) = 0;
+
+      /**
+      @brief method to call after a worker thread completed a task past
+             its deadline
+      @param wv an immutable view of this worker thread
+      @param task_view a constant wrapper object to the task
+      @param deadline the deadline of the task (of its own or of its run)
+
+      The default implementation does nothing.
+      */
+      virtual void on_deadline_miss(
+        WorkerView wv, TaskView task_view, std::chrono::steady_clock::time_point deadline
+      ) {
+        (void)wv;
+        (void)task_view;
+        (void)deadline;
+      }
     };
 
     // ----------------------------------------------------------------------------
@@ -534,6 +551,17 @@ namespace dubhe {
         */
         size_t num_workers() const;
 
+        /**
+        @brief queries the mean duration of the observed tasks by name
+
+        Tasks without a name are left out, and tasks of the same name are
+        averaged over all their observed runs. The result can be passed to
+        dubhe::Taskflow::prioritize to assign priorities from measured
+        costs. Querying the durations while the executor runs tasks results
+        in undefined behavior.
+        */
+        std::unordered_map<std::string, std::chrono::nanoseconds> durations() const;
+
       private:
 
         Timeline _timeline;
@@ -936,6 +964,33 @@ namespace dubhe {
       return w;
     }
 
+    // Function: durations
+    inline std::unordered_map<std::string, std::chrono::nanoseconds>
+    TFProfObserver::durations() const {
+
+      std::unordered_map<std::string, std::pair<std::chrono::nanoseconds, size_t>> sums;
+
+      for(size_t w=0; w<_timeline.segments.size(); ++w) {
+        for(size_t l=0; l<_timeline.segments[w].size(); ++l) {
+          for(const auto& s : _timeline.segments[w][l]) {
+            if(s.name.empty()) {
+              continue;
+            }
+            auto& [total, count] = sums[s.name];
+            total += std::chrono::duration_cast<std::chrono::nanoseconds>(s.span());
+            ++count;
+          }
+        }
+      }
+
+      std::unordered_map<std::string, std::chrono::nanoseconds> means;
+      means.reserve(sums.size());
+      for(const auto& [name, sum] : sums) {
+        means.emplace(name, sum.first / sum.second);
+      }
+      return means;
+    }
+
 
     // ----------------------------------------------------------------------------
     // TFProfManager
@@ -0,0 +1,314 @@
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+
+#pragma once
+
+#include <dubhe/core/executor.h>
+
+/**
+@file overlapped_run.h
+@brief overlapped runs include file
+*/
+
+namespace dubhe {
+
+    // ----------------------------------------------------------------------------
+    // OverlappedRun
+    // ----------------------------------------------------------------------------
+
+    /**
+    @private
+
+    @brief class to create the state of dubhe::Executor::run_n_overlapped
+
+    A task of iteration @c j runs after its dependents of iteration @c j,
+    after itself of iteration <tt>j-1</tt>, and after the tasks of
+    iteration <tt>j-1</tt> linked to it by dubhe::Task::precede_next.
+    Every (task, iteration) pair runs as an asynchronous task of the
+    executor, so the tasks keep no per-run state in their nodes and
+    several iterations can be in flight at once.
+
+    Each task counts the arrived dependencies of an iteration in one of
+    <tt>K+1</tt> slots. A task of iteration @c j only starts once all
+    iterations before <tt>j-K</tt> have finished, such that the dependencies
+    in flight span at most <tt>K+1</tt> iterations and a slot is reset when
+    its task starts, long before the iteration that reuses it.
+    */
+    class OverlappedRun : public std::enable_shared_from_this<OverlappedRun> {
+
+      friend class Executor;
+
+      public:
+
+        OverlappedRun(Executor&, Taskflow&, size_t, size_t);
+
+      private:
+
+        Executor& _executor;
+
+        const size_t _N;
+        const size_t _K;
+
+        std::vector<Node*> _nodes;
+
+        // successors in the same iteration and in the next iteration
+        std::vector<size_t> _succ_offsets;
+        std::vector<size_t> _succ;
+        std::vector<size_t> _next_offsets;
+        std::vector<size_t> _next;
+
+        // dependencies to wait for in the first and in later iterations
+        std::vector<size_t> _first;
+        std::vector<size_t> _later;
+
+        std::unique_ptr<std::atomic<size_t>[]> _arrived;
+        std::unique_ptr<std::atomic<size_t>[]> _remaining;
+
+        std::mutex _mutex;
+        std::atomic<size_t> _num_done {0};
+        std::vector<std::pair<size_t, size_t>> _deferred;
+
+        std::atomic<bool> _failed {false};
+        std::exception_ptr _exception;
+
+        std::promise<void> _promise;
+        Continuations _continuations;
+
+        void _start();
+        void _arrive(size_t, size_t);
+        void _submit(size_t, size_t);
+        void _spawn(size_t, size_t);
+        void _run(Runtime&, size_t, size_t);
+        void _complete();
+    };
+
+    // constructor
+    inline OverlappedRun::OverlappedRun(Executor& executor, Taskflow& taskflow, size_t N, size_t K) :
+      _executor {executor},
+      _N        {N},
+      _K        {std::max(K, size_t{1})} {
+
+      auto& nodes = taskflow._graph._nodes;
+
+      std::unordered_map<Node*, size_t> ids;
+      for(auto node : nodes) {
+        switch(node->_handle.index()) {
+          case Node::PLACEHOLDER:
+          case Node::STATIC:
+          break;
+
+          default:
+            DUBHE_THROW("overlapped runs support only static tasks");
+        }
+        ids.emplace(node, _nodes.size());
+        _nodes.push_back(node);
+      }
+
+      auto n = _nodes.size();
+
+      _first.assign(n, 0);
+      _later.assign(n, 0);
+      _succ_offsets.reserve(n + 1);
+      _next_offsets.reserve(n + 1);
+
+      for(size_t v=0; v<n; ++v) {
+
+        _succ_offsets.push_back(_succ.size());
+        for(auto s : _nodes[v]->_successors) {
+          auto id = ids.at(s);
+          _succ.push_back(id);
+          _first[id]++;
+          _later[id]++;
+        }
+
+        // a task always waits for itself of the previous iteration
+        _next_offsets.push_back(_next.size());
+        _next.push_back(v);
+        _later[v]++;
+        if(auto meta = _nodes[v]->_meta.get(); meta) {
+          for(auto s : meta->next_successors) {
+            if(auto itr = ids.find(s); itr != ids.end() && itr->second != v) {
+              _next.push_back(itr->second);
+              _later[itr->second]++;
+            }
+          }
+        }
+      }
+      _succ_offsets.push_back(_succ.size());
+      _next_offsets.push_back(_next.size());
+
+      _arrived = std::make_unique<std::atomic<size_t>[]>((_K + 1) * n);
+      _remaining = std::make_unique<std::atomic<size_t>[]>(_K + 1);
+      for(size_t k=0; k<=_K; ++k) {
+        _remaining[k].store(n, std::memory_order_relaxed);
+      }
+    }
+
+    // Procedure: _start
+    inline void OverlappedRun::_start() {
+      for(size_t v=0; v<_nodes.size(); ++v) {
+        if(_first[v] == 0) {
+          _spawn(v, 0);
+        }
+      }
+    }
+
+    // Procedure: _arrive
+    // one dependency of task v in iteration j has finished
+    inline void OverlappedRun::_arrive(size_t v, size_t j) {
+      auto& arrived = _arrived[(j % (_K + 1)) * _nodes.size() + v];
+      auto need = j ? _later[v] : _first[v];
+      if(arrived.fetch_add(1, std::memory_order_acq_rel) + 1 == need) {
+        arrived.store(0, std::memory_order_relaxed);
+        _submit(v, j);
+      }
+    }
+
+    // Procedure: _submit
+    // starts task v of iteration j or defers it until it is in the window
+    inline void OverlappedRun::_submit(size_t v, size_t j) {
+      if(j >= _num_done.load(std::memory_order_acquire) + _K) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if(j >= _num_done.load(std::memory_order_relaxed) + _K) {
+          _deferred.emplace_back(v, j);
+          return;
+        }
+      }
+      _spawn(v, j);
+    }
+
+    // Procedure: _spawn
+    inline void OverlappedRun::_spawn(size_t v, size_t j) {
+      _executor._increment_topology();
+      _executor._num_pending.fetch_add(1, std::memory_order_relaxed);
+      auto node = node_pool.animate(
+        DefaultTaskParams{}, nullptr, nullptr, 0,
+        // handle
+        std::in_place_type_t<Node::Async>{},
+        [self=shared_from_this(), v, j](Runtime& rt){ self->_run(rt, v, j); }
+      );
+      node->_priority = _nodes[v]->_priority;
+      _executor._schedule_async_task(node);
+    }
+
+    // Procedure: _run
+    inline void OverlappedRun::_run(Runtime& rt, size_t v, size_t j) {
+
+      // after a failure, the remaining tasks only pass on their dependencies
+      if(!_failed.load(std::memory_order_relaxed)) {
+        try {
+          if(auto handle = std::get_if<Node::Static>(&_nodes[v]->_handle); handle) {
+            switch(handle->work.index()) {
+              case 0:
+                std::get_if<0>(&handle->work)->operator()();
+              break;
+
+              case 1:
+                std::get_if<1>(&handle->work)->operator()(rt);
+              break;
+            }
+          }
+        }
+        catch(...) {
+          std::lock_guard<std::mutex> lock(_mutex);
+          if(!_failed.exchange(true, std::memory_order_relaxed)) {
+            _exception = std::current_exception();
+          }
+        }
+      }
+
+      // the iteration is accounted before any successor can run, such that
+      // iterations finish in order
+      if(_remaining[j % (_K + 1)].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        _complete();
+      }
+
+      for(size_t i=_succ_offsets[v]; i<_succ_offsets[v+1]; ++i) {
+        _arrive(_succ[i], j);
+      }
+
+      if(j + 1 < _N) {
+        for(size_t i=_next_offsets[v]; i<_next_offsets[v+1]; ++i) {
+          _arrive(_next[i], j + 1);
+        }
+      }
+    }
+
+    // Procedure: _complete
+    // one more iteration has finished, whose slot serves the iteration K+1
+    // later from now on
+    inline void OverlappedRun::_complete() {
+
+      std::vector<std::pair<size_t, size_t>> ready;
+      size_t num_done;
+
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        num_done = _num_done.load(std::memory_order_relaxed) + 1;
+        _remaining[(num_done - 1) % (_K + 1)].store(_nodes.size(), std::memory_order_relaxed);
+        _num_done.store(num_done, std::memory_order_release);
+        auto mid = std::partition(_deferred.begin(), _deferred.end(), [&](auto& d){
+          return d.second >= num_done + _K;
+        });
+        ready.assign(mid, _deferred.end());
+        _deferred.erase(mid, _deferred.end());
+      }
+
+      for(auto [v, j] : ready) {
+        _spawn(v, j);
+      }
+
+      if(num_done == _N) {
+        if(_exception) {
+          _promise.set_exception(_exception);
+        }
+        else {
+          _promise.set_value();
+        }
+        _continuations._complete();
+        _executor._decrement_topology();
+      }
+    }
+
+    // ----------------------------------------------------------------------------
+    // Executor
+    // ----------------------------------------------------------------------------
+
+    // Function: run_n_overlapped
+    inline dubhe::Future<void> Executor::run_n_overlapped(Taskflow& f, size_t N, size_t K) {
+
+      if(N == 0 || f.empty()) {
+        std::promise<void> promise;
+        promise.set_value();
+        return dubhe::Future<void>(promise.get_future(), this);
+      }
+
+      auto run = std::make_shared<OverlappedRun>(*this, f, N, K);
+
+      dubhe::Future<void> future(
+        run->_promise.get_future(), this,
+        std::shared_ptr<Continuations>(run, &run->_continuations)
+      );
+
+      _increment_topology();
+      run->_start();
+
+      return future;
+    }
+
+}  // end of namespace dubhe -----------------------------------------------------
@@ -85,6 +85,7 @@ namespace dubhe {
     class Semaphore {
 
       friend class Node;
+      friend class CoroutinePromiseBase;
 
       public:
 
@@ -113,6 +114,8 @@ namespace dubhe {
 
         std::vector<Node*> _waiters;
 
+        bool _try_acquire();
+
         bool _try_acquire_or_wait(Node*);
 
         std::vector<Node*> _release();
@@ -122,6 +125,15 @@ namespace dubhe {
       _counter(max_workers) {
     }
 
+    inline bool Semaphore::_try_acquire() {
+      std::lock_guard<std::mutex> lock(_mtx);
+      if(_counter > 0) {
+        --_counter;
+        return true;
+      }
+      return false;
+    }
+
     inline bool Semaphore::_try_acquire_or_wait(Node* me) {
       std::lock_guard<std::mutex> lock(_mtx);
       if(_counter > 0) {
@@ -284,6 +284,24 @@ namespace dubhe {
         template <typename... Ts>
         Task& succeed(Ts&&... tasks);
 
+        /**
+        @brief adds precedence links from this task to other tasks of the
+               next iteration
+
+        @tparam Ts parameter pack
+
+        @param tasks one or multiple tasks
+
+        @return @c *this
+
+        The links only apply to dubhe::Executor::run_n_overlapped, where
+        each of the given tasks of iteration <tt>j+1</tt> runs after this
+        task of iteration @c j. Every other run finishes an iteration before
+        it starts the next one and thereby satisfies the links already.
+        */
+        template <typename... Ts>
+        Task& precede_next(Ts&&... tasks);
+
         /**
         @brief makes the task release this semaphore
         */
@@ -328,10 +346,10 @@ namespace dubhe {
         /**
         @brief assigns a priority value to the task
 
-        A priority value can be one of the following three levels,
-        dubhe::TaskPriority::HIGH (numerically equivalent to 0),
-        dubhe::TaskPriority::NORMAL (numerically equivalent to 1), and
-        dubhe::TaskPriority::LOW (numerically equivalent to 2).
+        A priority value is in the range <tt>[0, 256)</tt> with three named
+        levels, dubhe::TaskPriority::HIGH (numerically equivalent to 0),
+        dubhe::TaskPriority::NORMAL (numerically equivalent to 128), and
+        dubhe::TaskPriority::LOW (numerically equivalent to 255).
         The smaller the priority value, the higher the priority.
         */
         Task& priority(TaskPriority p);
@@ -341,6 +359,109 @@ namespace dubhe {
         */
         TaskPriority priority() const;
 
+        /**
+        @brief assigns a cost hint to the task
+
+        The hint estimates the running time of the task in a unit of the
+        application's choice, such as nanoseconds, and is used by
+        dubhe::Taskflow::prioritize to find the critical path of the graph.
+        A task without a hint costs 1.
+
+        @return @c *this
+        */
+        Task& cost(uint64_t cost);
+
+        /**
+        @brief queries the cost hint of the task
+        */
+        uint64_t cost() const;
+
+        /**
+        @brief hints the worker that should run the task
+
+        A ready task with a hint is put into the mailbox of the hinted
+        worker instead of the queue of the worker that readied it, such that
+        tasks touching the same data can be kept on the same worker and
+        find the data in its caches. The hint is not binding: the hinted
+        worker serves its mailbox before its own queue, and an idle worker
+        takes tasks from the mailboxes of other workers when it finds
+        nothing else to do. A hint beyond the number of workers, or to a
+        worker removed by dubhe::Executor::remove_workers, is ignored.
+
+        @code{.cpp}
+        for(size_t i=0; i<executor.num_workers(); ++i) {
+          taskflow.emplace([&, i](){ update(partition[i]); }).affinity(i);
+        }
+        @endcode
+
+        @return @c *this
+        */
+        Task& affinity(size_t worker_id);
+
+        /**
+        @brief queries the worker hinted by dubhe::Task::affinity
+
+        The return is empty if the task has no hint.
+        */
+        std::optional<size_t> affinity() const;
+
+        /**
+        @brief removes the worker hint of the task
+
+        @return @c *this
+        */
+        Task& reset_affinity();
+
+        /**
+        @brief assigns an absolute deadline to the task
+
+        Ready tasks with a deadline are kept in an earliest-deadline-first
+        queue of the worker group they are scheduled from, which the workers
+        of the group serve before their own queues and before stealing. A
+        ready successor with a deadline always goes through this queue
+        rather than running right away on the worker of its predecessor. A
+        task without its own deadline inherits the deadline of
+        the run, if any (see dubhe::Executor::run). When a task completes
+        after its deadline, the executor reports the miss to
+        dubhe::ObserverInterface::on_deadline_miss.
+
+        @code{.cpp}
+        task.deadline(std::chrono::steady_clock::now() + std::chrono::milliseconds(5));
+        @endcode
+        */
+        Task& deadline(std::chrono::steady_clock::time_point deadline);
+
+        /**
+        @brief queries the deadline of the task
+
+        The return is <tt>std::chrono::steady_clock::time_point::max()</tt>
+        if the task has no deadline.
+        */
+        std::chrono::steady_clock::time_point deadline() const;
+
+        /**
+        @brief assigns the task to a tenant
+
+        A task of a tenant shares the workers with the tasks of other
+        tenants in proportion to the tenant weights, and its execution time
+        is accounted to the tenant (see dubhe::Tenant). A task without its
+        own tenant inherits the tenant of the run, if any
+        (see dubhe::Executor::run).
+
+        @code{.cpp}
+        dubhe::Tenant tenant(2);
+        task.tenant(tenant);
+        @endcode
+        */
+        Task& tenant(Tenant& tenant);
+
+        /**
+        @brief queries the tenant of the task
+
+        The return is @c nullptr if the task has no tenant of its own.
+        */
+        Tenant* tenant() const;
+
         /**
         @brief resets the task handle to null
         */
@@ -417,6 +538,14 @@ namespace dubhe {
       return *this;
     }
 
+    // Function: precede_next
+    template <typename... Ts>
+    Task& Task::precede_next(Ts&&... tasks) {
+      auto& next = _node->_meta_data().next_successors;
+      (next.push_back(tasks._node), ...);
+      return *this;
+    }
+
     // Function: succeed
     template <typename... Ts>
     Task& Task::succeed(Ts&&... tasks) {
@@ -456,26 +585,19 @@ namespace dubhe {
 
     // Function: name
     inline Task& Task::name(const std::string& name) {
-      _node->_name = name;
+      _node->_meta_data().name = name;
       return *this;
     }
 
     // Function: acquire
     inline Task& Task::acquire(Semaphore& s) {
-      if(!_node->_semaphores) {
-        _node->_semaphores = std::make_unique<Node::Semaphores>();
-      }
-      _node->_semaphores->to_acquire.push_back(&s);
+      _node->_meta_data().semaphores.to_acquire.push_back(&s);
       return *this;
     }
 
     // Function: release
     inline Task& Task::release(Semaphore& s) {
-      if(!_node->_semaphores) {
-        //_node->_semaphores.emplace();
-        _node->_semaphores = std::make_unique<Node::Semaphores>();
-      }
-      _node->_semaphores->to_release.push_back(&s);
+      _node->_meta_data().semaphores.to_release.push_back(&s);
       return *this;
     }
 
@@ -491,7 +613,7 @@ namespace dubhe {
 
     // Function: name
     inline const std::string& Task::name() const {
-      return _node->_name;
+      return _node->name();
     }
 
     // Function: num_dependents
@@ -592,12 +714,12 @@ namespace dubhe {
 
     // Function: data
     inline void* Task::data() const {
-      return _node->_data;
+      return _node->_meta ? _node->_meta->data : nullptr;
     }
 
     // Function: data
     inline Task& Task::data(void* data) {
-      _node->_data = data;
+      _node->_meta_data().data = data;
       return *this;
     }
 
@@ -612,6 +734,60 @@ namespace dubhe {
       return static_cast<TaskPriority>(_node->_priority);
     }
 
+    // Function: cost
+    inline Task& Task::cost(uint64_t cost) {
+      _node->_meta_data().cost = cost;
+      return *this;
+    }
+
+    // Function: cost
+    inline uint64_t Task::cost() const {
+      return _node->_cost();
+    }
+
+    // Function: affinity
+    inline Task& Task::affinity(size_t worker_id) {
+      _node->_affinity = worker_id < Node::NO_AFFINITY ?
+                         static_cast<unsigned>(worker_id) : Node::NO_AFFINITY;
+      return *this;
+    }
+
+    // Function: affinity
+    inline std::optional<size_t> Task::affinity() const {
+      if(_node->_affinity == Node::NO_AFFINITY) {
+        return std::nullopt;
+      }
+      return _node->_affinity;
+    }
+
+    // Function: reset_affinity
+    inline Task& Task::reset_affinity() {
+      _node->_affinity = Node::NO_AFFINITY;
+      return *this;
+    }
+
+    // Function: deadline
+    inline Task& Task::deadline(std::chrono::steady_clock::time_point d) {
+      _node->_deadline = d;
+      return *this;
+    }
+
+    // Function: deadline
+    inline std::chrono::steady_clock::time_point Task::deadline() const {
+      return _node->_deadline;
+    }
+
+    // Function: tenant
+    inline Task& Task::tenant(Tenant& tenant) {
+      _node->_tenant = &tenant;
+      return *this;
+    }
+
+    // Function: tenant
+    inline Tenant* Task::tenant() const {
+      return _node->_tenant;
+    }
+
     // ----------------------------------------------------------------------------
     // global ostream
     // ----------------------------------------------------------------------------
@@ -700,7 +876,7 @@ namespace dubhe {
 
     // Function: name
     inline const std::string& TaskView::name() const {
-      return _node._name;
+      return _node.name();
     }
 
     // Function: num_dependents
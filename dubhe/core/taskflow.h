@@ -18,6 +18,7 @@
 #pragma once
 
 #include <dubhe/core/flow_builder.h>
+#include <dubhe/core/observer.h>
 
 /**
 @file taskflow/core/taskflow.hpp
@@ -86,6 +87,7 @@ namespace dubhe {
       friend class Topology;
       friend class Executor;
       friend class FlowBuilder;
+      friend class OverlappedRun;
 
       struct Dumper {
         size_t id;
@@ -289,6 +291,145 @@ namespace dubhe {
         */
         inline void remove_dependency(Task from, Task to);
 
+        /**
+        @brief freezes the taskflow for repeated execution
+
+        Every run of a taskflow first visits the dependents of each task
+        to find the source tasks and the initial join counters.
+        Freezing the taskflow computes them once and keeps them in flat
+        arrays, such that setting up a run is a single pass over the tasks
+        that resets their counters. This pays off for large taskflows run
+        many times.
+
+        @code{.cpp}
+        build_graph(taskflow);
+        taskflow.freeze();
+        for(int i=0; i<1000; i++) {
+          executor.run(taskflow).wait();
+        }
+        @endcode
+
+        Adding, erasing or clearing tasks thaws the taskflow. So do a
+        dependency added through dubhe::Task and a task turned into or from
+        a condition task through dubhe::Task::work, which the next run
+        detects.
+        Freezing a running taskflow results in undefined behavior.
+        */
+        void freeze();
+
+        /**
+        @brief thaws a frozen taskflow
+
+        A thawed taskflow sets up every run from its graph again.
+        */
+        void thaw();
+
+        /**
+        @brief queries if the taskflow is frozen
+        */
+        bool frozen() const;
+
+        /**
+        @brief fuses the linear chains of static tasks to cut scheduling
+               overhead
+
+        A chain is a sequence of static tasks in which every task but the
+        last has a single successor and every task but the first has a
+        single dependent. The executor runs a fused chain as one task:
+        the first task runs the others in order on the same worker and
+        then releases the successors of the last task. This saves the join
+        counter update and the queue operations of every link.
+
+        @code{.cpp}
+        auto [A, B, C, D] = taskflow.emplace(fa, fb, fc, fd);
+        A.precede(B);
+        B.precede(C);
+        A.precede(D);
+        taskflow.fuse();  // B and C run as one task
+        @endcode
+
+        Tasks with semaphores, tasks that take a dubhe::Runtime, and
+        non-static tasks are never fused, and neither are two tasks with
+        different tenants or deadlines. Every fused task keeps its name
+        and is still reported to the observers on its own, while the
+        priority of a chain is the priority of its first task.
+        The graph itself is left unchanged, such that dubhe::Task handles
+        and dumps refer to the original tasks.
+
+        Erasing or clearing tasks unfuses the taskflow. A dependency added
+        through dubhe::Task after fusion ends a chain at the link it
+        breaks, and the tasks after that link run on their own until the
+        taskflow is fused again.
+        Fusing a running taskflow results in undefined behavior.
+
+        @return the number of tasks fused into the chain of another task
+        */
+        size_t fuse();
+
+        /**
+        @brief unfuses the chains of the taskflow
+
+        An unfused taskflow runs every task on its own again.
+        */
+        void unfuse();
+
+        /**
+        @brief assigns priorities to the tasks by their upward rank
+
+        The upward rank of a task is its cost plus the largest upward rank
+        of its successors, that is, the cost of the longest path from the
+        task to the end of the graph. The tasks of the critical path have
+        the largest ranks, and running them first shortens the makespan
+        of graphs where a long dependency chain competes with many short
+        tasks off the chain, as in HEFT list scheduling.
+
+        Ranks are mapped linearly onto the priority values, where the
+        length of the critical path maps to dubhe::TaskPriority::HIGH and
+        a rank of zero maps to dubhe::TaskPriority::LOW. Costs come from
+        dubhe::Task::cost, so without hints the rank of a task is the
+        number of tasks on the longest path it starts.
+
+        @code{.cpp}
+        auto [A, B, C, D] = taskflow.emplace(fa, fb, fc, fd);
+        A.precede(B);
+        B.precede(C);
+        B.cost(10);
+        taskflow.prioritize();  // A, B and C are served before D
+        for(int i=0; i<1000; i++) {
+          executor.run(taskflow).wait();
+        }
+        @endcode
+
+        The priorities stay with the tasks, so the pass is needed once
+        for a taskflow that is run many times and again after its graph
+        or cost hints change. It overwrites the priorities assigned by
+        hand. Edges that close a cycle, such as the back edges of condition
+        tasks, are not followed, and modules and subflows count as single
+        tasks. Prioritizing a running taskflow results in undefined
+        behavior.
+
+        @return the cost of the critical path
+        */
+        uint64_t prioritize();
+
+        /**
+        @brief assigns priorities to the tasks by their upward rank using
+               measured durations
+
+        A task whose name appears in dubhe::TFProfObserver::durations costs
+        its mean measured duration in nanoseconds, and any other task costs
+        its hint, which should then be given in nanoseconds too.
+
+        @code{.cpp}
+        auto observer = executor.make_observer<dubhe::TFProfObserver>();
+        executor.run(taskflow).wait();
+        taskflow.prioritize(*observer);
+        @endcode
+
+        @return the cost of the critical path in nanoseconds
+        */
+        uint64_t prioritize(const TFProfObserver& observer);
+
         /**
         @brief returns a reference to the underlying graph object
 
@@ -312,6 +453,9 @@ namespace dubhe {
         void _dump(std::ostream&, const Graph*) const;
         void _dump(std::ostream&, const Node*, Dumper&) const;
         void _dump(std::ostream&, const Graph*, Dumper&) const;
+
+        template <typename C>
+        uint64_t _prioritize(C&&);
     };
 
     // Constructor
@@ -401,6 +545,126 @@ namespace dubhe {
           return i == from._node;
         }
       ), to._node->_dependents.end());
+
+      thaw();
+      unfuse();
+    }
+
+    // Procedure: freeze
+    inline void Taskflow::freeze() {
+      _graph._freeze();
+    }
+
+    // Procedure: thaw
+    inline void Taskflow::thaw() {
+      _graph._frozen.reset();
+    }
+
+    // Function: frozen
+    inline bool Taskflow::frozen() const {
+      return _graph._frozen != nullptr;
+    }
+
+    // Function: fuse
+    inline size_t Taskflow::fuse() {
+      return _graph._fuse();
+    }
+
+    // Procedure: unfuse
+    inline void Taskflow::unfuse() {
+      _graph._unfuse();
+    }
+
+    // Function: prioritize
+    inline uint64_t Taskflow::prioritize() {
+      return _prioritize([](Node* node){ return node->_cost(); });
+    }
+
+    // Function: prioritize
+    inline uint64_t Taskflow::prioritize(const TFProfObserver& observer) {
+      auto durations = observer.durations();
+      return _prioritize([&](Node* node){
+        if(auto itr = durations.find(node->name()); itr != durations.end()) {
+          return static_cast<uint64_t>(itr->second.count());
+        }
+        return node->_cost();
+      });
+    }
+
+    // Function: _prioritize
+    // computes the upward ranks by an iterative depth-first search, such
+    // that deep chains do not overflow the stack, and ignores the edges
+    // to tasks still on the search path
+    template <typename C>
+    uint64_t Taskflow::_prioritize(C&& cost) {
+
+      enum : uint8_t { UNVISITED, ON_PATH, RANKED };
+
+      const auto& nodes = _graph._nodes;
+      const size_t n = nodes.size();
+
+      std::unordered_map<Node*, size_t> index;
+      index.reserve(n);
+      for(size_t i=0; i<n; ++i) {
+        index.emplace(nodes[i], i);
+      }
+
+      std::vector<uint64_t> rank(n, 0);
+      std::vector<uint8_t> mark(n, UNVISITED);
+      std::vector<std::pair<size_t, size_t>> path;
+
+      for(size_t root=0; root<n; ++root) {
+
+        if(mark[root] != UNVISITED) {
+          continue;
+        }
+
+        mark[root] = ON_PATH;
+        path.emplace_back(root, 0);
+
+        while(!path.empty()) {
+
+          auto [v, k] = path.back();
+          auto node = nodes[v];
+
+          // descend into the next successor not visited yet
+          if(k < node->_successors.size()) {
+            path.back().second++;
+            if(auto itr = index.find(node->_successors[k]); itr != index.end() &&
+               mark[itr->second] == UNVISITED) {
+              mark[itr->second] = ON_PATH;
+              path.emplace_back(itr->second, 0);
+            }
+            continue;
+          }
+
+          uint64_t r = 0;
+          for(auto succ : node->_successors) {
+            if(auto itr = index.find(succ); itr != index.end() &&
+               mark[itr->second] == RANKED) {
+              r = std::max(r, rank[itr->second]);
+            }
+          }
+          rank[v] = r + cost(node);
+          mark[v] = RANKED;
+          path.pop_back();
+        }
+      }
+
+      uint64_t critical = 0;
+      for(auto r : rank) {
+        critical = std::max(critical, r);
+      }
+
+      constexpr auto LOW = static_cast<unsigned>(TaskPriority::LOW);
+
+      for(size_t i=0; i<n; ++i) {
+        nodes[i]->_priority = critical == 0 ? 0 : static_cast<unsigned>(
+          static_cast<long double>(critical - rank[i]) * LOW / critical
+        );
+      }
+
+      return critical;
     }
 
     // Procedure: dump
@@ -457,8 +721,8 @@ namespace dubhe {
     ) const {
 
       os << 'p' << node << "[label=\"";
-      if(node->_name.empty()) os << 'p' << node;
-      else os << node->_name;
+      if(node->name().empty()) os << 'p' << node;
+      else os << node->name();
       os << "\" ";
 
       // shape for node
@@ -499,8 +763,8 @@ namespace dubhe {
           auto& sbg = std::get_if<Node::Subflow>(&node->_handle)->subgraph;
           if(!sbg.empty()) {
             os << "subgraph cluster_p" << node << " {\nlabel=\"Subflow: ";
-            if(node->_name.empty()) os << 'p' << node;
-            else os << node->_name;
+            if(node->name().empty()) os << 'p' << node;
+            else os << node->name();
 
             os << "\";\n" << "color=blue\n";
             _dump(os, &sbg, dumper);
@@ -531,8 +795,8 @@ namespace dubhe {
           auto module = &(std::get_if<Node::Module>(&n->_handle)->graph);
 
           os << 'p' << n << "[shape=box3d, color=blue, label=\"";
-          if(n->_name.empty()) os << 'p' << n;
-          else os << n->_name;
+          if(n->name().empty()) os << 'p' << n;
+          else os << n->name();
 
           if(dumper.visited.find(module) == dumper.visited.end()) {
             dumper.visited[module] = dumper.id++;
@@ -584,6 +848,17 @@ namespace dubhe {
     // wait until the cancellation finishes
     fu.get();
     @endcode
+
+    A future of dubhe::Executor::run or dubhe::Executor::async can also be
+    continued without blocking any thread: dubhe::Future::then runs a
+    function on the result once it is ready, and dubhe::when_all and
+    dubhe::when_any combine several futures into one.
+
+    @code{.cpp}
+    auto fu = executor.async([](){ return 1; })
+                      .then([](int v){ return v + 1; })
+                      .then([](int v){ std::cout << v; });  // prints 2
+    @endcode
     */
     template <typename T>
     class Future : public std::future<T>  {
@@ -591,6 +866,16 @@ namespace dubhe {
       friend class Executor;
       friend class Subflow;
       friend class Runtime;
+      friend class CoroutinePromiseBase;
+
+      template <typename U>
+      friend class Future;
+
+      template <typename I>
+      friend auto when_all(I, I);
+
+      template <typename I>
+      friend auto when_any(I, I);
 
       public:
 
@@ -633,17 +918,68 @@ namespace dubhe {
         */
         bool cancel();
 
+        /**
+        @brief schedules the given function to run on the result of this
+               future once the result is ready
+
+        @tparam F callable type
+
+        @param func callable object that takes the result of this future,
+                    or no argument if the result is @c void
+
+        @return a dubhe::Future that will hold the result of the function
+
+        The function runs as an asynchronous task of the executor that
+        produces this future, with no thread blocked on the result
+        in the meantime. If the result is an exception, the function does
+        not run and the returned future holds the exception.
+        The call consumes this future, which becomes invalid.
+
+        @code{.cpp}
+        executor.run(taskflow).then([](){ std::cout << "done\n"; });
+        @endcode
+        */
+        template <typename F>
+        auto then(F&& func);
+
       private:
 
         std::weak_ptr<Topology> _topology;
+        std::weak_ptr<Continuations> _continuations;
+
+        Executor* _executor {nullptr};
+
+        Future(
+          std::future<T>&&,
+          Executor*,
+          std::weak_ptr<Continuations> = std::weak_ptr<Continuations>(),
+          std::weak_ptr<Topology> = std::weak_ptr<Topology>()
+        );
 
-        Future(std::future<T>&&, std::weak_ptr<Topology> = std::weak_ptr<Topology>());
+        void _on_ready(std::function<void()>);
     };
 
     template <typename T>
-    Future<T>::Future(std::future<T>&& f, std::weak_ptr<Topology> p) :
-      std::future<T> {std::move(f)},
-      _topology      {std::move(p)} {
+    Future<T>::Future(
+      std::future<T>&& f, Executor* e, std::weak_ptr<Continuations> c, std::weak_ptr<Topology> p
+    ) :
+      std::future<T>  {std::move(f)},
+      _topology       {std::move(p)},
+      _continuations  {std::move(c)},
+      _executor       {e} {
+    }
+
+    // Procedure: _on_ready
+    // runs the callback once the result is ready, or right away if it is
+    // ready already or the future has no producer to wait for
+    template <typename T>
+    void Future<T>::_on_ready(std::function<void()> callback) {
+      if(auto c = _continuations.lock(); c) {
+        c->_add(std::move(callback));
+      }
+      else {
+        callback();
+      }
     }
 
     // Function: cancel
@@ -656,5 +992,83 @@ namespace dubhe {
       return false;
     }
 
+    // ----------------------------------------------------------------------------
+    // Future Combinators
+    // ----------------------------------------------------------------------------
+
+    /**
+    @struct WhenAnyResult
+
+    @brief structure to hold the result of dubhe::when_any
+
+    @tparam Sequence type of the sequence of futures
+    */
+    template <typename Sequence>
+    struct WhenAnyResult {
+
+      /**
+      @brief index of the first future that became ready, or
+             <tt>size_t(-1)</tt> if the sequence is empty
+      */
+      size_t index;
+
+      /**
+      @brief the futures passed to dubhe::when_any
+      */
+      Sequence futures;
+    };
+
+    /**
+    @brief creates a future that becomes ready when all the given futures
+           are ready
+
+    @tparam I iterator type of dubhe::Future objects
+
+    @param first iterator to the first future
+    @param last iterator past the last future
+
+    @return a dubhe::Future of a @c std::vector that holds the given futures,
+            all of which are ready
+
+    The futures are moved out of the range. The combined future is
+    completed by the executor of the given futures, with no thread blocked
+    on them; an empty range gives a future that is ready right away.
+
+    @code{.cpp}
+    std::vector<dubhe::Future<int>> futures;
+    for(int i=0; i<10; i++) {
+      futures.push_back(executor.async([i](){ return i; }));
+    }
+    dubhe::when_all(futures.begin(), futures.end()).then([](auto futures){
+      int sum = 0;
+      for(auto& fu : futures) {
+        sum += fu.get();
+      }
+      return sum;
+    });
+    @endcode
+    */
+    template <typename I>
+    auto when_all(I first, I last);
+
+    /**
+    @brief creates a future that becomes ready when any of the given futures
+           is ready
+
+    @tparam I iterator type of dubhe::Future objects
+
+    @param first iterator to the first future
+    @param last iterator past the last future
+
+    @return a dubhe::Future of a dubhe::WhenAnyResult that holds the given
+            futures and the index of the first one that became ready
+
+    The futures are moved out of the range. The combined future is
+    completed by the executor of the given futures, with no thread blocked
+    on them; an empty range gives a future that is ready right away.
+    */
+    template <typename I>
+    auto when_any(I first, I last);
+
 
 }  // namespace dubhe
@@ -0,0 +1,230 @@
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include <dubhe/core/declarations.h>
+#include <dubhe/core/error.h>
+
+/**
+@file tenant.h
+@brief tenant include file
+*/
+
+namespace dubhe {
+
+    // ----------------------------------------------------------------------------
+    // Tenant
+    // ----------------------------------------------------------------------------
+
+    /**
+    @class Tenant
+
+    @brief class to create a scheduling group that shares the workers of an
+           executor with other groups in proportion to its weight
+
+    Without tenants, all runs of an executor compete for the workers in the
+    same task queues, such that one large taskflow can hold up every other
+    run. The ready tasks of a tenant instead enter the task queues only up
+    to the share of the tenant, a few tasks per worker split among the
+    tenants by weight, and the tasks beyond are held back in a queue of the
+    tenant. Whenever a tenant task finishes, the workers let in the next
+    held task of the tenant with the least worker time consumed per unit of
+    weight. A tenant of weight 2 thereby receives about twice the worker
+    time of a tenant of weight 1 while both have tasks ready.
+
+    A task belongs to a tenant through dubhe::Task::tenant,
+    dubhe::TaskParams::tenant, or by running its taskflow with
+    dubhe::Executor::run(Taskflow&, Tenant&) and
+    dubhe::Executor::run_n(Taskflow&, size_t, Tenant&).
+    Admitted tenant tasks are scheduled and stolen like tasks without a
+    tenant, which therefore keep their own share of the workers.
+
+    @code{.cpp}
+    dubhe::Executor executor(8);
+
+    dubhe::Tenant gold(3);     // three shares of the workers
+    dubhe::Tenant bronze(1);   // one share of the workers
+
+    auto f1 = executor.run(taskflow1, gold);
+    auto f2 = executor.run(taskflow2, bronze);
+    f1.wait();
+    f2.wait();
+
+    std::cout << gold.busy_time().count() << "ns for "
+              << gold.num_tasks() << " tasks\n";
+    @endcode
+
+    A tenant keeps the accounting of all its tasks, which lets an application
+    enforce quotas, for instance by lowering the weight of a tenant that has
+    used up its budget. A tenant can be shared by several executors and must
+    outlive all runs and asynchronous tasks that use it.
+    */
+    class Tenant {
+
+      friend class Executor;
+
+      public:
+
+        /**
+        @brief constructs a tenant with the given weight
+
+        @param weight positive share of the workers
+        */
+        explicit Tenant(size_t weight = 1);
+
+        /**
+        @brief disabled copy constructor
+        */
+        Tenant(const Tenant&) = delete;
+
+        /**
+        @brief disabled copy assignment
+        */
+        Tenant& operator = (const Tenant&) = delete;
+
+        /**
+        @brief queries the weight of the tenant
+        */
+        size_t weight() const;
+
+        /**
+        @brief changes the weight of the tenant
+
+        The new weight applies to the worker time consumed from now on and
+        can be changed while the tenant has tasks running.
+
+        @param weight positive share of the workers
+        */
+        void weight(size_t weight);
+
+        /**
+        @brief queries the number of tasks of the tenant that have finished
+        */
+        size_t num_tasks() const;
+
+        /**
+        @brief queries the worker time consumed by the finished tasks of
+               the tenant
+        */
+        std::chrono::nanoseconds busy_time() const;
+
+        /**
+        @brief queries the bound of pending tasks of the tenant
+        */
+        size_t max_pending() const;
+
+        /**
+        @brief bounds the pending tasks of the tenant
+
+        Submissions of the tenant beyond the bound are handled like
+        submissions beyond the bound of the executor
+        (see dubhe::BackpressurePolicy). A value of zero leaves the tenant
+        unbounded.
+
+        @param max_pending maximum number of pending tasks
+        */
+        void max_pending(size_t max_pending);
+
+        /**
+        @brief queries the number of pending tasks of the tenant
+        */
+        size_t num_pending() const;
+
+      private:
+
+        std::atomic<size_t> _weight;
+
+        // worker time per unit of weight in 1/16 nanoseconds
+        std::atomic<uint64_t> _vtime {0};
+
+        std::atomic<size_t> _num_tasks {0};
+        std::atomic<int64_t> _busy_time {0};
+
+        std::atomic<size_t> _max_pending {0};
+        std::atomic<size_t> _num_pending {0};
+
+        std::atomic<size_t> _num_admitted {0};
+
+        void _charge(std::chrono::nanoseconds);
+    };
+
+    // constructor
+    inline Tenant::Tenant(size_t weight) : _weight {weight} {
+      if(weight == 0) {
+        DUBHE_THROW("tenant weight must be positive");
+      }
+    }
+
+    // Function: weight
+    inline size_t Tenant::weight() const {
+      return _weight.load(std::memory_order_relaxed);
+    }
+
+    // Procedure: weight
+    inline void Tenant::weight(size_t weight) {
+      if(weight == 0) {
+        DUBHE_THROW("tenant weight must be positive");
+      }
+      _weight.store(weight, std::memory_order_relaxed);
+    }
+
+    // Function: num_tasks
+    inline size_t Tenant::num_tasks() const {
+      return _num_tasks.load(std::memory_order_relaxed);
+    }
+
+    // Function: busy_time
+    inline std::chrono::nanoseconds Tenant::busy_time() const {
+      return std::chrono::nanoseconds(_busy_time.load(std::memory_order_relaxed));
+    }
+
+    // Function: max_pending
+    inline size_t Tenant::max_pending() const {
+      return _max_pending.load(std::memory_order_relaxed);
+    }
+
+    // Procedure: max_pending
+    inline void Tenant::max_pending(size_t max_pending) {
+      _max_pending.store(max_pending, std::memory_order_relaxed);
+    }
+
+    // Function: num_pending
+    inline size_t Tenant::num_pending() const {
+      return _num_pending.load(std::memory_order_relaxed);
+    }
+
+    // Procedure: _charge
+    // accounts one finished task; every task advances the virtual time by
+    // at least one tick such that a stream of very short tasks is still
+    // seen as work
+    inline void Tenant::_charge(std::chrono::nanoseconds elapsed) {
+      auto ns = static_cast<uint64_t>(std::max<int64_t>(elapsed.count(), 0));
+      _busy_time.fetch_add(static_cast<int64_t>(ns), std::memory_order_relaxed);
+      _num_tasks.fetch_add(1, std::memory_order_relaxed);
+      _vtime.fetch_add(
+        std::max<uint64_t>(ns * 16 / _weight.load(std::memory_order_relaxed), 1),
+        std::memory_order_relaxed
+      );
+    }
+
+}  // namespace dubhe
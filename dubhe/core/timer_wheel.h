@@ -0,0 +1,366 @@
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <dubhe/core/declarations.h>
+
+// number of tasks a busy worker runs between two looks at the clock for
+// due timers
+#ifndef DUBHE_TIMER_POLL_INTERVAL
+#define DUBHE_TIMER_POLL_INTERVAL 32
+#endif
+
+/**
+@file timer_wheel.h
+@brief hierarchical timer wheel include file
+*/
+
+namespace dubhe {
+
+    // ----------------------------------------------------------------------------
+    // Timer
+    // ----------------------------------------------------------------------------
+
+    /**
+    @class Timer
+
+    @brief class to create a handle to a periodic task of an executor
+
+    A dubhe::Timer is returned by dubhe::Executor::schedule_every and lets
+    the application stop the periodic task. Copies of a timer refer to the
+    same periodic task.
+
+    @code{.cpp}
+    dubhe::Timer timer = executor.schedule_every(std::chrono::milliseconds(10), [](){
+      std::cout << "tick\n";
+    });
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+    timer.cancel();
+    @endcode
+    */
+    class Timer {
+
+      friend class Executor;
+
+      public:
+
+        /**
+        @brief constructs an empty timer handle
+        */
+        Timer() = default;
+
+        /**
+        @brief stops the periodic task from running again
+
+        A run of the task that has already started completes normally.
+        Cancelling an empty or cancelled timer has no effect.
+        */
+        void cancel() {
+          if(_state) {
+            _state->cancelled.store(true, std::memory_order_relaxed);
+          }
+        }
+
+        /**
+        @brief queries if the timer has been cancelled
+        */
+        bool cancelled() const {
+          return _state && _state->cancelled.load(std::memory_order_relaxed);
+        }
+
+        /**
+        @brief queries if the handle refers to no periodic task
+        */
+        bool empty() const {
+          return _state == nullptr;
+        }
+
+      private:
+
+        struct State {
+          std::function<void()> work;
+          std::chrono::nanoseconds period;
+          std::chrono::steady_clock::time_point next;
+          std::atomic<bool> cancelled {false};
+        };
+
+        explicit Timer(std::shared_ptr<State> state) : _state {std::move(state)} {
+        }
+
+        std::shared_ptr<State> _state;
+    };
+
+    // ----------------------------------------------------------------------------
+    // TimerWheel
+    // ----------------------------------------------------------------------------
+
+    /**
+    @class TimerWheel
+
+    @tparam T type of the timer payload
+
+    @brief class to create a hierarchical timer wheel (not thread-safe)
+
+    The wheel divides time into ticks of a fixed resolution and keeps four
+    levels of 64 slots each, where a slot of level @c l spans
+    <tt>64^l</tt> ticks. A timer is inserted in the lowest level whose span
+    covers its due tick and moves down a level every time the wheel reaches
+    the beginning of its slot, such that inserting a timer and expiring a
+    timer both take constant time. Timers further away than the top level
+    covers are parked in the top level and cascade until they are in reach.
+
+    Advancing the wheel skips the ticks over empty levels, so a wheel that
+    holds a single timer hours away is advanced in a few steps.
+    */
+    template <typename T>
+    class TimerWheel {
+
+      static constexpr size_t BITS   = 6;
+      static constexpr size_t SLOTS  = size_t{1} << BITS;
+      static constexpr size_t MASK   = SLOTS - 1;
+      static constexpr size_t LEVELS = 4;
+
+      public:
+
+        /**
+        @brief constructs a timer wheel of the given tick resolution that
+               starts at the current time
+        */
+        explicit TimerWheel(std::chrono::nanoseconds resolution) :
+          _resolution {std::max(resolution, std::chrono::nanoseconds(1))},
+          _origin     {std::chrono::steady_clock::now()} {
+        }
+
+        /**
+        @brief queries the number of timers in the wheel
+        */
+        size_t size() const { return _size; }
+
+        /**
+        @brief queries if the wheel has no timers
+        */
+        bool empty() const { return _size == 0; }
+
+        /**
+        @brief inserts a timer due at the given time
+
+        @return @c false if the timer is due already, in which case the
+                wheel does not keep it
+        */
+        bool insert(std::chrono::steady_clock::time_point tp, T item) {
+          auto due = _to_tick(tp, true);
+          if(due <= _now) {
+            return false;
+          }
+          _place(due, std::move(item));
+          ++_size;
+          return true;
+        }
+
+        /**
+        @brief advances the wheel to the given time and appends the payloads
+               of all timers due by then to @c expired
+        */
+        void advance(std::chrono::steady_clock::time_point tp, std::vector<T>& expired) {
+
+          auto target = _to_tick(tp, false);
+
+          while(_now < target) {
+
+            // the lowest non-empty level decides how far we can skip
+            size_t l = 0;
+            while(l < LEVELS && _num[l] == 0) {
+              ++l;
+            }
+
+            if(l == LEVELS) {
+              _now = target;
+              break;
+            }
+
+            // jump to the last tick before the next boundary of level l,
+            // where nothing happens in the lower, empty levels
+            if(l > 0) {
+              uint64_t last = _now | ((uint64_t{1} << (BITS*l)) - 1);
+              if(last >= target) {
+                _now = target;
+                break;
+              }
+              _now = last;
+            }
+
+            ++_now;
+
+            // cascade the slots whose span begins at this tick
+            for(size_t k=LEVELS-1; k>0; --k) {
+              if((_now & ((uint64_t{1} << (BITS*k)) - 1)) == 0) {
+                auto& slot = _slots[k][(_now >> (BITS*k)) & MASK];
+                if(slot.empty()) {
+                  continue;
+                }
+                _num[k] -= slot.size();
+                auto items = std::move(slot);
+                slot.clear();
+                for(auto& [due, item] : items) {
+                  if(due <= _now) {
+                    expired.push_back(std::move(item));
+                    --_size;
+                  }
+                  else {
+                    _place(due, std::move(item));
+                  }
+                }
+              }
+            }
+
+            auto& slot = _slots[0][_now & MASK];
+            _num[0] -= slot.size();
+            _size -= slot.size();
+            for(auto& [due, item] : slot) {
+              expired.push_back(std::move(item));
+            }
+            slot.clear();
+          }
+        }
+
+        /**
+        @brief removes all timers from the wheel and appends their payloads
+               to @c items
+        */
+        void drain(std::vector<T>& items) {
+          for(auto& level : _slots) {
+            for(auto& slot : level) {
+              for(auto& [due, item] : slot) {
+                items.push_back(std::move(item));
+              }
+              slot.clear();
+            }
+          }
+          _num = {};
+          _size = 0;
+        }
+
+        /**
+        @brief removes the timers whose payloads satisfy a predicate from
+               the wheel and appends their payloads to @c items
+        */
+        template <typename P>
+        void drain_if(P&& pred, std::vector<T>& items) {
+          for(size_t l=0; l<LEVELS; ++l) {
+            for(auto& slot : _slots[l]) {
+              auto it = std::remove_if(slot.begin(), slot.end(), [&](auto& entry){
+                if(!pred(entry.second)) {
+                  return false;
+                }
+                items.push_back(std::move(entry.second));
+                return true;
+              });
+              auto n = static_cast<size_t>(slot.end() - it);
+              slot.erase(it, slot.end());
+              _num[l] -= n;
+              _size -= n;
+            }
+          }
+        }
+
+        /**
+        @brief queries the time by which the wheel must be advanced next
+
+        The result is the due time of the earliest timer if it sits in the
+        lowest level, or otherwise the next time a slot cascades down.
+        The result is <tt>std::chrono::steady_clock::time_point::max()</tt>
+        if the wheel is empty.
+        */
+        std::chrono::steady_clock::time_point next_due() const {
+
+          uint64_t next = UINT64_MAX;
+
+          if(_num[0]) {
+            for(uint64_t t=_now+1; t<=_now+SLOTS; ++t) {
+              if(!_slots[0][t & MASK].empty()) {
+                next = t;
+                break;
+              }
+            }
+          }
+
+          // a higher level may cascade a timer due before the earliest one
+          // of the lowest level
+          for(size_t l=1; l<LEVELS; ++l) {
+            if(_num[l]) {
+              next = std::min(next, (_now | ((uint64_t{1} << (BITS*l)) - 1)) + 1);
+              break;
+            }
+          }
+
+          return next == UINT64_MAX ? std::chrono::steady_clock::time_point::max() :
+                                      _to_time(next);
+        }
+
+      private:
+
+        const std::chrono::nanoseconds _resolution;
+        const std::chrono::steady_clock::time_point _origin;
+
+        uint64_t _now {0};
+        size_t _size {0};
+
+        std::array<size_t, LEVELS> _num {};
+        std::array<std::array<std::vector<std::pair<uint64_t, T>>, SLOTS>, LEVELS> _slots;
+
+        // Function: _to_tick
+        // converts a time to a tick, rounding up for due times such that
+        // a timer never fires early
+        uint64_t _to_tick(std::chrono::steady_clock::time_point tp, bool ceil) const {
+          if(tp <= _origin) {
+            return 0;
+          }
+          auto ns = (tp - _origin).count();
+          auto r  = _resolution.count();
+          return static_cast<uint64_t>(ceil ? (ns + r - 1) / r : ns / r);
+        }
+
+        std::chrono::steady_clock::time_point _to_time(uint64_t tick) const {
+          return _origin + _resolution * static_cast<int64_t>(tick);
+        }
+
+        // Procedure: _place
+        // puts a timer due after the current tick into the lowest level
+        // whose span covers the distance, or the top level if none does
+        void _place(uint64_t due, T&& item) {
+          auto delta = due - _now;
+          size_t l = 0;
+          while(l < LEVELS - 1 && delta >= (uint64_t{1} << (BITS*(l+1)))) {
+            ++l;
+          }
+          _slots[l][(due >> (BITS*l)) & MASK].emplace_back(due, std::move(item));
+          ++_num[l];
+        }
+    };
+
+}  // namespace dubhe
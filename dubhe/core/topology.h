@@ -19,6 +19,64 @@
 
 namespace dubhe {
 
+    // ----------------------------------------------------------------------------
+    // Continuations
+    // ----------------------------------------------------------------------------
+
+    // class: Continuations
+    // keeps the callbacks to run once the result of a future is ready; a
+    // callback added after that runs right away
+    class Continuations {
+
+      friend class Executor;
+      friend class Topology;
+      friend class CoroutinePromiseBase;
+      friend class OverlappedRun;
+
+      template <typename T>
+      friend class Future;
+
+      template <typename I>
+      friend auto when_all(I, I);
+
+      template <typename I>
+      friend auto when_any(I, I);
+
+      private:
+
+        std::mutex _mutex;
+        bool _ready {false};
+        std::vector<std::function<void()>> _callbacks;
+
+        void _add(std::function<void()>);
+        void _complete();
+    };
+
+    // Procedure: _add
+    inline void Continuations::_add(std::function<void()> callback) {
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if(!_ready) {
+          _callbacks.push_back(std::move(callback));
+          return;
+        }
+      }
+      callback();
+    }
+
+    // Procedure: _complete
+    inline void Continuations::_complete() {
+      std::vector<std::function<void()>> callbacks;
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _ready = true;
+        callbacks.swap(_callbacks);
+      }
+      for(auto& callback : callbacks) {
+        callback();
+      }
+    }
+
     // ----------------------------------------------------------------------------
 
     class TopologyBase {
@@ -50,7 +108,9 @@ namespace dubhe {
 
         Taskflow& _taskflow;
 
-        std::promise<void> _promise;
+        // a run of a light future completes its state instead of a promise
+        std::optional<std::promise<void>> _promise;
+        LightState<void>* _light {nullptr};
 
         SmallVector<Node*> _sources;
 
@@ -60,8 +120,14 @@ namespace dubhe {
         std::atomic<size_t> _join_counter {0};
         std::atomic<int> _state {CLEAN};
 
+        std::chrono::steady_clock::time_point _deadline {std::chrono::steady_clock::time_point::max()};
+
+        Tenant* _tenant {nullptr};
+
         std::exception_ptr _exception_ptr {nullptr};
 
+        Continuations _continuations;
+
         void _carry_out_promise();
     };
 
@@ -75,14 +141,26 @@ namespace dubhe {
 
     // Procedure
     inline void Topology::_carry_out_promise() {
+      if(_light) {
+        auto light = std::exchange(_light, nullptr);
+        if(_exception_ptr) {
+          light->_set_exception(std::exchange(_exception_ptr, nullptr));
+        }
+        else {
+          light->_set_value();
+        }
+        light->_release();
+        return;
+      }
       if(_exception_ptr) {
         auto e = _exception_ptr;
         _exception_ptr = nullptr;
-        _promise.set_exception(e);
+        _promise->set_exception(e);
       }
       else {
-        _promise.set_value();
+        _promise->set_value();
       }
+      _continuations._complete();
     }
 
     // Function: cancelled
@@ -21,6 +21,11 @@
 #include <dubhe/utility/macros.h>
 #include <dubhe/utility/traits.h>
 
+// number of priority buckets of the scheduler queues
+#ifndef DUBHE_NUM_PRIORITY_BUCKETS
+#define DUBHE_NUM_PRIORITY_BUCKETS 8
+#endif
+
 /**
 @file tsq.hpp
 @brief task queue include file
@@ -38,23 +43,37 @@ namespace dubhe {
 
     @brief enumeration of all task priority values
 
-    A priority is an enumerated value of type @c unsigned.
-    Currently, %Taskflow defines three priority levels,
-    @c HIGH, @c NORMAL, and @c LOW, starting from 0, 1, to 2.
+    A priority is a numeric value of type @c unsigned in the range
+    <tt>[0, 256)</tt>, of which %Taskflow names three levels,
+    @c HIGH, @c NORMAL, and @c LOW, at 0, 128, and 255.
     That is, the lower the value, the higher the priority.
+    Any other value in the range can be given by a cast,
+    e.g., <tt>static_cast<dubhe::TaskPriority>(64)</tt>.
 
+    The scheduler queues tasks in @c DUBHE_NUM_PRIORITY_BUCKETS buckets
+    (8 by default) that split the range evenly (see dubhe::priority_bucket).
+    Tasks in the same bucket are not ordered by their priority values.
     */
     enum class TaskPriority : unsigned {
       /** @brief value of the highest priority (i.e., 0)  */
       HIGH = 0,
-      /** @brief value of the normal priority (i.e., 1)  */
-      NORMAL = 1,
-      /** @brief value of the lowest priority (i.e., 2) */
-      LOW = 2,
+      /** @brief value of the normal priority (i.e., 128)  */
+      NORMAL = 128,
+      /** @brief value of the lowest priority (i.e., 255) */
+      LOW = 255,
       /** @brief conventional value for iterating priority values */
-      MAX = 3
+      MAX = 256
     };
 
+    // Function: priority_bucket
+    // maps a priority value to its bucket in the scheduler queues, where
+    // values beyond the range fall into the lowest-priority bucket
+    constexpr unsigned priority_bucket(unsigned priority) noexcept {
+      constexpr unsigned MAX = static_cast<unsigned>(TaskPriority::MAX);
+      return priority < MAX ? priority * DUBHE_NUM_PRIORITY_BUCKETS / MAX :
+                              DUBHE_NUM_PRIORITY_BUCKETS - 1;
+    }
+
 
 
     // ----------------------------------------------------------------------------
@@ -81,8 +100,9 @@ namespace dubhe {
     All operations are associated with priority values to indicate
     the corresponding queues to which an operation is applied.
 
-    The default template value, `DUBHE_MAX_PRIORITY`, is `TaskPriority::MAX`
-    which applies only three priority levels to the task queue.
+    The default template value, `DUBHE_MAX_PRIORITY`, is
+    `DUBHE_NUM_PRIORITY_BUCKETS`, where the executor maps the priority value
+    of a task to a level by dubhe::priority_bucket.
 
     @code{.cpp}
     auto [A, B, C, D, E] = taskflow.emplace(
@@ -124,7 +144,7 @@ namespace dubhe {
     @endcode
 
     */
-    template <typename T, unsigned DUBHE_MAX_PRIORITY = static_cast<unsigned>(TaskPriority::MAX)>
+    template <typename T, unsigned DUBHE_MAX_PRIORITY = DUBHE_NUM_PRIORITY_BUCKETS>
     class TaskQueue {
 
       static_assert(DUBHE_MAX_PRIORITY > 0, "DUBHE_MAX_PRIORITY must be at least one");
@@ -158,8 +178,8 @@ namespace dubhe {
           return S[i & M].load(std::memory_order_relaxed);
         }
 
-        Array* resize(int64_t b, int64_t t) {
-          Array* ptr = new Array {2*C};
+        Array* resize(int64_t b, int64_t t, int64_t c) {
+          Array* ptr = new Array {c};
           for(int64_t i=t; i!=b; ++i) {
             ptr->push(i, pop(i));
           }
@@ -173,7 +193,11 @@ namespace dubhe {
       CachelineAligned<std::atomic<int64_t>> _top[DUBHE_MAX_PRIORITY];
       CachelineAligned<std::atomic<int64_t>> _bottom[DUBHE_MAX_PRIORITY];
       std::atomic<Array*> _array[DUBHE_MAX_PRIORITY];
-      std::vector<Array*> _garbage[DUBHE_MAX_PRIORITY];
+
+      // retired arrays of all priority levels in the order of retirement
+      std::vector<Array*> _garbage;
+
+      const int64_t _min_capacity;
 
       //std::atomic<T> _cache {nullptr};
 
@@ -234,6 +258,19 @@ namespace dubhe {
         */
         DUBHE_FORCE_INLINE void push(T item, unsigned priority);
 
+        /**
+        @brief inserts a batch of items with the same priority to the queue
+
+        @param items pointer to the array of items to push to the queue
+        @param n number of items to push
+        @param priority priority value of the items to push
+
+        Only the owner thread can insert items to the queue.
+        The items become visible to thieves all at once with a single
+        update of the bottom index.
+        */
+        void bulk_push(const T* items, size_t n, unsigned priority);
+
         /**
         @brief pops out an item from the queue
 
@@ -270,29 +307,83 @@ namespace dubhe {
         */
         T steal(unsigned priority);
 
+        /**
+        @brief steals up to half of the items from the queue into another queue
+
+        @param thief the queue owned by the caller thread to receive the items
+
+        The items are taken from the first non-empty priority level, oldest
+        first. The oldest item is returned and the rest are pushed to @c thief
+        with the same priority, such that the owner of @c thief can run them
+        without stealing again. The return can be a @c nullptr if this
+        operation failed (not necessary empty).
+        */
+        T steal_half(TaskQueue& thief);
+
+        /**
+        @brief steals up to half of the items with a specific priority value
+               from the queue into another queue
+
+        @param thief the queue owned by the caller thread to receive the items
+        @param priority priority of the items to steal
+
+        Any threads can try to steal items from the queue, but only the owner
+        of @c thief can pass it to this function.
+        The return can be a @c nullptr if this operation failed (not necessary empty).
+        */
+        T steal_half(TaskQueue& thief, unsigned priority);
+
+        /**
+        @brief shrinks the capacity of the queue to fit its items
+
+        Only the owner thread can shrink the queue. Every priority level whose
+        items occupy at most a quarter of its capacity is moved to a smaller
+        array, but never below the capacity given at construction.
+        Like the arrays retired by growths, the arrays retired by this call
+        are kept until reclaim is called or the queue is destroyed.
+        */
+        void shrink();
+
+        /**
+        @brief queries the number of arrays retired so far and not yet freed
+
+        Only the owner thread can call this function.
+        */
+        size_t num_retired() const noexcept;
+
+        /**
+        @brief frees the first @c n retired arrays in the order of retirement
+
+        Only the owner thread can reclaim arrays. Thieves do not announce
+        themselves when they read an array, so the caller must make sure
+        that no thief still reads any of the @c n arrays, i.e., every thief
+        has started its last steal after the @c n arrays were retired.
+        */
+        void reclaim(size_t n);
+
       private:
         DUBHE_NO_INLINE Array* resize_array(Array* a, unsigned p, std::int64_t b, std::int64_t t);
     };
 
     // Constructor
     template <typename T, unsigned DUBHE_MAX_PRIORITY>
-    TaskQueue<T, DUBHE_MAX_PRIORITY>::TaskQueue(int64_t c) {
+    TaskQueue<T, DUBHE_MAX_PRIORITY>::TaskQueue(int64_t c) : _min_capacity {c} {
       assert(c && (!(c & (c-1))));
       unroll<0, DUBHE_MAX_PRIORITY, 1>([&](auto p){
         _top[p].data.store(0, std::memory_order_relaxed);
         _bottom[p].data.store(0, std::memory_order_relaxed);
         _array[p].store(new Array{c}, std::memory_order_relaxed);
-        _garbage[p].reserve(32);
       });
+      _garbage.reserve(32);
     }
 
     // Destructor
     template <typename T, unsigned DUBHE_MAX_PRIORITY>
     TaskQueue<T, DUBHE_MAX_PRIORITY>::~TaskQueue() {
+      for(auto a : _garbage) {
+        delete a;
+      }
       unroll<0, DUBHE_MAX_PRIORITY, 1>([&](auto p){
-        for(auto a : _garbage[p]) {
-          delete a;
-        }
         delete _array[p].load();
       });
     }
@@ -350,6 +441,30 @@ namespace dubhe {
       _bottom[p].data.store(b + 1, std::memory_order_relaxed);
     }
 
+    // Function: bulk_push
+    template <typename T, unsigned DUBHE_MAX_PRIORITY>
+    void TaskQueue<T, DUBHE_MAX_PRIORITY>::bulk_push(const T* items, size_t n, unsigned p) {
+
+      if(n == 0) {
+        return;
+      }
+
+      int64_t b = _bottom[p].data.load(std::memory_order_relaxed);
+      int64_t t = _top[p].data.load(std::memory_order_acquire);
+      Array* a = _array[p].load(std::memory_order_relaxed);
+
+      // make room for all items
+      while(a->capacity() < (b - t) + static_cast<int64_t>(n)) {
+        a = resize_array(a, p, b, t);
+      }
+
+      for(size_t i=0; i<n; ++i) {
+        a->push(b + static_cast<int64_t>(i), items[i]);
+      }
+      std::atomic_thread_fence(std::memory_order_release);
+      _bottom[p].data.store(b + static_cast<int64_t>(n), std::memory_order_relaxed);
+    }
+
     // Function: pop
     template <typename T, unsigned DUBHE_MAX_PRIORITY>
     T TaskQueue<T, DUBHE_MAX_PRIORITY>::pop() {
@@ -426,6 +541,67 @@ namespace dubhe {
       return item;
     }
 
+    // Function: steal_half
+    template <typename T, unsigned DUBHE_MAX_PRIORITY>
+    T TaskQueue<T, DUBHE_MAX_PRIORITY>::steal_half(TaskQueue& thief) {
+      for(unsigned i=0; i<DUBHE_MAX_PRIORITY; i++) {
+        if(auto t = steal_half(thief, i); t) {
+          return t;
+        }
+      }
+      return nullptr;
+    }
+
+    // Function: steal_half
+    // Every item is claimed by its own CAS on the top index. Claiming a run
+    // of items with one CAS is unsafe here because the owner pops from the
+    // bottom without a CAS unless a single item is left, and may therefore
+    // take items the thief has claimed. The thief stops at the first failed
+    // CAS, leaving the contended items to the owner and the other thieves.
+    template <typename T, unsigned DUBHE_MAX_PRIORITY>
+    T TaskQueue<T, DUBHE_MAX_PRIORITY>::steal_half(TaskQueue& thief, unsigned p) {
+
+      assert(&thief != this);
+
+      int64_t t = _top[p].data.load(std::memory_order_acquire);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      int64_t b = _bottom[p].data.load(std::memory_order_acquire);
+
+      if(t >= b) {
+        return nullptr;
+      }
+
+      T item {nullptr};
+
+      // round up such that a single item can be stolen
+      for(int64_t n = (b - t + 1) >> 1; n > 0; --n) {
+
+        Array* a = _array[p].load(std::memory_order_consume);
+        T o = a->pop(t);
+        if(!_top[p].data.compare_exchange_strong(t, t+1,
+                                                 std::memory_order_seq_cst,
+                                                 std::memory_order_relaxed)) {
+          break;
+        }
+
+        if(item == nullptr) {
+          item = o;
+        }
+        else {
+          thief.push(o, p);
+        }
+
+        // re-check the bottom since the owner may have popped meanwhile
+        ++t;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if(t >= _bottom[p].data.load(std::memory_order_acquire)) {
+          break;
+        }
+      }
+
+      return item;
+    }
+
     // Function: capacity
     template <typename T, unsigned DUBHE_MAX_PRIORITY>
     int64_t TaskQueue<T, DUBHE_MAX_PRIORITY>::capacity() const noexcept {
@@ -446,8 +622,8 @@ namespace dubhe {
     DUBHE_NO_INLINE typename TaskQueue<T, DUBHE_MAX_PRIORITY>::Array*
       TaskQueue<T, DUBHE_MAX_PRIORITY>::resize_array(Array* a, unsigned p, std::int64_t b, std::int64_t t) {
 
-      Array* tmp = a->resize(b, t);
-      _garbage[p].push_back(a);
+      Array* tmp = a->resize(b, t, 2*a->capacity());
+      _garbage.push_back(a);
       std::swap(a, tmp);
       _array[p].store(a, std::memory_order_release);
       // Note: the original paper using relaxed causes t-san to complain
@@ -455,5 +631,42 @@ namespace dubhe {
       return a;
     }
 
+    // Procedure: shrink
+    template <typename T, unsigned DUBHE_MAX_PRIORITY>
+    void TaskQueue<T, DUBHE_MAX_PRIORITY>::shrink() {
+      unroll<0, DUBHE_MAX_PRIORITY, 1>([&](auto p){
+
+        int64_t b = _bottom[p].data.load(std::memory_order_relaxed);
+        int64_t t = _top[p].data.load(std::memory_order_acquire);
+        Array* a = _array[p].load(std::memory_order_relaxed);
+
+        // leave a quarter of slack to avoid resizing back and forth
+        int64_t c = a->capacity();
+        while(c > _min_capacity && (b - t) <= (c >> 2)) {
+          c >>= 1;
+        }
+
+        if(c < a->capacity()) {
+          _garbage.push_back(a);
+          _array[p].store(a->resize(b, t, c), std::memory_order_release);
+        }
+      });
+    }
+
+    // Function: num_retired
+    template <typename T, unsigned DUBHE_MAX_PRIORITY>
+    size_t TaskQueue<T, DUBHE_MAX_PRIORITY>::num_retired() const noexcept {
+      return _garbage.size();
+    }
+
+    // Procedure: reclaim
+    template <typename T, unsigned DUBHE_MAX_PRIORITY>
+    void TaskQueue<T, DUBHE_MAX_PRIORITY>::reclaim(size_t n) {
+      n = std::min(n, _garbage.size());
+      for(size_t i=0; i<n; i++) {
+        delete _garbage[i];
+      }
+      _garbage.erase(_garbage.begin(), _garbage.begin() + n);
+    }
 
 }  // namespace dubhe
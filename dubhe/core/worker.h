@@ -17,7 +17,9 @@
 #pragma once
 
 #include <dubhe/core/declarations.h>
+#include <dubhe/core/graph.h>
 #include <dubhe/core/tsq.h>
+#include <dubhe/core/mpmc.h>
 #include <dubhe/core/notifier.h>
 
 /**
@@ -45,6 +47,7 @@ namespace dubhe {
 
       friend class Executor;
       friend class WorkerView;
+      friend class Runtime;
 
       public:
 
@@ -52,8 +55,8 @@ namespace dubhe {
         @brief queries the worker id associated with its parent executor
 
         A worker id is a unsigned integer in the range <tt>[0, N)</tt>,
-        where @c N is the number of workers spawned at the construction
-        time of the executor.
+        where @c N is the number of worker slots of the executor
+        (see dubhe::Executor::max_num_workers).
         */
         inline size_t id() const { return _id; }
 
@@ -73,16 +76,103 @@ namespace dubhe {
         */
         inline size_t queue_capacity() const { return static_cast<size_t>(_wsq.capacity()); }
 
+        /**
+        @brief queries the NUMA node the worker is bound to
+
+        The value is zero unless the executor is created with
+        dubhe::ExecutorOptions::numa_aware.
+        */
+        inline size_t numa_node() const { return _numa_node; }
+
+        /**
+        @brief queries the cpu the worker is pinned to or -1 if the worker
+               is not pinned to a single cpu
+        */
+        inline int cpu() const { return _cpu; }
+
       private:
 
+        // state of the worker slot
+        enum : int {
+          IDLE = 0,   // no thread
+          ACTIVE,     // running thread
+          RETIRING,   // running thread asked to exit
+          RETIRED     // exited thread yet to be joined
+        };
+
         size_t _id;
         size_t _vtm;
+        size_t _group {0};
+        size_t _numa_node {0};
+        int _cpu {-1};
         Executor* _executor;
         std::thread* _thread;
         Notifier::Waiter* _waiter;
+        std::atomic<int> _state {IDLE};
+        size_t _pop_ages[DUBHE_NUM_PRIORITY_BUCKETS] {};
+        size_t _steal_ages[DUBHE_NUM_PRIORITY_BUCKETS] {};
         std::default_random_engine _rdgen { std::random_device{}() };
         TaskQueue<Node*> _wsq;
         Node* _cache;
+
+        // tasks hinted to this worker, which other workers take only when
+        // idle; the count is raised before a push and lowered after a take,
+        // such that a zero count means an empty mailbox without scanning it
+        MPMCQueue<Node*> _mailbox {256};
+        std::atomic<size_t> _num_mailed {0};
+
+        // epoch this worker announced before its latest round of steals, or
+        // SIZE_MAX while it does not steal; _num_grace arrays retired by its
+        // queue wait for every other worker to announce _grace_epoch
+        std::atomic<size_t> _epoch {SIZE_MAX};
+        size_t _grace_epoch {0};
+        size_t _num_grace {0};
+
+        // time of the tasks run nested in a tenant task, used to charge the
+        // tenant task for its own time only
+        int64_t _nested_time {0};
+        size_t _num_timed {0};
+
+        // tasks left to run before this worker looks for due timers again
+        size_t _timer_countdown {0};
+
+        // nodes of the subflows and runtime asynchronous tasks this worker spawns
+        ObjectArena<Node> _arena;
+    };
+
+    // ----------------------------------------------------------------------------
+    // Class Definition: WorkerGroup
+    // ----------------------------------------------------------------------------
+
+    /**
+    @private
+
+    A worker group collects the workers that share a NUMA node. External
+    submissions land in the group's injection queue, and members of the
+    group prefer stealing from each other before going remote. Ready tasks
+    with a deadline wait in the earliest-deadline-first heap of the group
+    they are scheduled from.
+    */
+    class WorkerGroup {
+
+      friend class Executor;
+
+      private:
+
+        size_t _numa_node {0};
+        std::vector<size_t> _workers;
+
+        // ids of the active workers of the group in the first _num_active
+        // slots, which thieves read without a lock
+        std::atomic<size_t> _num_active {0};
+        std::unique_ptr<std::atomic<size_t>[]> _active;
+        std::vector<size_t> _cpus;
+        MPMCQueue<Node*> _wsq;
+
+        std::mutex _deadline_mutex;
+        std::vector<std::tuple<std::chrono::steady_clock::time_point, size_t, Node*>> _deadline_heap;
+        size_t _deadline_seq {0};
+        std::atomic<size_t> _num_deadline_tasks {0};
     };
 
     // ----------------------------------------------------------------------------
@@ -138,8 +228,8 @@ namespace dubhe {
         @brief queries the worker id associated with its parent executor
 
         A worker id is a unsigned integer in the range <tt>[0, N)</tt>,
-        where @c N is the number of workers spawned at the construction
-        time of the executor.
+        where @c N is the number of worker slots of the executor
+        (see dubhe::Executor::max_num_workers).
         */
         size_t id() const;
 
@@ -154,6 +244,17 @@ namespace dubhe {
         */
         size_t queue_capacity() const;
 
+        /**
+        @brief queries the NUMA node the worker is bound to
+        */
+        size_t numa_node() const;
+
+        /**
+        @brief queries the cpu the worker is pinned to or -1 if the worker
+               is not pinned to a single cpu
+        */
+        int cpu() const;
+
       private:
 
         WorkerView(const Worker&);
@@ -182,6 +283,16 @@ namespace dubhe {
       return static_cast<size_t>(_worker._wsq.capacity());
     }
 
+    // Function: numa_node
+    inline size_t WorkerView::numa_node() const {
+      return _worker._numa_node;
+    }
+
+    // Function: cpu
+    inline int WorkerView::cpu() const {
+      return _worker._cpu;
+    }
+
 
 }  // namespace dubhe
 
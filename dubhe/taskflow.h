@@ -19,6 +19,8 @@
 
 #include <dubhe/core/executor.h>
 #include <dubhe/core/async.h>
+#include <dubhe/core/coroutine.h>
+#include <dubhe/core/overlapped_run.h>
 #include <dubhe/algorithm/critical.h>
 #include <dubhe/version.h>
 
@@ -0,0 +1,279 @@
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <dubhe/utility/numa.h>
+
+#if DUBHE_OS_LINUX
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// default sysfs directory to discover the cpu topology on Linux
+#define DUBHE_CPU_SYSFS_ROOT "/sys/devices/system/cpu"
+
+/**
+@file affinity.h
+@brief thread affinity include file
+*/
+
+namespace dubhe {
+
+    // ----------------------------------------------------------------------------
+    // Affinity policy
+    // ----------------------------------------------------------------------------
+
+    /**
+    @enum AffinityPolicy
+
+    @brief enumeration of worker placement policies
+
+    Worker @c i of an executor is pinned to the <tt>i%M</tt>-th cpu of an
+    ordered list of @c M cpus, where the list consists only of cpus in the
+    affinity mask of the process and its order depends on the policy.
+    */
+    enum class AffinityPolicy : int {
+      /** @brief leaves workers unpinned */
+      NONE = 0,
+      /** @brief packs workers onto adjacent cpus, SMT siblings first */
+      COMPACT,
+      /** @brief spreads workers over packages and physical cores before
+                 using SMT siblings */
+      SCATTER,
+      /** @brief pins workers to a user-given list of cpus */
+      EXPLICIT,
+      /** @brief packs workers onto one hardware thread per physical core */
+      NO_SMT
+    };
+
+    /**
+    @struct CpuInfo
+
+    @brief structure to describe the topology of a logical cpu
+    */
+    struct CpuInfo {
+
+      /**
+      @brief logical cpu id
+      */
+      size_t id {0};
+
+      /**
+      @brief physical core of the cpu, identified by its first SMT sibling
+      */
+      size_t core {0};
+
+      /**
+      @brief physical package (socket) of the cpu
+      */
+      size_t package {0};
+
+      /**
+      @brief position of the cpu among the SMT siblings of its core
+      */
+      size_t smt_rank {0};
+    };
+
+    // Function: allowed_cpus
+    // returns the sorted list of cpus in the affinity mask of the
+    // calling thread, or [0, hardware_concurrency) if the platform
+    // cannot tell
+    inline std::vector<size_t> allowed_cpus() {
+
+      std::vector<size_t> cpus;
+
+    #if DUBHE_OS_LINUX
+      cpu_set_t cpuset;
+      CPU_ZERO(&cpuset);
+      if(sched_getaffinity(0, sizeof(cpu_set_t), &cpuset) == 0) {
+        for(size_t c=0; c<CPU_SETSIZE; ++c) {
+          if(CPU_ISSET(c, &cpuset)) {
+            cpus.push_back(c);
+          }
+        }
+      }
+    #endif
+
+      if(cpus.empty()) {
+        cpus.resize(std::max(1u, std::thread::hardware_concurrency()));
+        std::iota(cpus.begin(), cpus.end(), 0);
+      }
+
+      return cpus;
+    }
+
+    // Function: discover_cpus
+    // reads the core, package, and SMT sibling rank of the given cpus from
+    // <tt>cpuK/topology</tt> under the given sysfs root; a cpu without
+    // topology information is treated as a core of its own in package 0
+    inline std::vector<CpuInfo> discover_cpus(
+      const std::vector<size_t>& cpus,
+      const std::string& root = DUBHE_CPU_SYSFS_ROOT
+    ) {
+
+      std::vector<CpuInfo> infos;
+      infos.reserve(cpus.size());
+
+      for(auto c : cpus) {
+
+        CpuInfo info;
+        info.id = c;
+        info.core = c;
+
+        auto dir = root + "/cpu" + std::to_string(c) + "/topology/";
+
+        if(std::ifstream ifs(dir + "thread_siblings_list"); ifs) {
+          std::string line;
+          std::getline(ifs, line);
+          auto siblings = parse_cpu_list(line);
+          if(auto itr = std::find(siblings.begin(), siblings.end(), c);
+             itr != siblings.end()) {
+            info.core = siblings.front();
+            info.smt_rank = static_cast<size_t>(itr - siblings.begin());
+          }
+        }
+
+        if(std::ifstream ifs(dir + "physical_package_id"); ifs) {
+          long package = 0;
+          if(ifs >> package; package >= 0) {
+            info.package = static_cast<size_t>(package);
+          }
+        }
+
+        infos.push_back(info);
+      }
+
+      return infos;
+    }
+
+    // Function: order_cpus
+    // orders the given cpus for the placement policy; for
+    // AffinityPolicy::EXPLICIT, the explicit list is filtered by the
+    // given cpus with its order preserved, and for AffinityPolicy::NONE
+    // the result is empty
+    inline std::vector<size_t> order_cpus(
+      std::vector<CpuInfo> infos,
+      AffinityPolicy policy,
+      const std::vector<size_t>& explicit_cpus = {}
+    ) {
+
+      std::vector<size_t> cpus;
+
+      auto compact = [](const CpuInfo& a, const CpuInfo& b) {
+        return std::tie(a.package, a.core, a.smt_rank) <
+               std::tie(b.package, b.core, b.smt_rank);
+      };
+
+      // re-rank the SMT siblings among the given cpus only, such that a core
+      // whose first sibling is outside the affinity mask still counts
+      std::sort(infos.begin(), infos.end(), compact);
+      for(size_t i=0; i<infos.size(); ++i) {
+        bool same_core = i && infos[i].core == infos[i-1].core &&
+                         infos[i].package == infos[i-1].package;
+        infos[i].smt_rank = same_core ? infos[i-1].smt_rank + 1 : 0;
+      }
+
+      switch(policy) {
+
+        case AffinityPolicy::NONE:
+        break;
+
+        case AffinityPolicy::COMPACT:
+          for(auto& info : infos) {
+            cpus.push_back(info.id);
+          }
+        break;
+
+        case AffinityPolicy::NO_SMT:
+          for(auto& info : infos) {
+            if(info.smt_rank == 0) {
+              cpus.push_back(info.id);
+            }
+          }
+        break;
+
+        case AffinityPolicy::SCATTER: {
+          // position of each core inside its package
+          std::unordered_map<size_t, size_t> core_index;
+          std::unordered_map<size_t, size_t> num_cores;
+          for(auto& info : infos) {
+            if(core_index.find(info.core) == core_index.end()) {
+              core_index[info.core] = num_cores[info.package]++;
+            }
+          }
+          // one thread of every core round-robin over packages, then the
+          // next SMT sibling of every core, and so on
+          std::stable_sort(infos.begin(), infos.end(), [&](const auto& a, const auto& b){
+            return std::make_tuple(a.smt_rank, core_index[a.core], a.package) <
+                   std::make_tuple(b.smt_rank, core_index[b.core], b.package);
+          });
+          for(auto& info : infos) {
+            cpus.push_back(info.id);
+          }
+        }
+        break;
+
+        case AffinityPolicy::EXPLICIT:
+          for(auto c : explicit_cpus) {
+            if(std::find_if(infos.begin(), infos.end(), [c](const auto& info){
+                 return info.id == c;
+               }) != infos.end()) {
+              cpus.push_back(c);
+            }
+          }
+        break;
+      }
+
+      return cpus;
+    }
+
+    // Function: current_cpu
+    // returns the logical cpu the calling thread is running on or -1
+    // if the platform cannot tell
+    inline int current_cpu() {
+    #if DUBHE_OS_LINUX
+      return sched_getcpu();
+    #else
+      return -1;
+    #endif
+    }
+
+    // Function: bind_thread_to_cpus
+    // restricts the given thread to run on the given set of logical cpus;
+    // returns false if the platform does not support it or the request
+    // is rejected (e.g., none of the cpus is available to this process)
+    inline bool bind_thread_to_cpus(std::thread& thread, const std::vector<size_t>& cpus) {
+    #if DUBHE_OS_LINUX
+      cpu_set_t cpuset;
+      CPU_ZERO(&cpuset);
+      for(auto c : cpus) {
+        if(c < CPU_SETSIZE) {
+          CPU_SET(c, &cpuset);
+        }
+      }
+      return pthread_setaffinity_np(
+        thread.native_handle(), sizeof(cpu_set_t), &cpuset
+      ) == 0;
+    #else
+      (void)thread;
+      (void)cpus;
+      return false;
+    #endif
+    }
+
+}  // namespace dubhe
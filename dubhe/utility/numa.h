@@ -0,0 +1,161 @@
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <dubhe/utility/traits.h>
+#include <filesystem>
+
+// default sysfs directory to discover NUMA nodes on Linux
+#define DUBHE_NUMA_SYSFS_ROOT "/sys/devices/system/node"
+
+/**
+@file numa.h
+@brief NUMA topology discovery include file
+*/
+
+namespace dubhe {
+
+    // ----------------------------------------------------------------------------
+    // NUMA topology
+    // ----------------------------------------------------------------------------
+
+    /**
+    @struct NumaNode
+
+    @brief structure to describe a NUMA node and the logical CPUs it owns
+    */
+    struct NumaNode {
+
+      /**
+      @brief the node id as reported by the operating system
+      */
+      size_t id {0};
+
+      /**
+      @brief sorted list of logical CPU ids belonging to this node
+      */
+      std::vector<size_t> cpus;
+    };
+
+    // Function: parse_cpu_list
+    // parses a Linux cpulist string (e.g., "0-3,8,10-11") into a sorted
+    // list of unique cpu ids; malformed tokens are ignored
+    inline std::vector<size_t> parse_cpu_list(const std::string& str) {
+
+      std::vector<size_t> cpus;
+      std::stringstream ss(str);
+      std::string token;
+
+      while(std::getline(ss, token, ',')) {
+
+        // trim the whitespace (e.g., the trailing newline of a sysfs file)
+        auto beg = token.find_first_not_of(" \t\r\n");
+        auto end = token.find_last_not_of(" \t\r\n");
+        if(beg == std::string::npos) {
+          continue;
+        }
+        token = token.substr(beg, end - beg + 1);
+
+        size_t lo, hi;
+        char* p;
+        lo = std::strtoul(token.c_str(), &p, 10);
+        if(p == token.c_str()) {
+          continue;
+        }
+        if(*p == '-') {
+          char* q;
+          hi = std::strtoul(p + 1, &q, 10);
+          if(q == p + 1 || *q != '\0' || hi < lo) {
+            continue;
+          }
+        }
+        else if(*p == '\0') {
+          hi = lo;
+        }
+        else {
+          continue;
+        }
+
+        for(size_t c=lo; c<=hi; ++c) {
+          cpus.push_back(c);
+        }
+      }
+
+      std::sort(cpus.begin(), cpus.end());
+      cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+
+      return cpus;
+    }
+
+    // Function: discover_numa_nodes
+    // discovers the NUMA nodes under the given sysfs root, which contains
+    // one <tt>nodeK/cpulist</tt> file per node; nodes without CPUs
+    // (e.g., memory-only nodes) are skipped and the result is sorted by id.
+    // If nothing can be discovered, a single node owning the CPUs
+    // <tt>[0, hardware_concurrency)</tt> is returned.
+    inline std::vector<NumaNode> discover_numa_nodes(
+      const std::string& root = DUBHE_NUMA_SYSFS_ROOT
+    ) {
+
+      std::vector<NumaNode> nodes;
+      std::error_code ec;
+
+      for(std::filesystem::directory_iterator itr(root, ec), end;
+          !ec && itr != end; itr.increment(ec)) {
+
+        auto name = itr->path().filename().string();
+
+        if(name.size() <= 4 || name.compare(0, 4, "node") != 0 ||
+           !std::all_of(name.begin() + 4, name.end(), [](char c){
+             return c >= '0' && c <= '9';
+           })) {
+          continue;
+        }
+
+        std::ifstream ifs(itr->path() / "cpulist");
+        if(!ifs) {
+          continue;
+        }
+
+        std::string line;
+        std::getline(ifs, line);
+
+        NumaNode node;
+        node.id = std::stoul(name.substr(4));
+        node.cpus = parse_cpu_list(line);
+
+        if(!node.cpus.empty()) {
+          nodes.push_back(std::move(node));
+        }
+      }
+
+      if(nodes.empty()) {
+        NumaNode node;
+        node.cpus.resize(std::max(1u, std::thread::hardware_concurrency()));
+        std::iota(node.cpus.begin(), node.cpus.end(), 0);
+        nodes.push_back(std::move(node));
+      }
+
+      std::sort(nodes.begin(), nodes.end(), [](const auto& a, const auto& b){
+        return a.id < b.id;
+      });
+
+      return nodes;
+    }
+
+}  // namespace dubhe
@@ -0,0 +1,323 @@
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace dubhe {
+
+// Class: ObjectArena
+//
+// The class implements an object arena owned by a single thread.
+// Only the owner thread animates objects, which it does by bumping an
+// index into its current chunk without any lock or atomic operation.
+// Any thread can recycle an object, which destroys the object and
+// decrements the live count of its chunk. A chunk is released in bulk
+// once the owner has filled it and all its objects are recycled: it
+// goes back to the owner through a lock-free list and is reused as a
+// whole, so objects that are born and die together, such as the tasks
+// of a subflow, cost the owner no more than a pointer bump each.
+//
+// Objects record a null block in the field declared by
+// DUBHE_ENABLE_POOLABLE_ON_THIS, which tells them apart from objects of
+// an ObjectPool. The chunk of an object is found by aligning down its
+// address to the chunk size S.
+//
+// Chunks may outlive the arena: the arena marks its depot closed when it
+// is destroyed, and whoever releases a chunk after that frees its memory.
+//
+template <typename T, size_t S = 65536>
+class ObjectArena {
+
+  struct Chunk;
+
+  // return list of released chunks shared by the arena and its chunks
+  struct Depot {
+    std::atomic<Chunk*> released {nullptr};
+    std::atomic<bool> closed {false};
+  };
+
+  struct Chunk {
+    std::atomic<size_t> live;
+    std::shared_ptr<Depot> depot;
+    Chunk* next {nullptr};
+  };
+
+  // offset of the first object in a chunk
+  constexpr static size_t O = (sizeof(Chunk) + alignof(T) - 1) / alignof(T) * alignof(T);
+
+  // number of objects per chunk
+  constexpr static size_t M = (S - O) / sizeof(T);
+
+  // live count of a chunk that is being filled; it stays above the
+  // number of recycled objects until the owner seals the chunk
+  constexpr static size_t L = M + 1;
+
+  static_assert(
+    S && (!(S & (S-1))), "chunk size S must be a power of two"
+  );
+
+  static_assert(
+    M >= 16, "chunk size S must be large enough to hold at least 16 objects"
+  );
+
+  public:
+
+    /**
+    @brief constructs an empty arena
+    */
+    ObjectArena() = default;
+
+    /**
+    @brief disabled copy constructor
+    */
+    ObjectArena(const ObjectArena&) = delete;
+
+    /**
+    @brief disabled copy assignment
+    */
+    ObjectArena& operator = (const ObjectArena&) = delete;
+
+    /**
+    @brief destructs the arena
+
+    Chunks that still hold objects are freed when their last object is
+    recycled.
+    */
+    ~ObjectArena();
+
+    /**
+    @brief acquires a pointer to an object constructed from a given
+           argument list (owner thread only)
+    */
+    template <typename... ArgsT>
+    T* animate(ArgsT&&... args);
+
+    /**
+    @brief recycles an object animated by any arena and destroys it
+    */
+    static void recycle(T* ptr);
+
+    /**
+    @brief queries if an object comes from an arena rather than an
+           ObjectPool
+    */
+    static bool owns(const T* ptr);
+
+    /**
+    @brief queries the number of objects per chunk
+    */
+    size_t num_objects_per_chunk() const;
+
+    /**
+    @brief queries the number of chunks the arena has allocated
+    */
+    size_t num_chunks() const;
+
+  private:
+
+    std::shared_ptr<Depot> _depot {std::make_shared<Depot>()};
+
+    Chunk* _chunk {nullptr};
+    Chunk* _free {nullptr};
+
+    size_t _used {0};
+    size_t _num_chunks {0};
+
+    void _refill();
+    void _seal();
+
+    static Chunk* _chunk_of(const T*);
+    static T* _slot(Chunk*, size_t);
+    static void _release(Chunk*);
+    static void _drain(Depot&);
+    static void _destroy(Chunk*);
+};
+
+// Destructor
+template <typename T, size_t S>
+ObjectArena<T, S>::~ObjectArena() {
+
+  _depot->closed.store(true, std::memory_order_seq_cst);
+
+  if(_chunk) {
+    _seal();
+  }
+
+  while(_free) {
+    auto next = _free->next;
+    _destroy(_free);
+    _free = next;
+  }
+
+  _drain(*_depot);
+}
+
+// Function: animate
+template <typename T, size_t S>
+template <typename... ArgsT>
+T* ObjectArena<T, S>::animate(ArgsT&&... args) {
+
+  if(_chunk == nullptr || _used == M) {
+    _refill();
+  }
+
+  T* mem = _slot(_chunk, _used++);
+
+  try {
+    new (mem) T(std::forward<ArgsT>(args)...);
+  }
+  catch(...) {
+    // the slot counts as recycled
+    _chunk->live.fetch_sub(1, std::memory_order_relaxed);
+    throw;
+  }
+
+  mem->_object_pool_block = nullptr;
+
+  return mem;
+}
+
+// Procedure: recycle
+template <typename T, size_t S>
+void ObjectArena<T, S>::recycle(T* ptr) {
+  Chunk* c = _chunk_of(ptr);
+  ptr->~T();
+  if(c->live.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    _release(c);
+  }
+}
+
+// Function: owns
+template <typename T, size_t S>
+bool ObjectArena<T, S>::owns(const T* ptr) {
+  return ptr->_object_pool_block == nullptr;
+}
+
+// Function: num_objects_per_chunk
+template <typename T, size_t S>
+size_t ObjectArena<T, S>::num_objects_per_chunk() const {
+  return M;
+}
+
+// Function: num_chunks
+template <typename T, size_t S>
+size_t ObjectArena<T, S>::num_chunks() const {
+  return _num_chunks;
+}
+
+// Procedure: _refill
+// seals the full chunk and continues with a released chunk if there is
+// one, or with a new chunk otherwise
+template <typename T, size_t S>
+void ObjectArena<T, S>::_refill() {
+
+  if(_chunk) {
+    _seal();
+  }
+
+  if(_free == nullptr) {
+    _free = _depot->released.exchange(nullptr, std::memory_order_acquire);
+  }
+
+  if(_free) {
+    _chunk = _free;
+    _free = _free->next;
+  }
+  else {
+    void* mem = ::operator new(S, std::align_val_t{S});
+    _chunk = new (mem) Chunk();
+    _chunk->depot = _depot;
+    ++_num_chunks;
+  }
+
+  _chunk->next = nullptr;
+  _chunk->live.store(L, std::memory_order_relaxed);
+  _used = 0;
+}
+
+// Procedure: _seal
+// hands the current chunk over to the recycling threads, where the
+// chunk returns to the free list at once if all its objects are gone
+template <typename T, size_t S>
+void ObjectArena<T, S>::_seal() {
+  auto n = L - _used;
+  if(_chunk->live.fetch_sub(n, std::memory_order_acq_rel) == n) {
+    _chunk->next = _free;
+    _free = _chunk;
+  }
+  _chunk = nullptr;
+}
+
+// Function: _chunk_of
+template <typename T, size_t S>
+typename ObjectArena<T, S>::Chunk* ObjectArena<T, S>::_chunk_of(const T* ptr) {
+  return reinterpret_cast<Chunk*>(reinterpret_cast<uintptr_t>(ptr) & ~(uintptr_t{S} - 1));
+}
+
+// Function: _slot
+template <typename T, size_t S>
+T* ObjectArena<T, S>::_slot(Chunk* c, size_t i) {
+  return reinterpret_cast<T*>(reinterpret_cast<char*>(c) + O + i * sizeof(T));
+}
+
+// Procedure: _release
+// pushes a chunk whose objects are all recycled to the depot of its arena,
+// or frees the chunk if the arena is gone
+template <typename T, size_t S>
+void ObjectArena<T, S>::_release(Chunk* c) {
+
+  // the chunk may be freed by the arena as soon as it is pushed
+  auto depot = c->depot;
+
+  auto head = depot->released.load(std::memory_order_relaxed);
+  do {
+    c->next = head;
+  } while(!depot->released.compare_exchange_weak(
+    head, c, std::memory_order_seq_cst, std::memory_order_relaxed
+  ));
+
+  if(depot->closed.load(std::memory_order_seq_cst)) {
+    _drain(*depot);
+  }
+}
+
+// Procedure: _drain
+template <typename T, size_t S>
+void ObjectArena<T, S>::_drain(Depot& depot) {
+  auto c = depot.released.exchange(nullptr, std::memory_order_seq_cst);
+  while(c) {
+    auto next = c->next;
+    _destroy(c);
+    c = next;
+  }
+}
+
+// Procedure: _destroy
+template <typename T, size_t S>
+void ObjectArena<T, S>::_destroy(Chunk* c) {
+  c->~Chunk();
+  ::operator delete(c, std::align_val_t{S});
+}
+
+}  // namespace dubhe
@@ -28,6 +28,7 @@ namespace dubhe {
 
 #define DUBHE_ENABLE_POOLABLE_ON_THIS                          \
   template <typename T, size_t S> friend class ObjectPool;  \
+  template <typename T, size_t S> friend class ObjectArena; \
   void* _object_pool_block
 
 // Class: ObjectPool
@@ -111,7 +112,7 @@ class ObjectPool {
     size_t u;
     T* top;
     // long double padding;
-    char data[S];
+    alignas(T) char data[S];
   };
 
   public:
@@ -132,6 +133,15 @@ class ObjectPool {
     template <typename... ArgsT>
     T* animate(ArgsT&&... args);
 
+    /**
+    @brief acquires @c n objects constructed from the same argument list
+
+    The memory of all objects is taken under a single lock of the local
+    heap, and the objects are stored in the array pointed by @c objs.
+    */
+    template <typename... ArgsT>
+    void animate_n(size_t n, T** objs, const ArgsT&... args);
+
     /**
     @brief recycles a object pointed by @c ptr and destroys it
     */
@@ -176,6 +186,7 @@ class ObjectPool {
     size_t _bin(size_t) const;
 
     T* _allocate(Block*);
+    T* _acquire(LocalHeap&, Block*&);
 
     void _deallocate(Block*, T*);
     void _blocklist_init_head(Blocklist*);
@@ -591,6 +602,47 @@ T* ObjectPool<T, S>::animate(ArgsT&&... args) {
   Block* s {nullptr};
 
   h.mutex.lock();
+  T* mem = _acquire(h, s);
+  h.mutex.unlock();
+
+  //printf("allocate %p (s=%p)\n", mem, s);
+
+  new (mem) T(std::forward<ArgsT>(args)...);
+
+  mem->_object_pool_block = s;
+
+  return mem;
+}
+
+// Function: animate_n
+template <typename T, size_t S>
+template <typename... ArgsT>
+void ObjectPool<T, S>::animate_n(size_t n, T** objs, const ArgsT&... args) {
+
+  LocalHeap& h = _this_heap();
+
+  // the superblock of each object is parked in its raw memory
+  // until the object is constructed outside the lock
+  h.mutex.lock();
+  for(size_t i=0; i<n; ++i) {
+    Block* s {nullptr};
+    objs[i] = _acquire(h, s);
+    *(reinterpret_cast<Block**>(objs[i])) = s;
+  }
+  h.mutex.unlock();
+
+  for(size_t i=0; i<n; ++i) {
+    Block* s = *(reinterpret_cast<Block**>(objs[i]));
+    new (objs[i]) T(args...);
+    objs[i]->_object_pool_block = s;
+  }
+}
+
+// Function: _acquire
+// acquires the memory of one object from the given local heap whose
+// lock is held by the caller
+template <typename T, size_t S>
+T* ObjectPool<T, S>::_acquire(LocalHeap& h, Block*& s) {
 
   // scan the list of superblocks from the most full to the least full
   int f = static_cast<int>(F-1);
@@ -668,14 +720,6 @@ T* ObjectPool<T, S>::animate(ArgsT&&... args) {
   //          << "h.u " << h.u  << '\n'
   //          << "h.a " << h.a  << '\n';
 
-  h.mutex.unlock();
-
-  //printf("allocate %p (s=%p)\n", mem, s);
-
-  new (mem) T(std::forward<ArgsT>(args)...);
-
-  mem->_object_pool_block = s;
-
   return mem;
 }
 
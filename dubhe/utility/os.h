@@ -140,10 +140,10 @@
 //-----------------------------------------------------------------------------
 // pause
 //-----------------------------------------------------------------------------
-//#if __has_include (<immintrin.h>)
-//  #define DUBHE_HAS_MM_PAUSE 1
-//  #include <immintrin.h>
-//#endif
+#if defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) || defined(_M_X64)
+  #define DUBHE_HAS_MM_PAUSE 1
+  #include <immintrin.h>
+#endif
 
 namespace dubhe {
 
@@ -193,11 +193,14 @@ namespace dubhe {
     }
 
     // Procedure: relax_cpu
-    //inline void relax_cpu() {
-    //#ifdef DUBHE_HAS_MM_PAUSE
-    //  _mm_pause();
-    //#endif
-    //}
+    // hints the processor that the caller is in a spin-wait loop
+    inline void relax_cpu() {
+#if defined(DUBHE_HAS_MM_PAUSE)
+        _mm_pause();
+#elif defined(__aarch64__) || (defined(__arm__) && __ARM_ARCH >= 7)
+        __asm__ __volatile__("yield");
+#endif
+    }
 
 
 
@@ -0,0 +1,278 @@
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// bytes of the inline buffer of a small function
+#ifndef DUBHE_SMALL_FUNCTION_SIZE
+#define DUBHE_SMALL_FUNCTION_SIZE 64
+#endif
+
+/**
+@file small_function.h
+@brief small function include file
+*/
+
+namespace dubhe {
+
+    // ----------------------------------------------------------------------------
+    // SmallFunction
+    // ----------------------------------------------------------------------------
+
+    template <typename Sig, size_t N = DUBHE_SMALL_FUNCTION_SIZE>
+    class SmallFunction;
+
+    /**
+    @class SmallFunction
+
+    @tparam R return type
+    @tparam Args argument types
+    @tparam N bytes of the inline buffer
+
+    @brief class to create a move-only, type-erased callable with an
+           inline buffer
+
+    Unlike @c std::function, a small function accepts move-only callables
+    and keeps every callable of up to @c N bytes in place, so storing a
+    task with a few captures does not allocate. Larger callables, and
+    callables that may throw when moved, are kept on the heap.
+    Invoking a small function is a single call through a function pointer,
+    and moving it copies the buffer when the callable is trivially copyable.
+
+    The buffer size defaults to the macro @c DUBHE_SMALL_FUNCTION_SIZE
+    (64 bytes), which can be defined before including the library.
+    */
+    template <typename R, typename... Args, size_t N>
+    class SmallFunction<R(Args...), N> {
+
+      static_assert(N >= sizeof(void*), "small function buffer must hold a pointer");
+
+      template <typename F>
+      constexpr static bool _is_inline = sizeof(F) <= N &&
+                                         alignof(F) <= alignof(std::max_align_t) &&
+                                         std::is_nothrow_move_constructible_v<F>;
+
+      template <typename F>
+      using _enable_if_callable_t = std::enable_if_t<
+        !std::is_same_v<std::decay_t<F>, SmallFunction> &&
+        std::is_invocable_r_v<R, std::decay_t<F>&, Args...>,
+        void
+      >;
+
+      // moves the callable in src to dst, or destroys it if dst is null
+      using manager_t = void (*)(void* dst, void* src) noexcept;
+      using invoker_t = R (*)(void*, Args&&...);
+
+      public:
+
+        /**
+        @brief constructs an empty small function
+        */
+        SmallFunction() noexcept = default;
+
+        /**
+        @brief constructs an empty small function
+        */
+        SmallFunction(std::nullptr_t) noexcept {}
+
+        /**
+        @brief constructs a small function from the given callable
+        */
+        template <typename F, _enable_if_callable_t<F>* = nullptr>
+        SmallFunction(F&& f) {
+          _emplace<std::decay_t<F>>(std::forward<F>(f));
+        }
+
+        /**
+        @brief move constructor
+        */
+        SmallFunction(SmallFunction&& rhs) noexcept {
+          _steal(rhs);
+        }
+
+        /**
+        @brief disabled copy constructor
+        */
+        SmallFunction(const SmallFunction&) = delete;
+
+        /**
+        @brief destructs the small function and its callable
+        */
+        ~SmallFunction() {
+          reset();
+        }
+
+        /**
+        @brief move assignment operator
+        */
+        SmallFunction& operator = (SmallFunction&& rhs) noexcept {
+          if(this != &rhs) {
+            reset();
+            _steal(rhs);
+          }
+          return *this;
+        }
+
+        /**
+        @brief disabled copy assignment operator
+        */
+        SmallFunction& operator = (const SmallFunction&) = delete;
+
+        /**
+        @brief replaces the callable with the given one
+        */
+        template <typename F, _enable_if_callable_t<F>* = nullptr>
+        SmallFunction& operator = (F&& f) {
+          reset();
+          _emplace<std::decay_t<F>>(std::forward<F>(f));
+          return *this;
+        }
+
+        /**
+        @brief destroys the callable
+        */
+        SmallFunction& operator = (std::nullptr_t) noexcept {
+          reset();
+          return *this;
+        }
+
+        /**
+        @brief queries if the small function holds a callable
+        */
+        explicit operator bool() const noexcept {
+          return _invoker != &_invoke_empty;
+        }
+
+        /**
+        @brief invokes the callable
+
+        Invoking an empty small function throws @c std::bad_function_call.
+        */
+        R operator () (Args... args) const {
+          return _invoker(const_cast<unsigned char*>(_buffer), std::forward<Args>(args)...);
+        }
+
+        /**
+        @brief destroys the callable and leaves the small function empty
+        */
+        void reset() noexcept {
+          if(_manager) {
+            _manager(nullptr, _buffer);
+            _manager = nullptr;
+          }
+          _invoker = &_invoke_empty;
+        }
+
+      private:
+
+        alignas(std::max_align_t) unsigned char _buffer[N];
+
+        invoker_t _invoker {&_invoke_empty};
+        manager_t _manager {nullptr};
+
+        template <typename F, typename... Ts>
+        void _emplace(Ts&&...);
+
+        void _steal(SmallFunction&) noexcept;
+
+        static R _invoke_empty(void*, Args&&...) {
+          throw std::bad_function_call();
+        }
+
+        template <typename F>
+        static F& _target(void* p) noexcept {
+          if constexpr(_is_inline<F>) {
+            return *std::launder(static_cast<F*>(p));
+          }
+          else {
+            return **static_cast<F**>(p);
+          }
+        }
+
+        template <typename F>
+        static R _invoke(void* p, Args&&... args) {
+          if constexpr(std::is_void_v<R>) {
+            std::invoke(_target<F>(p), std::forward<Args>(args)...);
+          }
+          else {
+            return std::invoke(_target<F>(p), std::forward<Args>(args)...);
+          }
+        }
+
+        template <typename F>
+        static void _manage(void* dst, void* src) noexcept {
+          if constexpr(_is_inline<F>) {
+            if(dst) {
+              ::new (dst) F(std::move(_target<F>(src)));
+            }
+            _target<F>(src).~F();
+          }
+          else {
+            if(dst) {
+              *static_cast<F**>(dst) = *static_cast<F**>(src);
+            }
+            else {
+              delete *static_cast<F**>(src);
+            }
+          }
+        }
+    };
+
+    // Procedure: _emplace
+    // a trivially copyable inline callable needs no manager, as moving it
+    // is a copy of the buffer and destroying it is a no-op
+    template <typename R, typename... Args, size_t N>
+    template <typename F, typename... Ts>
+    void SmallFunction<R(Args...), N>::_emplace(Ts&&... ts) {
+      if constexpr(_is_inline<F>) {
+        ::new (static_cast<void*>(_buffer)) F(std::forward<Ts>(ts)...);
+        if constexpr(!std::is_trivially_copyable_v<F>) {
+          _manager = &_manage<F>;
+        }
+      }
+      else {
+        *reinterpret_cast<F**>(_buffer) = new F(std::forward<Ts>(ts)...);
+        _manager = &_manage<F>;
+      }
+      _invoker = &_invoke<F>;
+    }
+
+    // Procedure: _steal
+    template <typename R, typename... Args, size_t N>
+    void SmallFunction<R(Args...), N>::_steal(SmallFunction& rhs) noexcept {
+      if(!rhs) {
+        return;
+      }
+      if(rhs._manager) {
+        rhs._manager(_buffer, rhs._buffer);
+      }
+      else {
+        std::memcpy(_buffer, rhs._buffer, N);
+      }
+      _invoker = std::exchange(rhs._invoker, &_invoke_empty);
+      _manager = std::exchange(rhs._manager, nullptr);
+    }
+
+}  // end of namespace dubhe -----------------------------------------------------
@@ -16,10 +16,10 @@
 //
 // This program demonstrates how to set priority to a task.
 //
-// Currently, Taskflow supports only three priority levels:
+// A priority is a value in [0, 256) with three named levels:
 //   + dubhe::TaskPriority::HIGH   (numerical value = 0)
-//   + dubhe::TaskPriority::NORMAL (numerical value = 1)
-//   + dubhe::TaskPriority::LOW    (numerical value = 2)
+//   + dubhe::TaskPriority::NORMAL (numerical value = 128)
+//   + dubhe::TaskPriority::LOW    (numerical value = 255)
 // 
 // Priority-based execution is non-preemptive. Once a task 
 // has started to execute, it will execute to completion,
@@ -418,3 +418,249 @@ TEST_CASE("RuntimeAsync.3threads") {
 TEST_CASE("RuntimeAsync.11threads") {
   runtime_async(11);
 }
+
+// --------------------------------------------------------
+// Testcase: SilentAsyncBulk
+// --------------------------------------------------------
+
+void silent_async_bulk(size_t W) {
+
+  dubhe::Executor executor(W);
+
+  std::atomic<size_t> counter {0};
+
+  // empty batches
+  std::vector<std::function<void()>> funcs;
+  executor.silent_async_bulk(funcs.begin(), funcs.end());
+  executor.silent_async_bulk(10, 10, [&](size_t){ counter++; });
+  executor.silent_async_bulk(10, 0, [&](size_t){ counter++; });
+  executor.wait_for_all();
+  REQUIRE(counter == 0);
+
+  // range of callables
+  for(size_t n=1; n<=4096; n=n*2+1) {
+
+    counter = 0;
+
+    funcs.assign(n, [&](){ counter.fetch_add(1, std::memory_order_relaxed); });
+    executor.silent_async_bulk(funcs.begin(), funcs.end());
+    executor.silent_async_bulk(
+      "named", std::make_move_iterator(funcs.begin()), std::make_move_iterator(funcs.end())
+    );
+    executor.wait_for_all();
+
+    REQUIRE(counter == 2*n);
+  }
+
+  // index range
+  for(size_t n=1; n<=4096; n=n*2+1) {
+
+    std::vector<int> data(n+3, -1);
+
+    executor.silent_async_bulk(3, n+3, [&](size_t i){ data[i] = static_cast<int>(i); });
+    executor.wait_for_all();
+
+    for(size_t i=0; i<3; i++) {
+      REQUIRE(data[i] == -1);
+    }
+    for(size_t i=3; i<n+3; i++) {
+      REQUIRE(data[i] == static_cast<int>(i));
+    }
+  }
+
+  // task parameters apply to every task
+  counter = 0;
+  dubhe::TaskParams params;
+  params.name = "bulk";
+  params.priority = static_cast<unsigned>(dubhe::TaskPriority::LOW);
+  executor.silent_async_bulk(params, 0, 1000, [&](size_t){ counter++; });
+  executor.wait_for_all();
+  REQUIRE(counter == 1000);
+
+  // nested batches from workers
+  counter = 0;
+  executor.silent_async_bulk(0, 100, [&](size_t){
+    executor.silent_async_bulk(0, 100, [&](size_t){
+      counter.fetch_add(1, std::memory_order_relaxed);
+    });
+  });
+  executor.wait_for_all();
+  REQUIRE(counter == 100*100);
+
+  // batches with runtime tasks
+  counter = 0;
+  std::vector<std::function<void(dubhe::Runtime&)>> rt_funcs(100, [&](dubhe::Runtime& rt){
+    rt.silent_async([&](){ counter++; });
+    rt.corun_all();
+    counter++;
+  });
+  executor.silent_async_bulk(rt_funcs.begin(), rt_funcs.end());
+  executor.wait_for_all();
+  REQUIRE(counter == 200);
+}
+
+TEST_CASE("SilentAsyncBulk.1thread" * doctest::timeout(300)) {
+  silent_async_bulk(1);
+}
+
+TEST_CASE("SilentAsyncBulk.2threads" * doctest::timeout(300)) {
+  silent_async_bulk(2);
+}
+
+TEST_CASE("SilentAsyncBulk.4threads" * doctest::timeout(300)) {
+  silent_async_bulk(4);
+}
+
+TEST_CASE("SilentAsyncBulk.8threads" * doctest::timeout(300)) {
+  silent_async_bulk(8);
+}
+
+TEST_CASE("SilentAsyncBulk.16threads" * doctest::timeout(300)) {
+  silent_async_bulk(16);
+}
+
+// --------------------------------------------------------
+// Testcase: Backpressure
+// --------------------------------------------------------
+
+TEST_CASE("Backpressure.Fail" * doctest::timeout(300)) {
+
+  dubhe::ExecutorOptions options;
+  options.backpressure.max_pending = 4;
+  options.backpressure.mode = dubhe::OverflowMode::FAIL;
+  dubhe::Executor executor(2, options);
+
+  std::atomic<bool> gate {false};
+  std::atomic<size_t> counter {0};
+
+  for(size_t i=0; i<4; i++) {
+    REQUIRE(executor.try_silent_async([&](){ while(!gate); counter++; }));
+  }
+  REQUIRE(executor.num_pending() == 4);
+
+  dubhe::Taskflow taskflow;
+  taskflow.emplace([&](){ counter++; });
+
+  REQUIRE(executor.try_silent_async([&](){ counter++; }) == false);
+  REQUIRE(executor.try_async([&](){ return 1; }).has_value() == false);
+  REQUIRE(executor.try_run(taskflow).has_value() == false);
+  REQUIRE_THROWS(executor.silent_async([&](){ counter++; }));
+  REQUIRE_THROWS(executor.async([&](){ counter++; }));
+  REQUIRE_THROWS(executor.run(taskflow));
+  REQUIRE(executor.num_pending() == 4);
+
+  gate = true;
+  executor.wait_for_all();
+  REQUIRE(counter == 4);
+  REQUIRE(executor.num_pending() == 0);
+
+  auto fu = executor.try_async([](){ return 7; });
+  REQUIRE(fu.has_value());
+  REQUIRE(fu->get() == 7);
+
+  auto run = executor.try_run(taskflow);
+  REQUIRE(run.has_value());
+  run->wait();
+  REQUIRE(counter == 5);
+
+  executor.wait_for_all();
+  REQUIRE(executor.num_pending() == 0);
+}
+
+TEST_CASE("Backpressure.Inline" * doctest::timeout(300)) {
+
+  dubhe::ExecutorOptions options;
+  options.backpressure.max_pending = 2;
+  options.backpressure.mode = dubhe::OverflowMode::INLINE;
+  dubhe::Executor executor(2, options);
+
+  std::atomic<bool> gate {false};
+  std::atomic<size_t> counter {0};
+
+  executor.silent_async([&](){ while(!gate); });
+  executor.silent_async([&](){ while(!gate); });
+
+  auto id = std::this_thread::get_id();
+
+  // work beyond the bound runs on the caller
+  auto fu = executor.async([&](){ return std::this_thread::get_id(); });
+  REQUIRE(fu.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+  REQUIRE(fu.get() == id);
+
+  executor.silent_async([&](){ REQUIRE(std::this_thread::get_id() == id); counter++; });
+  REQUIRE(counter == 1);
+
+  executor.silent_async_bulk(0, 100, [&](size_t){ counter++; });
+  REQUIRE(counter == 101);
+  REQUIRE(executor.num_pending() == 2);
+
+  gate = true;
+  executor.wait_for_all();
+  REQUIRE(executor.num_pending() == 0);
+}
+
+void backpressure_block(size_t W) {
+
+  dubhe::ExecutorOptions options;
+  options.backpressure.max_pending = 4;
+  dubhe::Executor executor(W, options);
+
+  std::atomic<size_t> counter {0};
+  std::atomic<size_t> max_pending {0};
+
+  auto update = [&](){
+    auto n = executor.num_pending();
+    auto m = max_pending.load();
+    while(n > m && !max_pending.compare_exchange_weak(m, n));
+  };
+
+  // two producers racing for the bound
+  std::thread producer([&](){
+    for(size_t i=0; i<5000; i++) {
+      executor.silent_async([&](){ update(); counter++; });
+    }
+  });
+
+  std::vector<std::future<void>> futures;
+  for(size_t i=0; i<5000; i++) {
+    futures.push_back(executor.async([&](){ update(); counter++; }));
+  }
+  producer.join();
+
+  executor.wait_for_all();
+  REQUIRE(counter == 10000);
+  REQUIRE(max_pending <= 4);
+
+  // runs and bulk submissions
+  dubhe::Taskflow taskflow;
+  taskflow.emplace([&](){ update(); counter++; });
+  for(size_t i=0; i<100; i++) {
+    executor.run(taskflow);
+    executor.silent_async_bulk(0, 3, [&](size_t){ update(); counter++; });
+  }
+  executor.wait_for_all();
+  REQUIRE(counter == 10400);
+  REQUIRE(max_pending <= 4);
+
+  // workers are never held back
+  executor.silent_async([&](){
+    for(size_t i=0; i<100; i++) {
+      executor.silent_async([&](){ counter++; });
+    }
+  });
+  executor.wait_for_all();
+  REQUIRE(counter == 10500);
+  REQUIRE(executor.num_pending() == 0);
+}
+
+TEST_CASE("Backpressure.Block.1thread" * doctest::timeout(300)) {
+  backpressure_block(1);
+}
+
+TEST_CASE("Backpressure.Block.2threads" * doctest::timeout(300)) {
+  backpressure_block(2);
+}
+
+TEST_CASE("Backpressure.Block.4threads" * doctest::timeout(300)) {
+  backpressure_block(4);
+}
@@ -0,0 +1,240 @@
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include <doctest/doctest.h>
+#include <dubhe/taskflow.h>
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+using namespace std::chrono_literals;
+
+// --------------------------------------------------------
+// Testcase: Coroutine.Basics
+// --------------------------------------------------------
+
+dubhe::Coroutine<int> square(int x) {
+  co_return x * x;
+}
+
+dubhe::Coroutine<int> sum_of_squares(int n) {
+  int s = 0;
+  for(int i=1; i<=n; ++i) {
+    s += co_await square(i);
+  }
+  co_return s;
+}
+
+dubhe::Coroutine<std::string> text() {
+  co_return std::string(100, 'x');
+}
+
+dubhe::Coroutine<> fail() {
+  throw std::runtime_error("x");
+  co_return;
+}
+
+dubhe::Coroutine<int> catch_fail() {
+  try {
+    co_await fail();
+  }
+  catch(const std::runtime_error&) {
+    co_return 1;
+  }
+  co_return 0;
+}
+
+TEST_CASE("Coroutine.Basics" * doctest::timeout(300)) {
+
+  dubhe::Executor executor(2);
+
+  REQUIRE(executor.co_spawn(square(7)).get() == 49);
+  REQUIRE(executor.co_spawn(sum_of_squares(10)).get() == 385);
+  REQUIRE(executor.co_spawn(text()).get() == std::string(100, 'x'));
+
+  // exceptions go to the awaiting coroutine or to the future
+  REQUIRE(executor.co_spawn(catch_fail()).get() == 1);
+  REQUIRE_THROWS_AS(executor.co_spawn(fail()).get(), std::runtime_error);
+
+  // a coroutine that is never spawned never runs
+  {
+    auto coro = square(3);
+  }
+
+  executor.wait_for_all();
+  REQUIRE(executor.num_pending() == 0);
+}
+
+// --------------------------------------------------------
+// Testcase: Coroutine.AsyncTask
+// --------------------------------------------------------
+
+dubhe::Coroutine<int> await_tasks(dubhe::Executor& executor, std::atomic<int>& counter) {
+  auto A = executor.silent_dependent_async([&](){ counter++; });
+  auto B = executor.silent_dependent_async([&](){ counter++; }, A);
+  co_await B;
+  co_await A;
+  co_return counter.load();
+}
+
+TEST_CASE("Coroutine.AsyncTask" * doctest::timeout(300)) {
+
+  dubhe::Executor executor(2);
+
+  for(int i=0; i<100; ++i) {
+    std::atomic<int> counter {0};
+    REQUIRE(executor.co_spawn(await_tasks(executor, counter)).get() == 2);
+  }
+}
+
+// --------------------------------------------------------
+// Testcase: Coroutine.Future
+// --------------------------------------------------------
+
+dubhe::Coroutine<int> await_futures(dubhe::Executor& executor, dubhe::Taskflow& taskflow) {
+  auto fu1 = executor.async([](){ std::this_thread::sleep_for(1ms); return 3; });
+  int r = co_await fu1;
+  auto fu2 = executor.run(taskflow);
+  co_await fu2;
+  co_return r;
+}
+
+TEST_CASE("Coroutine.Future" * doctest::timeout(300)) {
+
+  dubhe::Executor executor(2);
+  dubhe::Taskflow taskflow;
+  std::atomic<int> counter {0};
+
+  for(int i=0; i<10; ++i) {
+    taskflow.emplace([&](){ counter++; });
+  }
+
+  std::vector<std::future<int>> futures;
+  for(int i=0; i<10; ++i) {
+    futures.push_back(executor.co_spawn(await_futures(executor, taskflow)));
+  }
+  for(auto& fu : futures) {
+    REQUIRE(fu.get() == 3);
+  }
+  REQUIRE(counter == 100);
+}
+
+dubhe::Coroutine<int> await_temporaries(dubhe::Executor& executor, dubhe::Taskflow& taskflow) {
+  int r = co_await executor.async([](){ std::this_thread::sleep_for(1ms); return 3; });
+  co_await executor.run(taskflow);
+  r += co_await executor.co_spawn(square(2));
+  co_return r;
+}
+
+TEST_CASE("Coroutine.Future.Temporary" * doctest::timeout(300)) {
+
+  dubhe::Executor executor(2);
+  dubhe::Taskflow taskflow;
+  std::atomic<int> counter {0};
+
+  for(int i=0; i<10; ++i) {
+    taskflow.emplace([&](){ counter++; });
+  }
+
+  std::vector<std::future<int>> futures;
+  for(int i=0; i<10; ++i) {
+    futures.push_back(executor.co_spawn(await_temporaries(executor, taskflow)));
+  }
+  for(auto& fu : futures) {
+    REQUIRE(fu.get() == 7);
+  }
+  REQUIRE(counter == 100);
+}
+
+// --------------------------------------------------------
+// Testcase: Coroutine.Semaphore
+// --------------------------------------------------------
+
+dubhe::Coroutine<> critical(
+  dubhe::Semaphore& semaphore, std::atomic<int>& inside, std::atomic<int>& max, int& counter
+) {
+  co_await semaphore;
+  auto n = ++inside;
+  int m = max.load();
+  while(n > m && !max.compare_exchange_weak(m, n));
+  ++counter;
+  co_await dubhe::sleep_for(10us);
+  --inside;
+  co_await dubhe::release(semaphore);
+}
+
+void semaphore(size_t W) {
+
+  dubhe::Executor executor(W);
+  dubhe::Semaphore semaphore(1);
+
+  std::atomic<int> inside {0};
+  std::atomic<int> max {0};
+  int counter = 0;
+
+  for(int i=0; i<1000; ++i) {
+    executor.co_spawn(critical(semaphore, inside, max, counter));
+  }
+  executor.wait_for_all();
+
+  REQUIRE(counter == 1000);
+  REQUIRE(max == 1);
+  REQUIRE(semaphore.count() == 1);
+}
+
+TEST_CASE("Coroutine.Semaphore.1thread" * doctest::timeout(300)) {
+  semaphore(1);
+}
+
+TEST_CASE("Coroutine.Semaphore.4threads" * doctest::timeout(300)) {
+  semaphore(4);
+}
+
+// --------------------------------------------------------
+// Testcase: Coroutine.Sleep
+// --------------------------------------------------------
+
+dubhe::Coroutine<> nap(std::atomic<size_t>& counter) {
+  for(int i=0; i<10; ++i) {
+    co_await dubhe::sleep_for(10ms);
+  }
+  counter++;
+}
+
+// sleeping coroutines hold no worker, such that thousands of them sleep
+// side by side on two workers
+TEST_CASE("Coroutine.Sleep" * doctest::timeout(300)) {
+
+  dubhe::Executor executor(2);
+  std::atomic<size_t> counter {0};
+
+  auto beg = std::chrono::steady_clock::now();
+  for(int i=0; i<5000; ++i) {
+    executor.co_spawn(nap(counter));
+  }
+  executor.wait_for_all();
+  auto end = std::chrono::steady_clock::now();
+
+  REQUIRE(counter == 5000);
+  REQUIRE(end - beg >= 100ms);
+  REQUIRE(end - beg < 60s);
+  REQUIRE(executor.num_timers() == 0);
+}
+
+#endif
@@ -136,6 +136,23 @@ TEST_CASE("find_if.GuidedPartitioner.8threads" * doctest::timeout(300)) {
   test_find_if<dubhe::GuidedPartitioner<>>(8);
 }
 
+// adaptive partitioner
+TEST_CASE("find_if.AdaptivePartitioner.1thread" * doctest::timeout(300)) {
+  test_find_if<dubhe::AdaptivePartitioner<>>(1);
+}
+
+TEST_CASE("find_if.AdaptivePartitioner.2threads" * doctest::timeout(300)) {
+  test_find_if<dubhe::AdaptivePartitioner<>>(2);
+}
+
+TEST_CASE("find_if.AdaptivePartitioner.4threads" * doctest::timeout(300)) {
+  test_find_if<dubhe::AdaptivePartitioner<>>(4);
+}
+
+TEST_CASE("find_if.AdaptivePartitioner.8threads" * doctest::timeout(300)) {
+  test_find_if<dubhe::AdaptivePartitioner<>>(8);
+}
+
 // dynamic partitioner
 TEST_CASE("find_if.DynamicPartitioner.1thread" * doctest::timeout(300)) {
   test_find_if<dubhe::DynamicPartitioner<>>(1);
@@ -291,6 +308,23 @@ TEST_CASE("find_if_not.GuidedPartitioner.8threads" * doctest::timeout(300)) {
   test_find_if_not<dubhe::GuidedPartitioner<>>(8);
 }
 
+// adaptive partitioner
+TEST_CASE("find_if_not.AdaptivePartitioner.1thread" * doctest::timeout(300)) {
+  test_find_if_not<dubhe::AdaptivePartitioner<>>(1);
+}
+
+TEST_CASE("find_if_not.AdaptivePartitioner.2threads" * doctest::timeout(300)) {
+  test_find_if_not<dubhe::AdaptivePartitioner<>>(2);
+}
+
+TEST_CASE("find_if_not.AdaptivePartitioner.4threads" * doctest::timeout(300)) {
+  test_find_if_not<dubhe::AdaptivePartitioner<>>(4);
+}
+
+TEST_CASE("find_if_not.AdaptivePartitioner.8threads" * doctest::timeout(300)) {
+  test_find_if_not<dubhe::AdaptivePartitioner<>>(8);
+}
+
 // dynamic partitioner
 TEST_CASE("find_if_not.DynamicPartitioner.1thread" * doctest::timeout(300)) {
   test_find_if_not<dubhe::DynamicPartitioner<>>(1);
@@ -450,6 +484,23 @@ TEST_CASE("min_element.GuidedPartitioner.8threads" * doctest::timeout(300)) {
   test_min_element<dubhe::GuidedPartitioner<>>(8);
 }
 
+// adaptive partitioner
+TEST_CASE("min_element.AdaptivePartitioner.1thread" * doctest::timeout(300)) {
+  test_min_element<dubhe::AdaptivePartitioner<>>(1);
+}
+
+TEST_CASE("min_element.AdaptivePartitioner.2threads" * doctest::timeout(300)) {
+  test_min_element<dubhe::AdaptivePartitioner<>>(2);
+}
+
+TEST_CASE("min_element.AdaptivePartitioner.4threads" * doctest::timeout(300)) {
+  test_min_element<dubhe::AdaptivePartitioner<>>(4);
+}
+
+TEST_CASE("min_element.AdaptivePartitioner.8threads" * doctest::timeout(300)) {
+  test_min_element<dubhe::AdaptivePartitioner<>>(8);
+}
+
 // dynamic partitioner
 TEST_CASE("min_element.DynamicPartitioner.1thread" * doctest::timeout(300)) {
   test_min_element<dubhe::DynamicPartitioner<>>(1);
@@ -609,6 +660,23 @@ TEST_CASE("max_element.GuidedPartitioner.8threads" * doctest::timeout(300)) {
   test_max_element<dubhe::GuidedPartitioner<>>(8);
 }
 
+// adaptive partitioner
+TEST_CASE("max_element.AdaptivePartitioner.1thread" * doctest::timeout(300)) {
+  test_max_element<dubhe::AdaptivePartitioner<>>(1);
+}
+
+TEST_CASE("max_element.AdaptivePartitioner.2threads" * doctest::timeout(300)) {
+  test_max_element<dubhe::AdaptivePartitioner<>>(2);
+}
+
+TEST_CASE("max_element.AdaptivePartitioner.4threads" * doctest::timeout(300)) {
+  test_max_element<dubhe::AdaptivePartitioner<>>(4);
+}
+
+TEST_CASE("max_element.AdaptivePartitioner.8threads" * doctest::timeout(300)) {
+  test_max_element<dubhe::AdaptivePartitioner<>>(8);
+}
+
 // dynamic partitioner
 TEST_CASE("max_element.DynamicPartitioner.1thread" * doctest::timeout(300)) {
   test_max_element<dubhe::DynamicPartitioner<>>(1);
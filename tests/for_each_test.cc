@@ -287,6 +287,23 @@ TEST_CASE("ParallelFor.Random.12threads" * doctest::timeout(300)) {
   for_each<dubhe::RandomPartitioner<>>(12);
 }
 
+// adaptive
+TEST_CASE("ParallelFor.Adaptive.1thread" * doctest::timeout(300)) {
+  for_each<dubhe::AdaptivePartitioner<>>(1);
+}
+
+TEST_CASE("ParallelFor.Adaptive.2threads" * doctest::timeout(300)) {
+  for_each<dubhe::AdaptivePartitioner<>>(2);
+}
+
+TEST_CASE("ParallelFor.Adaptive.4threads" * doctest::timeout(300)) {
+  for_each<dubhe::AdaptivePartitioner<>>(4);
+}
+
+TEST_CASE("ParallelFor.Adaptive.8threads" * doctest::timeout(300)) {
+  for_each<dubhe::AdaptivePartitioner<>>(8);
+}
+
 // ----------------------------------------------------------------------------
 // stateful_for_each
 // ----------------------------------------------------------------------------
@@ -549,6 +566,23 @@ TEST_CASE("StatefulParallelFor.Random.12threads" * doctest::timeout(300)) {
   stateful_for_each<dubhe::RandomPartitioner<>>(12);
 }
 
+// adaptive
+TEST_CASE("StatefulParallelFor.Adaptive.1thread" * doctest::timeout(300)) {
+  stateful_for_each<dubhe::AdaptivePartitioner<>>(1);
+}
+
+TEST_CASE("StatefulParallelFor.Adaptive.2threads" * doctest::timeout(300)) {
+  stateful_for_each<dubhe::AdaptivePartitioner<>>(2);
+}
+
+TEST_CASE("StatefulParallelFor.Adaptive.4threads" * doctest::timeout(300)) {
+  stateful_for_each<dubhe::AdaptivePartitioner<>>(4);
+}
+
+TEST_CASE("StatefulParallelFor.Adaptive.8threads" * doctest::timeout(300)) {
+  stateful_for_each<dubhe::AdaptivePartitioner<>>(8);
+}
+
 // ----------------------------------------------------------------------------
 // for_each_index negative index
 // ----------------------------------------------------------------------------
@@ -784,3 +818,45 @@ TEST_CASE("ClosureWrapper.for_each.Dynamic" * doctest::timeout(300))
 
 
 
+
+// ----------------------------------------------------------------------------
+// Adaptive Partitioner Tuning
+// ----------------------------------------------------------------------------
+
+TEST_CASE("ParallelFor.Adaptive.Tuning" * doctest::timeout(300)) {
+
+  dubhe::Executor executor(2);
+  dubhe::Taskflow taskflow;
+
+  const size_t N = 1 << 20;
+  std::vector<int> vec(N, 0);
+
+  // cheap iterations grow the chunk size from one in a single run
+  dubhe::AdaptivePartitioner<> cheap;
+  REQUIRE(cheap.tuned_chunk_size() == 1);
+  REQUIRE(cheap.target() == std::chrono::microseconds(30));
+
+  taskflow.for_each(vec.begin(), vec.end(), [](int& i){ i++; }, cheap);
+  executor.run(taskflow).wait();
+  REQUIRE(std::all_of(vec.begin(), vec.end(), [](int i){ return i == 1; }));
+
+  auto tuned = cheap.tuned_chunk_size();
+  REQUIRE(tuned > 64);
+
+  // the next run continues from the tuned chunk size
+  executor.run_n(taskflow, 3).wait();
+  REQUIRE(std::all_of(vec.begin(), vec.end(), [](int i){ return i == 4; }));
+  REQUIRE(cheap.tuned_chunk_size() > 64);
+
+  // expensive iterations keep the chunk size small
+  taskflow.clear();
+  dubhe::AdaptivePartitioner<> costly(256, std::chrono::microseconds(20));
+  REQUIRE(costly.tuned_chunk_size() == 256);
+
+  taskflow.for_each_index(0, 2000, 1, [](int){
+    auto beg = std::chrono::steady_clock::now();
+    while(std::chrono::steady_clock::now() - beg < std::chrono::microseconds(10));
+  }, costly);
+  executor.run(taskflow).wait();
+  REQUIRE(costly.tuned_chunk_size() <= 16);
+}
@@ -0,0 +1,384 @@
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include <doctest/doctest.h>
+#include <dubhe/taskflow.h>
+
+// --------------------------------------------------------
+// Testcase: Freeze.Basics
+// --------------------------------------------------------
+
+void freeze_basics(size_t W) {
+
+  dubhe::Executor executor(W);
+  dubhe::Taskflow taskflow;
+
+  std::atomic<size_t> counter {0};
+
+  // a diamond of fans
+  auto source = taskflow.emplace([&](){ counter++; });
+  auto sink = taskflow.emplace([&](){ counter++; });
+  for(int i=0; i<100; ++i) {
+    auto a = taskflow.emplace([&](){ counter++; });
+    auto b = taskflow.emplace([&](){ counter++; });
+    source.precede(a);
+    a.precede(b);
+    b.precede(sink);
+  }
+  taskflow.emplace([&](){ counter++; });
+
+  REQUIRE(!taskflow.frozen());
+  taskflow.freeze();
+  REQUIRE(taskflow.frozen());
+
+  for(size_t i=0; i<10; ++i) {
+    executor.run(taskflow).wait();
+  }
+  REQUIRE(counter == 10*203);
+
+  counter = 0;
+  executor.run_n(taskflow, 10).wait();
+  REQUIRE(counter == 10*203);
+
+  // concurrent runs of the same taskflow queue up
+  counter = 0;
+  for(size_t i=0; i<10; ++i) {
+    executor.run(taskflow);
+  }
+  executor.wait_for_all();
+  REQUIRE(counter == 10*203);
+
+  // adding a task thaws the taskflow
+  auto last = taskflow.emplace([&](){ counter++; });
+  sink.precede(last);
+  REQUIRE(!taskflow.frozen());
+  counter = 0;
+  executor.run(taskflow).wait();
+  REQUIRE(counter == 204);
+
+  taskflow.freeze();
+  counter = 0;
+  executor.run(taskflow).wait();
+  REQUIRE(counter == 204);
+
+  // removing a dependency thaws the taskflow
+  taskflow.remove_dependency(sink, last);
+  REQUIRE(!taskflow.frozen());
+  taskflow.freeze();
+  counter = 0;
+  executor.run(taskflow).wait();
+  REQUIRE(counter == 204);
+
+  // erasing a task thaws the taskflow
+  taskflow.erase(last);
+  REQUIRE(!taskflow.frozen());
+  taskflow.freeze();
+  counter = 0;
+  executor.run(taskflow).wait();
+  REQUIRE(counter == 203);
+
+  taskflow.thaw();
+  REQUIRE(!taskflow.frozen());
+  counter = 0;
+  executor.run(taskflow).wait();
+  REQUIRE(counter == 203);
+
+  taskflow.freeze();
+  taskflow.clear();
+  REQUIRE(!taskflow.frozen());
+
+  // an empty frozen taskflow
+  taskflow.freeze();
+  executor.run(taskflow).wait();
+}
+
+TEST_CASE("Freeze.Basics.1thread" * doctest::timeout(300)) {
+  freeze_basics(1);
+}
+
+TEST_CASE("Freeze.Basics.2threads" * doctest::timeout(300)) {
+  freeze_basics(2);
+}
+
+TEST_CASE("Freeze.Basics.4threads" * doctest::timeout(300)) {
+  freeze_basics(4);
+}
+
+// --------------------------------------------------------
+// Testcase: Freeze.ControlFlow
+// --------------------------------------------------------
+
+void freeze_control_flow(size_t W) {
+
+  dubhe::Executor executor(W);
+  dubhe::Taskflow taskflow;
+
+  int i = 0, sum = 0;
+
+  auto init = taskflow.emplace([&](){ i = 0; });
+  auto body = taskflow.emplace([&](){ sum += i; });
+  auto cond = taskflow.emplace([&](){ return ++i < 10 ? 0 : 1; });
+  auto done = taskflow.emplace([&](){ sum += 1000; });
+
+  init.precede(body);
+  body.precede(cond);
+  cond.precede(body, done);
+
+  taskflow.freeze();
+
+  for(int r=0; r<5; ++r) {
+    sum = 0;
+    executor.run(taskflow).wait();
+    REQUIRE(sum == 45 + 1000);
+  }
+
+  sum = 0;
+  executor.run_n(taskflow, 5).wait();
+  REQUIRE(sum == 5*(45 + 1000));
+}
+
+TEST_CASE("Freeze.ControlFlow.1thread" * doctest::timeout(300)) {
+  freeze_control_flow(1);
+}
+
+TEST_CASE("Freeze.ControlFlow.4threads" * doctest::timeout(300)) {
+  freeze_control_flow(4);
+}
+
+// --------------------------------------------------------
+// Testcase: Freeze.Subflow
+// --------------------------------------------------------
+
+void freeze_subflow(size_t W) {
+
+  dubhe::Executor executor(W);
+  dubhe::Taskflow taskflow;
+
+  std::atomic<size_t> counter {0};
+
+  auto joined = taskflow.emplace([&](dubhe::Subflow& sf){
+    for(int i=0; i<10; ++i) {
+      sf.emplace([&](){ counter++; });
+    }
+  });
+
+  auto detached = taskflow.emplace([&](dubhe::Subflow& sf){
+    for(int i=0; i<10; ++i) {
+      sf.emplace([&](){ counter++; });
+    }
+    sf.detach();
+  });
+
+  joined.precede(detached);
+
+  taskflow.freeze();
+
+  for(int r=0; r<10; ++r) {
+    executor.run(taskflow).wait();
+    executor.wait_for_all();
+    REQUIRE(counter == (r+1)*20);
+  }
+
+  // detached tasks of the last run are cleared by the next one
+  REQUIRE(taskflow.frozen());
+}
+
+TEST_CASE("Freeze.Subflow.1thread" * doctest::timeout(300)) {
+  freeze_subflow(1);
+}
+
+TEST_CASE("Freeze.Subflow.4threads" * doctest::timeout(300)) {
+  freeze_subflow(4);
+}
+
+// --------------------------------------------------------
+// Testcase: Freeze.Composition
+// --------------------------------------------------------
+
+void freeze_composition(size_t W) {
+
+  dubhe::Executor executor(W);
+  dubhe::Taskflow inner, outer;
+
+  std::atomic<size_t> counter {0};
+
+  auto a = inner.emplace([&](){ counter++; });
+  auto b = inner.emplace([&](){ counter++; });
+  auto c = inner.emplace([&](){ counter++; });
+  a.precede(b, c);
+  inner.freeze();
+
+  auto m1 = outer.composed_of(inner);
+  auto m2 = outer.composed_of(inner);
+  m1.precede(m2);
+  outer.freeze();
+
+  executor.run_n(outer, 10).wait();
+  REQUIRE(counter == 10*6);
+}
+
+TEST_CASE("Freeze.Composition.1thread" * doctest::timeout(300)) {
+  freeze_composition(1);
+}
+
+TEST_CASE("Freeze.Composition.4threads" * doctest::timeout(300)) {
+  freeze_composition(4);
+}
+
+// --------------------------------------------------------
+// Testcase: Freeze.Precede
+// --------------------------------------------------------
+
+void freeze_precede(size_t W) {
+
+  dubhe::Executor executor(W);
+  dubhe::Taskflow taskflow;
+
+  std::vector<int> order;
+  std::mutex mutex;
+
+  auto push = [&](int i){
+    return [&, i](){
+      std::lock_guard<std::mutex> lock(mutex);
+      order.push_back(i);
+    };
+  };
+
+  auto a = taskflow.emplace(push(0));
+  auto b = taskflow.emplace(push(1));
+  auto c = taskflow.emplace(push(2));
+  a.precede(b);
+
+  taskflow.freeze();
+  executor.run(taskflow).wait();
+  REQUIRE(order.size() == 3);
+
+  // c was a source when frozen and now waits for b
+  b.precede(c);
+  for(size_t i=0; i<10; ++i) {
+    order.clear();
+    executor.run(taskflow).wait();
+    REQUIRE(order == std::vector<int>{0, 1, 2});
+  }
+  REQUIRE(!taskflow.frozen());
+
+  taskflow.freeze();
+  order.clear();
+  executor.run_n(taskflow, 2).wait();
+  REQUIRE(order == std::vector<int>{0, 1, 2, 0, 1, 2});
+
+  // a dependency added with succeed is detected alike
+  auto d = taskflow.emplace(push(3));
+  taskflow.freeze();
+  d.succeed(c);
+  order.clear();
+  executor.run(taskflow).wait();
+  REQUIRE(order == std::vector<int>{0, 1, 2, 3});
+}
+
+TEST_CASE("Freeze.Precede.1thread" * doctest::timeout(300)) {
+  freeze_precede(1);
+}
+
+TEST_CASE("Freeze.Precede.4threads" * doctest::timeout(300)) {
+  freeze_precede(4);
+}
+
+// --------------------------------------------------------
+// Testcase: Freeze.Work
+// --------------------------------------------------------
+
+void freeze_work(size_t W) {
+
+  dubhe::Executor executor(W);
+  dubhe::Taskflow taskflow;
+
+  std::atomic<size_t> counter {0};
+
+  auto a = taskflow.emplace([&](){ counter++; return 1; });
+  auto b = taskflow.emplace([&](){ counter++; });
+  a.precede(b);
+
+  taskflow.freeze();
+  executor.run(taskflow).wait();
+  REQUIRE(counter == 1);
+
+  // a condition task turned into a static task releases b
+  a.work([&](){ counter++; });
+  counter = 0;
+  executor.run(taskflow).wait();
+  REQUIRE(counter == 2);
+  REQUIRE(!taskflow.frozen());
+
+  // and back into a condition task that skips b
+  taskflow.freeze();
+  a.work([&](){ counter++; return 1; });
+  counter = 0;
+  executor.run(taskflow).wait();
+  REQUIRE(counter == 1);
+  REQUIRE(!taskflow.frozen());
+}
+
+TEST_CASE("Freeze.Work.1thread" * doctest::timeout(300)) {
+  freeze_work(1);
+}
+
+TEST_CASE("Freeze.Work.4threads" * doctest::timeout(300)) {
+  freeze_work(4);
+}
+
+// --------------------------------------------------------
+// Testcase: Freeze.Exception
+// --------------------------------------------------------
+
+void freeze_exception(size_t W) {
+
+  dubhe::Executor executor(W);
+  dubhe::Taskflow taskflow;
+
+  std::atomic<bool> fail {true};
+  std::atomic<size_t> counter {0};
+
+  auto a = taskflow.emplace([&](){
+    if(fail) {
+      throw std::runtime_error("x");
+    }
+    counter++;
+  });
+  auto b = taskflow.emplace([&](){ counter++; });
+  a.precede(b);
+
+  taskflow.freeze();
+
+  REQUIRE_THROWS_WITH_AS(executor.run(taskflow).get(), "x", std::runtime_error);
+
+  fail = false;
+  executor.run(taskflow).get();
+  REQUIRE(counter == 2);
+}
+
+TEST_CASE("Freeze.Exception.1thread" * doctest::timeout(300)) {
+  freeze_exception(1);
+}
+
+TEST_CASE("Freeze.Exception.4threads" * doctest::timeout(300)) {
+  freeze_exception(4);
+}
@@ -0,0 +1,448 @@
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include <doctest/doctest.h>
+#include <dubhe/taskflow.h>
+
+// --------------------------------------------------------
+// Testcase: Fuse.Chains
+// --------------------------------------------------------
+
+TEST_CASE("Fuse.Chains" * doctest::timeout(300)) {
+
+  dubhe::Taskflow taskflow;
+
+  // A -> B -> C -> D fuses into A
+  auto [A, B, C, D] = taskflow.emplace([](){}, [](){}, [](){}, [](){});
+  A.precede(B);
+  B.precede(C);
+  C.precede(D);
+  REQUIRE(taskflow.fuse() == 3);
+
+  // a fan-out ends the chain at its source and a fan-in starts a new one
+  // at its sink
+  auto [E, F, G] = taskflow.emplace([](){}, [](){}, [](){});
+  D.precede(E, F);
+  E.precede(G);
+  F.precede(G);
+  REQUIRE(taskflow.fuse() == 3);
+
+  auto [H, I] = taskflow.emplace([](){}, [](){});
+  G.precede(H);
+  H.precede(I);
+  REQUIRE(taskflow.fuse() == 5);
+
+  // a loop of static tasks has no source and no chain head
+  auto [X, Y] = taskflow.emplace([](){}, [](){});
+  X.precede(Y);
+  Y.precede(X);
+  REQUIRE(taskflow.fuse() == 5);
+
+  taskflow.unfuse();
+  REQUIRE(taskflow.num_tasks() == 11);
+  REQUIRE(A.num_successors() == 1);
+}
+
+// --------------------------------------------------------
+// Testcase: Fuse.Exclusions
+// --------------------------------------------------------
+
+TEST_CASE("Fuse.Exclusions" * doctest::timeout(300)) {
+
+  dubhe::Taskflow taskflow;
+  dubhe::Semaphore semaphore(1);
+  dubhe::Tenant tenant;
+
+  auto A = taskflow.emplace([](){});
+  auto B = taskflow.emplace([](){ return 0; });
+  auto C = taskflow.emplace([](){});
+  auto D = taskflow.emplace([](dubhe::Runtime&){});
+  auto E = taskflow.emplace([](){});
+  auto F = taskflow.emplace([](dubhe::Subflow&){});
+  auto G = taskflow.emplace([](){});
+  auto H = taskflow.emplace([](){});
+  auto I = taskflow.emplace([](){});
+  auto J = taskflow.emplace([](){});
+
+  A.precede(B);  // condition
+  B.precede(C);
+  C.precede(D);  // runtime
+  D.precede(E);
+  E.precede(F);  // subflow
+  F.precede(G);
+  G.precede(H);  // semaphore
+  H.acquire(semaphore).release(semaphore);
+  H.precede(I);
+  I.precede(J);  // tenant
+  J.tenant(tenant);
+
+  REQUIRE(taskflow.fuse() == 0);
+}
+
+// --------------------------------------------------------
+// Testcase: Fuse.Order
+// --------------------------------------------------------
+
+void fuse_order(size_t W) {
+
+  const size_t L = 1000;
+
+  dubhe::Executor executor(W);
+  dubhe::Taskflow taskflow;
+
+  std::vector<size_t> order;
+  order.reserve(L);
+
+  dubhe::Task prev;
+  for(size_t i=0; i<L; i++) {
+    auto task = taskflow.emplace([&order, i](){ order.push_back(i); });
+    if(!prev.empty()) {
+      prev.precede(task);
+    }
+    prev = task;
+  }
+
+  REQUIRE(taskflow.fuse() == L-1);
+
+  for(size_t r=0; r<10; r++) {
+    order.clear();
+    executor.run(taskflow).wait();
+    REQUIRE(order.size() == L);
+    for(size_t i=0; i<L; i++) {
+      REQUIRE(order[i] == i);
+    }
+  }
+
+  // fusion and freezing combine
+  taskflow.freeze();
+  order.clear();
+  executor.run_n(taskflow, 2).wait();
+  REQUIRE(order.size() == 2*L);
+}
+
+TEST_CASE("Fuse.Order.1thread" * doctest::timeout(300)) {
+  fuse_order(1);
+}
+
+TEST_CASE("Fuse.Order.4threads" * doctest::timeout(300)) {
+  fuse_order(4);
+}
+
+// --------------------------------------------------------
+// Testcase: Fuse.FanOutFanIn
+// --------------------------------------------------------
+
+void fuse_fan_out_fan_in(size_t W) {
+
+  dubhe::Executor executor(W);
+  dubhe::Taskflow taskflow;
+
+  std::atomic<size_t> counter {0};
+  std::atomic<size_t> result {0};
+
+  // a source, 100 chains of 10 tasks, and a sink that sees every chain
+  auto source = taskflow.emplace([&](){ counter = 0; });
+  auto sink = taskflow.emplace([&](){ result = counter.load(); });
+
+  for(size_t c=0; c<100; c++) {
+    dubhe::Task prev = source;
+    for(size_t i=0; i<10; i++) {
+      auto task = taskflow.emplace([&](){ counter++; });
+      prev.precede(task);
+      prev = task;
+    }
+    prev.precede(sink);
+  }
+
+  REQUIRE(taskflow.fuse() == 900);
+
+  for(size_t r=0; r<10; r++) {
+    executor.run(taskflow).wait();
+    REQUIRE(result == 1000);
+  }
+
+  // erasing a task unfuses the taskflow
+  auto extra = taskflow.emplace([](){});
+  taskflow.erase(extra);
+  for(size_t r=0; r<10; r++) {
+    executor.run(taskflow).wait();
+    REQUIRE(result == 1000);
+  }
+}
+
+TEST_CASE("Fuse.FanOutFanIn.1thread" * doctest::timeout(300)) {
+  fuse_fan_out_fan_in(1);
+}
+
+TEST_CASE("Fuse.FanOutFanIn.4threads" * doctest::timeout(300)) {
+  fuse_fan_out_fan_in(4);
+}
+
+// --------------------------------------------------------
+// Testcase: Fuse.ControlFlow
+// --------------------------------------------------------
+
+void fuse_control_flow(size_t W) {
+
+  dubhe::Executor executor(W);
+  dubhe::Taskflow taskflow;
+
+  int i = 0;
+  int counter = 0;
+
+  // init -> A -> B -> C -> cond, where cond jumps back to A four times
+  auto init = taskflow.emplace([&](){ i = 0; counter = 0; });
+  auto [A, B, C] = taskflow.emplace(
+    [&](){ counter++; }, [&](){ counter++; }, [&](){ counter++; }
+  );
+  auto cond = taskflow.emplace([&](){ return ++i < 5 ? 0 : 1; });
+  auto stop = taskflow.emplace([](){});
+
+  init.precede(A);
+  A.precede(B);
+  B.precede(C);
+  C.precede(cond);
+  cond.precede(A, stop);
+
+  REQUIRE(taskflow.fuse() == 2);
+
+  for(int r=0; r<10; r++) {
+    executor.run(taskflow).wait();
+    REQUIRE(i == 5);
+    REQUIRE(counter == 15);
+  }
+}
+
+TEST_CASE("Fuse.ControlFlow.1thread" * doctest::timeout(300)) {
+  fuse_control_flow(1);
+}
+
+TEST_CASE("Fuse.ControlFlow.4threads" * doctest::timeout(300)) {
+  fuse_control_flow(4);
+}
+
+// --------------------------------------------------------
+// Testcase: Fuse.Composition
+// --------------------------------------------------------
+
+TEST_CASE("Fuse.Composition" * doctest::timeout(300)) {
+
+  dubhe::Executor executor(4);
+  dubhe::Taskflow taskflow1, taskflow2;
+
+  std::atomic<size_t> counter {0};
+
+  dubhe::Task prev;
+  for(size_t i=0; i<100; i++) {
+    auto task = taskflow1.emplace([&](){ counter++; });
+    if(!prev.empty()) {
+      prev.precede(task);
+    }
+    prev = task;
+  }
+  REQUIRE(taskflow1.fuse() == 99);
+
+  auto m1 = taskflow2.composed_of(taskflow1);
+  auto m2 = taskflow2.composed_of(taskflow1);
+  m1.precede(m2);
+
+  executor.run_n(taskflow2, 5).wait();
+  REQUIRE(counter == 1000);
+}
+
+// --------------------------------------------------------
+// Testcase: Fuse.Observer
+// --------------------------------------------------------
+
+// Observer: NameObserver
+// counts the entries and exits of the tasks by name
+struct NameObserver : public dubhe::ObserverInterface {
+
+  std::mutex mutex;
+  std::map<std::string, size_t> entries;
+  std::map<std::string, size_t> exits;
+
+  void set_up(size_t) override final {}
+
+  void on_entry(dubhe::WorkerView, dubhe::TaskView tv) override final {
+    std::scoped_lock lock(mutex);
+    entries[tv.name()]++;
+  }
+
+  void on_exit(dubhe::WorkerView, dubhe::TaskView tv) override final {
+    std::scoped_lock lock(mutex);
+    exits[tv.name()]++;
+  }
+};
+
+TEST_CASE("Fuse.Observer" * doctest::timeout(300)) {
+
+  dubhe::Executor executor(2);
+  dubhe::Taskflow taskflow;
+
+  auto observer = executor.make_observer<NameObserver>();
+
+  auto [A, B, C] = taskflow.emplace([](){}, [](){}, [](){});
+  A.name("A").precede(B);
+  B.name("B").precede(C);
+  C.name("C");
+
+  REQUIRE(taskflow.fuse() == 2);
+  executor.run_n(taskflow, 3).wait();
+
+  for(auto name : {"A", "B", "C"}) {
+    REQUIRE(observer->entries[name] == 3);
+    REQUIRE(observer->exits[name] == 3);
+  }
+}
+
+// --------------------------------------------------------
+// Testcase: Fuse.Exception
+// --------------------------------------------------------
+
+void fuse_exception(size_t W) {
+
+  dubhe::Executor executor(W);
+  dubhe::Taskflow taskflow;
+
+  std::atomic<size_t> counter {0};
+
+  auto [A, B, C, D] = taskflow.emplace(
+    [&](){ counter++; },
+    [&](){ counter++; throw std::runtime_error("x"); },
+    [&](){ counter++; },
+    [&](){ counter++; }
+  );
+  A.precede(B);
+  B.precede(C);
+  C.precede(D);
+
+  REQUIRE(taskflow.fuse() == 3);
+
+  for(int r=0; r<10; r++) {
+    counter = 0;
+    REQUIRE_THROWS_WITH_AS(executor.run(taskflow).get(), "x", std::runtime_error);
+    REQUIRE(counter == 2);
+  }
+}
+
+TEST_CASE("Fuse.Exception.1thread" * doctest::timeout(300)) {
+  fuse_exception(1);
+}
+
+TEST_CASE("Fuse.Exception.4threads" * doctest::timeout(300)) {
+  fuse_exception(4);
+}
+
+// a fused chain inside a module stops at the task that throws as well
+void fuse_module_exception(size_t W) {
+
+  dubhe::Executor executor(W);
+  dubhe::Taskflow taskflow1, taskflow2;
+
+  std::atomic<size_t> counter {0};
+
+  auto [A, B, C, D] = taskflow1.emplace(
+    [&](){ counter++; },
+    [&](){ counter++; throw std::runtime_error("x"); },
+    [&](){ counter++; },
+    [&](){ counter++; }
+  );
+  A.precede(B);
+  B.precede(C);
+  C.precede(D);
+
+  REQUIRE(taskflow1.fuse() == 3);
+
+  taskflow2.composed_of(taskflow1);
+
+  for(int r=0; r<10; r++) {
+    counter = 0;
+    REQUIRE_THROWS_WITH_AS(executor.run(taskflow2).get(), "x", std::runtime_error);
+    REQUIRE(counter == 2);
+  }
+}
+
+TEST_CASE("Fuse.Exception.Module.1thread" * doctest::timeout(300)) {
+  fuse_module_exception(1);
+}
+
+TEST_CASE("Fuse.Exception.Module.4threads" * doctest::timeout(300)) {
+  fuse_module_exception(4);
+}
+
+// --------------------------------------------------------
+// Testcase: Fuse.ChangedEdges
+// --------------------------------------------------------
+
+// edges added after fusion end a fused chain at the broken link
+void fuse_changed_edges(size_t W) {
+
+  dubhe::Executor executor(W);
+  dubhe::Taskflow taskflow;
+
+  std::vector<char> order;
+  std::mutex mutex;
+  auto record = [&](char c){
+    return [&, c](){ std::lock_guard<std::mutex> lock(mutex); order.push_back(c); };
+  };
+
+  auto [A, B, C] = taskflow.emplace(record('A'), record('B'), record('C'));
+  A.precede(B);
+  B.precede(C);
+  REQUIRE(taskflow.fuse() == 2);
+
+  // a new successor of a middle task must run
+  auto D = taskflow.emplace(record('D'));
+  B.precede(D);
+  executor.run(taskflow).wait();
+  REQUIRE(order.size() == 4);
+
+  // a new dependent of a middle task must finish before it
+  auto X = taskflow.emplace([&, rec=record('X')](){
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    rec();
+  });
+  X.precede(C);
+
+  for(int r=0; r<10; r++) {
+    order.clear();
+    executor.run(taskflow).wait();
+    REQUIRE(order.size() == 5);
+    auto x = std::find(order.begin(), order.end(), 'X');
+    auto c = std::find(order.begin(), order.end(), 'C');
+    REQUIRE(x < c);
+  }
+
+  // a new successor of the head runs the rest of the chain on its own
+  auto E = taskflow.emplace(record('E'));
+  A.precede(E);
+  order.clear();
+  executor.run(taskflow).wait();
+  REQUIRE(order.size() == 6);
+}
+
+TEST_CASE("Fuse.ChangedEdges.1thread" * doctest::timeout(300)) {
+  fuse_changed_edges(1);
+}
+
+TEST_CASE("Fuse.ChangedEdges.4threads" * doctest::timeout(300)) {
+  fuse_changed_edges(4);
+}
@@ -0,0 +1,198 @@
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include <doctest/doctest.h>
+#include <dubhe/taskflow.h>
+
+// --------------------------------------------------------
+// Testcase: Future.Then
+// --------------------------------------------------------
+
+void then(size_t W) {
+
+  dubhe::Executor executor(W);
+
+  // chain of asynchronous tasks
+  auto fu = executor.async([](){ return 1; })
+                    .then([](int v){ return v + 1; })
+                    .then([](int v){ return std::to_string(v); });
+  REQUIRE(fu.get() == "2");
+
+  // continuation of a void future
+  std::atomic<int> counter {0};
+  executor.async([&](){ counter++; }).then([&](){ counter++; }).get();
+  REQUIRE(counter == 2);
+
+  // continuation of a run, added before and after the run finishes
+  dubhe::Taskflow taskflow;
+  for(int i=0; i<100; ++i) {
+    taskflow.emplace([&](){ counter++; });
+  }
+  for(int i=0; i<10; ++i) {
+    counter = 0;
+    auto run = executor.run(taskflow);
+    if(i % 2) {
+      run.wait();
+    }
+    REQUIRE(run.then([&](){ return counter.load(); }).get() == 100);
+  }
+
+  // continuation of an empty run
+  dubhe::Taskflow empty;
+  REQUIRE(executor.run(empty).then([](){ return 7; }).get() == 7);
+
+  // many continuations at once
+  std::vector<dubhe::Future<int>> futures;
+  for(int i=0; i<1000; ++i) {
+    futures.push_back(executor.async([i](){ return i; }).then([](int v){ return 2*v; }));
+  }
+  for(int i=0; i<1000; ++i) {
+    REQUIRE(futures[i].get() == 2*i);
+  }
+
+  executor.wait_for_all();
+  REQUIRE(executor.num_pending() == 0);
+}
+
+TEST_CASE("Future.Then.1thread" * doctest::timeout(300)) {
+  then(1);
+}
+
+TEST_CASE("Future.Then.4threads" * doctest::timeout(300)) {
+  then(4);
+}
+
+// exceptions skip the continuation and go to its future
+TEST_CASE("Future.Then.Exception" * doctest::timeout(300)) {
+
+  dubhe::Executor executor(2);
+  std::atomic<int> counter {0};
+
+  auto fu = executor.async([]() -> int { throw std::runtime_error("x"); })
+                    .then([&](int v){ counter++; return v; });
+
+  REQUIRE_THROWS_AS(fu.get(), std::runtime_error);
+  REQUIRE(counter == 0);
+
+  // a future of no executor continues inline
+  dubhe::Future<int> invalid;
+  REQUIRE_THROWS_AS(invalid.then([](int v){ return v; }).get(), std::future_error);
+}
+
+// --------------------------------------------------------
+// Testcase: Future.WhenAll
+// --------------------------------------------------------
+
+void when_all(size_t W) {
+
+  dubhe::Executor executor(W);
+
+  for(size_t n : {0, 1, 2, 10, 1000}) {
+
+    std::vector<dubhe::Future<int>> futures;
+    for(size_t i=0; i<n; ++i) {
+      futures.push_back(executor.async([i](){ return static_cast<int>(i); }));
+    }
+
+    auto sum = dubhe::when_all(futures.begin(), futures.end()).then([](auto ready){
+      int s = 0;
+      for(auto& fu : ready) {
+        REQUIRE(fu.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+        s += fu.get();
+      }
+      return s;
+    });
+
+    REQUIRE(sum.get() == static_cast<int>(n*(n-1)/2));
+  }
+
+  // runs of different taskflows
+  dubhe::Taskflow taskflow1, taskflow2;
+  std::atomic<int> counter {0};
+  taskflow1.emplace([&](){ counter++; });
+  taskflow2.emplace([&](){ counter++; });
+
+  std::vector<dubhe::Future<void>> runs;
+  runs.push_back(executor.run_n(taskflow1, 10));
+  runs.push_back(executor.run_n(taskflow2, 10));
+  dubhe::when_all(runs.begin(), runs.end()).get();
+  REQUIRE(counter == 20);
+}
+
+TEST_CASE("Future.WhenAll.1thread" * doctest::timeout(300)) {
+  when_all(1);
+}
+
+TEST_CASE("Future.WhenAll.4threads" * doctest::timeout(300)) {
+  when_all(4);
+}
+
+// --------------------------------------------------------
+// Testcase: Future.WhenAny
+// --------------------------------------------------------
+
+void when_any(size_t W) {
+
+  dubhe::Executor executor(W);
+
+  // a long task on one worker does not hold up the result of another
+  if(W > 1) {
+
+    std::atomic<bool> stop {false};
+
+    std::vector<dubhe::Future<int>> futures;
+    futures.push_back(executor.async([&](){
+      while(!stop);
+      return 0;
+    }));
+    futures.push_back(executor.async([](){ return 1; }));
+
+    auto result = dubhe::when_any(futures.begin(), futures.end()).get();
+
+    REQUIRE(result.index == 1);
+    REQUIRE(result.futures.size() == 2);
+    REQUIRE(result.futures[1].get() == 1);
+
+    stop = true;
+    executor.wait_for_all();
+  }
+
+  // exactly one of many ready futures wins
+  for(int n=1; n<=100; ++n) {
+    std::vector<dubhe::Future<int>> futures;
+    for(int i=0; i<n; ++i) {
+      futures.push_back(executor.async([i](){ return i; }));
+    }
+    auto result = dubhe::when_any(futures.begin(), futures.end()).get();
+    REQUIRE(result.index < static_cast<size_t>(n));
+    REQUIRE(result.futures[result.index].get() == static_cast<int>(result.index));
+  }
+
+  std::vector<dubhe::Future<int>> none;
+  REQUIRE(dubhe::when_any(none.begin(), none.end()).get().index == static_cast<size_t>(-1));
+}
+
+TEST_CASE("Future.WhenAny.1thread" * doctest::timeout(300)) {
+  when_any(1);
+}
+
+TEST_CASE("Future.WhenAny.4threads" * doctest::timeout(300)) {
+  when_any(4);
+}
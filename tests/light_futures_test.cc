@@ -0,0 +1,174 @@
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include <doctest/doctest.h>
+#include <dubhe/taskflow.h>
+
+// --------------------------------------------------------
+// Testcase: LightFuture.Async
+// --------------------------------------------------------
+
+void light_async(size_t W) {
+
+  dubhe::Executor executor(W);
+
+  std::vector<dubhe::LightFuture<int>> futures;
+  for(int i=0; i<1000; ++i) {
+    futures.push_back(executor.async(dubhe::light_future, [i](){ return i; }));
+  }
+  for(int i=0; i<1000; ++i) {
+    REQUIRE(futures[i].valid());
+    REQUIRE(futures[i].get() == i);
+    REQUIRE(!futures[i].valid());
+  }
+
+  // void results and task parameters
+  std::atomic<int> counter {0};
+  std::vector<dubhe::LightFuture<void>> voids;
+  for(int i=0; i<1000; ++i) {
+    voids.push_back(executor.async(dubhe::light_future, "light", [&](){ counter++; }));
+  }
+  for(auto& fu : voids) {
+    fu.wait();
+    REQUIRE(fu.is_ready());
+    fu.get();
+  }
+  REQUIRE(counter == 1000);
+
+  // move-only results
+  auto ptr = executor.async(dubhe::light_future, [](){
+    return std::make_unique<int>(7);
+  });
+  REQUIRE(*ptr.get() == 7);
+
+  // dropped futures leave their tasks running
+  counter = 0;
+  for(int i=0; i<1000; ++i) {
+    executor.async(dubhe::light_future, [&](){ counter++; return std::string(100, 'x'); });
+  }
+  executor.wait_for_all();
+  REQUIRE(counter == 1000);
+}
+
+TEST_CASE("LightFuture.Async.1thread" * doctest::timeout(300)) {
+  light_async(1);
+}
+
+TEST_CASE("LightFuture.Async.2threads" * doctest::timeout(300)) {
+  light_async(2);
+}
+
+TEST_CASE("LightFuture.Async.4threads" * doctest::timeout(300)) {
+  light_async(4);
+}
+
+// --------------------------------------------------------
+// Testcase: LightFuture.Exception
+// --------------------------------------------------------
+
+void light_exception(size_t W) {
+
+  dubhe::Executor executor(W);
+
+  auto fu = executor.async(dubhe::light_future, [](){
+    throw std::runtime_error("x");
+    return 1;
+  });
+  REQUIRE_THROWS_WITH_AS(fu.get(), "x", std::runtime_error);
+
+  // a moved-from future has no state
+  auto a = executor.async(dubhe::light_future, [](){});
+  auto b = std::move(a);
+  REQUIRE(!a.valid());
+  REQUIRE_THROWS_AS(a.get(), std::future_error);
+  b.get();
+
+  // exceptions of a run
+  dubhe::Taskflow taskflow;
+  taskflow.emplace([](){ throw std::runtime_error("y"); });
+  REQUIRE_THROWS_WITH_AS(
+    executor.run(dubhe::light_future, taskflow).get(), "y", std::runtime_error
+  );
+}
+
+TEST_CASE("LightFuture.Exception.1thread" * doctest::timeout(300)) {
+  light_exception(1);
+}
+
+TEST_CASE("LightFuture.Exception.4threads" * doctest::timeout(300)) {
+  light_exception(4);
+}
+
+// --------------------------------------------------------
+// Testcase: LightFuture.Run
+// --------------------------------------------------------
+
+void light_run(size_t W) {
+
+  dubhe::Executor executor(W);
+
+  std::atomic<int> counter {0};
+  dubhe::Taskflow taskflow;
+  for(int i=0; i<100; ++i) {
+    taskflow.emplace([&](){ counter++; });
+  }
+
+  for(int i=0; i<100; ++i) {
+    executor.run(dubhe::light_future, taskflow).get();
+  }
+  REQUIRE(counter == 100*100);
+
+  // runs of the same taskflow queue up behind each other
+  counter = 0;
+  std::vector<dubhe::LightFuture<void>> futures;
+  for(int i=0; i<100; ++i) {
+    futures.push_back(executor.run(dubhe::light_future, taskflow));
+  }
+  for(auto& fu : futures) {
+    fu.wait();
+  }
+  REQUIRE(counter == 100*100);
+
+  // dropped futures of runs
+  for(int i=0; i<10; ++i) {
+    executor.run(dubhe::light_future, taskflow);
+  }
+  executor.wait_for_all();
+  REQUIRE(counter == 110*100);
+
+  // empty runs are ready at once
+  dubhe::Taskflow empty;
+  auto fu = executor.run(dubhe::light_future, empty);
+  REQUIRE(fu.is_ready());
+  fu.get();
+}
+
+TEST_CASE("LightFuture.Run.1thread" * doctest::timeout(300)) {
+  light_run(1);
+}
+
+TEST_CASE("LightFuture.Run.2threads" * doctest::timeout(300)) {
+  light_run(2);
+}
+
+TEST_CASE("LightFuture.Run.4threads" * doctest::timeout(300)) {
+  light_run(4);
+}
@@ -259,6 +259,34 @@ TEST_CASE("parallel_moved_runs") {
   REQUIRE(counter == 32*(N*2 + 4));
 }
 
+// --------------------------------------------------------
+// Testcase: move_only_tasks
+// --------------------------------------------------------
 
+TEST_CASE("move_only_tasks") {
 
+  dubhe::Executor executor;
+  dubhe::Taskflow taskflow;
+
+  std::atomic<int> counter {0};
 
+  auto a = taskflow.emplace([p=std::make_unique<int>(1), &counter](){ counter += *p; });
+  auto b = taskflow.emplace([p=std::make_unique<int>(2), &counter](dubhe::Runtime&){
+    counter += *p;
+  });
+  auto c = taskflow.emplace([p=std::make_unique<int>(0)](){ return *p; });
+  auto d = taskflow.emplace([p=std::make_unique<int>(4), &counter](){ counter += *p; });
+  a.precede(b);
+  b.precede(c);
+  c.precede(d);
+
+  executor.run(taskflow).wait();
+  REQUIRE(counter == 7);
+
+  // asynchronous tasks
+  executor.silent_async([p=std::make_unique<int>(8), &counter](){ counter += *p; });
+  auto fu = executor.async([p=std::make_unique<int>(16)](){ return *p; });
+  REQUIRE(fu.get() == 16);
+  executor.wait_for_all();
+  REQUIRE(counter == 15);
+}
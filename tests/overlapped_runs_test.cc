@@ -0,0 +1,257 @@
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include <doctest/doctest.h>
+#include <dubhe/taskflow.h>
+
+// --------------------------------------------------------
+// Testcase: OverlappedRun.Order
+// --------------------------------------------------------
+
+void overlapped_order(size_t W, size_t K) {
+
+  dubhe::Executor executor(W);
+  dubhe::Taskflow taskflow;
+
+  const size_t N = 100;
+  const size_t M = 8;
+
+  // runs[i] counts the finished iterations of task i
+  std::vector<std::atomic<size_t>> runs(M);
+  std::atomic<bool> ok {true};
+
+  // a diamond: 0 -> {1..M-2} -> M-1
+  std::vector<dubhe::Task> tasks;
+  for(size_t i=0; i<M; ++i) {
+    tasks.push_back(taskflow.emplace([&, i](){
+      auto j = runs[i].load();
+      if(i > 0 && i < M-1 && runs[0].load() < j + 1) {
+        ok = false;
+      }
+      if(i == M-1) {
+        for(size_t k=1; k<M-1; ++k) {
+          if(runs[k].load() < j + 1) {
+            ok = false;
+          }
+        }
+      }
+      runs[i]++;
+    }));
+  }
+  for(size_t i=1; i<M-1; ++i) {
+    tasks[0].precede(tasks[i]);
+    tasks[i].precede(tasks[M-1]);
+  }
+
+  executor.run_n_overlapped(taskflow, N, K).wait();
+
+  REQUIRE(ok);
+  for(size_t i=0; i<M; ++i) {
+    REQUIRE(runs[i] == N);
+  }
+
+  // the taskflow runs normally afterwards
+  executor.run(taskflow).wait();
+  REQUIRE(ok);
+  for(size_t i=0; i<M; ++i) {
+    REQUIRE(runs[i] == N + 1);
+  }
+}
+
+TEST_CASE("OverlappedRun.Order.1thread" * doctest::timeout(300)) {
+  for(size_t K=1; K<=4; ++K) {
+    overlapped_order(1, K);
+  }
+}
+
+TEST_CASE("OverlappedRun.Order.2threads" * doctest::timeout(300)) {
+  for(size_t K=1; K<=4; ++K) {
+    overlapped_order(2, K);
+  }
+}
+
+TEST_CASE("OverlappedRun.Order.4threads" * doctest::timeout(300)) {
+  for(size_t K=1; K<=4; ++K) {
+    overlapped_order(4, K);
+  }
+}
+
+// --------------------------------------------------------
+// Testcase: OverlappedRun.Window
+// --------------------------------------------------------
+
+void overlapped_window(size_t W, size_t K) {
+
+  dubhe::Executor executor(W);
+  dubhe::Taskflow taskflow;
+
+  const size_t N = 50;
+
+  // a source feeds a slow sink; no iteration may start before the
+  // iteration K earlier has finished
+  std::atomic<size_t> sources {0}, sinks {0};
+  std::atomic<size_t> max_ahead {0};
+
+  auto source = taskflow.emplace([&](){
+    auto ahead = sources.fetch_add(1) - sinks.load();
+    auto prev = max_ahead.load();
+    while(ahead > prev && !max_ahead.compare_exchange_weak(prev, ahead));
+  });
+  auto sink = taskflow.emplace([&](){
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+    sinks++;
+  });
+  source.precede(sink);
+
+  executor.run_n_overlapped(taskflow, N, K).wait();
+
+  REQUIRE(sources == N);
+  REQUIRE(sinks == N);
+  REQUIRE(max_ahead <= K);
+
+  // with more than one worker, the sources run ahead of the slow sinks
+  if(W > 1 && K > 1) {
+    REQUIRE(max_ahead > 0);
+  }
+}
+
+TEST_CASE("OverlappedRun.Window.1thread" * doctest::timeout(300)) {
+  overlapped_window(1, 1);
+  overlapped_window(1, 3);
+}
+
+TEST_CASE("OverlappedRun.Window.4threads" * doctest::timeout(300)) {
+  overlapped_window(4, 1);
+  overlapped_window(4, 2);
+  overlapped_window(4, 8);
+}
+
+// --------------------------------------------------------
+// Testcase: OverlappedRun.PrecedeNext
+// --------------------------------------------------------
+
+void overlapped_precede_next(size_t W) {
+
+  dubhe::Executor executor(W);
+  dubhe::Taskflow taskflow;
+
+  const size_t N = 100;
+
+  // the value carried from one iteration to the next
+  size_t carried = 0;
+  std::atomic<size_t> reads {0}, writes {0};
+  std::atomic<bool> ok {true};
+
+  auto read = taskflow.emplace([&](){
+    if(writes.load() != reads.load()) {
+      ok = false;
+    }
+    reads++;
+  });
+  auto work = taskflow.emplace([](){});
+  auto write = taskflow.emplace([&](){
+    carried++;
+    writes++;
+  });
+
+  read.precede(work);
+  work.precede(write);
+  write.precede_next(read);
+
+  executor.run_n_overlapped(taskflow, N, 4).wait();
+
+  REQUIRE(ok);
+  REQUIRE(carried == N);
+}
+
+TEST_CASE("OverlappedRun.PrecedeNext.1thread" * doctest::timeout(300)) {
+  overlapped_precede_next(1);
+}
+
+TEST_CASE("OverlappedRun.PrecedeNext.4threads" * doctest::timeout(300)) {
+  overlapped_precede_next(4);
+}
+
+// --------------------------------------------------------
+// Testcase: OverlappedRun.Exception
+// --------------------------------------------------------
+
+void overlapped_exception(size_t W) {
+
+  dubhe::Executor executor(W);
+  dubhe::Taskflow taskflow;
+
+  std::atomic<size_t> counter {0};
+
+  auto a = taskflow.emplace([&](){
+    if(counter++ == 10) {
+      throw std::runtime_error("x");
+    }
+  });
+  auto b = taskflow.emplace([](dubhe::Runtime&){});
+  a.precede(b);
+  taskflow.placeholder().succeed(b);
+
+  auto future = executor.run_n_overlapped(taskflow, 1000, 2);
+  REQUIRE_THROWS_WITH_AS(future.get(), "x", std::runtime_error);
+  REQUIRE(counter < 1000);
+
+  // unsupported tasks
+  taskflow.emplace([](){ return 0; });
+  REQUIRE_THROWS(executor.run_n_overlapped(taskflow, 10, 2));
+}
+
+TEST_CASE("OverlappedRun.Exception.1thread" * doctest::timeout(300)) {
+  overlapped_exception(1);
+}
+
+TEST_CASE("OverlappedRun.Exception.4threads" * doctest::timeout(300)) {
+  overlapped_exception(4);
+}
+
+// --------------------------------------------------------
+// Testcase: OverlappedRun.Future
+// --------------------------------------------------------
+
+TEST_CASE("OverlappedRun.Future" * doctest::timeout(300)) {
+
+  dubhe::Executor executor(2);
+  dubhe::Taskflow taskflow;
+
+  // empty runs are ready at once
+  executor.run_n_overlapped(taskflow, 10, 2).get();
+
+  std::atomic<size_t> counter {0};
+  taskflow.emplace([&](){ counter++; });
+  executor.run_n_overlapped(taskflow, 0, 2).get();
+  REQUIRE(counter == 0);
+
+  // continuations run after the last iteration
+  auto fu = executor.run_n_overlapped(taskflow, 100, 3).then([&](){
+    return counter.load();
+  });
+  REQUIRE(fu.get() == 100);
+
+  // wait_for_all covers overlapped runs
+  executor.run_n_overlapped(taskflow, 100, 3);
+  executor.wait_for_all();
+  REQUIRE(counter == 200);
+}
@@ -124,7 +124,444 @@ TEST_CASE("RandomPriority.Parallel" * doctest::timeout(300)) {
 
 }
 
+TEST_CASE("Priority.Buckets" * doctest::timeout(300)) {
 
+  const auto MAX_P = static_cast<unsigned>(dubhe::TaskPriority::MAX);
+
+  REQUIRE(dubhe::priority_bucket(0) == 0);
+  REQUIRE(dubhe::priority_bucket(MAX_P-1) == DUBHE_NUM_PRIORITY_BUCKETS-1);
+  REQUIRE(dubhe::priority_bucket(MAX_P) == DUBHE_NUM_PRIORITY_BUCKETS-1);
+
+  // the named levels fall into distinct buckets
+  auto H = dubhe::priority_bucket(static_cast<unsigned>(dubhe::TaskPriority::HIGH));
+  auto N = dubhe::priority_bucket(static_cast<unsigned>(dubhe::TaskPriority::NORMAL));
+  auto L = dubhe::priority_bucket(static_cast<unsigned>(dubhe::TaskPriority::LOW));
+  REQUIRE(H < N);
+  REQUIRE(N < L);
+
+  // the buckets split the range evenly and monotonically
+  std::vector<size_t> counts(DUBHE_NUM_PRIORITY_BUCKETS, 0);
+  for(unsigned p=0; p<MAX_P; p++) {
+    counts[dubhe::priority_bucket(p)]++;
+    if(p) {
+      REQUIRE(dubhe::priority_bucket(p-1) <= dubhe::priority_bucket(p));
+    }
+  }
+  for(auto c : counts) {
+    REQUIRE(c == MAX_P / DUBHE_NUM_PRIORITY_BUCKETS);
+  }
+}
+
+TEST_CASE("Priority.NumericLevels" * doctest::timeout(300)) {
+
+  dubhe::Executor executor(1);
+  dubhe::Taskflow taskflow;
+
+  const auto MAX_P = static_cast<unsigned>(dubhe::TaskPriority::MAX);
+
+  std::vector<unsigned> order;
+
+  auto beg = taskflow.emplace([&](){ order.clear(); });
+  auto end = taskflow.emplace([](){});
+
+  for(size_t i=0; i<1000; i++) {
+    unsigned p = ::rand() % MAX_P;
+    auto t = taskflow.emplace([p, &order](){ order.push_back(p); })
+                     .priority(static_cast<dubhe::TaskPriority>(p))
+                     .succeed(beg)
+                     .precede(end);
+    REQUIRE(static_cast<unsigned>(t.priority()) == p);
+  }
+
+  executor.run_n(taskflow, 4).wait();
+
+  // a single worker runs the buckets in order
+  REQUIRE(order.size() == 1000);
+  for(size_t i=1; i<order.size(); i++) {
+    REQUIRE(dubhe::priority_bucket(order[i-1]) <= dubhe::priority_bucket(order[i]));
+  }
+}
+
+// Procedure: priority_aging
+// runs one low-priority task among many high-priority ones on a single
+// worker and returns the position at which the low-priority task ran
+size_t priority_aging(size_t K) {
+
+  dubhe::ExecutorOptions options;
+  options.priority_aging = K;
+
+  dubhe::Executor executor(1, options);
+  dubhe::Taskflow taskflow;
+
+  const size_t N = 1000;
+  size_t counter = 0;
+  size_t position = 0;
 
+  auto src = taskflow.emplace([](){});
+  taskflow.emplace([&](){ position = counter++; })
+          .priority(dubhe::TaskPriority::LOW)
+          .succeed(src);
 
+  for(size_t i=0; i<N; i++) {
+    taskflow.emplace([&](){ counter++; })
+            .priority(dubhe::TaskPriority::HIGH)
+            .succeed(src);
+  }
 
+  executor.run(taskflow).wait();
+  REQUIRE(counter == N+1);
+  return position;
+}
+
+TEST_CASE("Priority.Aging" * doctest::timeout(300)) {
+
+  // strict priorities run the low-priority task last
+  REQUIRE(priority_aging(0) == 1000);
+
+  // aging bounds the number of tasks that overtake it
+  for(size_t K : {1, 2, 8, 64, 512}) {
+    REQUIRE(priority_aging(K) <= K + 1);
+  }
+}
+
+TEST_CASE("Priority.Aging.Parallel" * doctest::timeout(300)) {
+
+  dubhe::ExecutorOptions options;
+  options.priority_aging = 4;
+
+  const auto MAX_P = static_cast<unsigned>(dubhe::TaskPriority::MAX);
+
+  for(size_t W=1; W<=4; W++) {
+
+    dubhe::Executor executor(W, options);
+    std::atomic<size_t> counter {0};
+
+    // graph tasks from workers and asyncs through the group queues
+    dubhe::Taskflow taskflow;
+    auto beg = taskflow.emplace([](){});
+    for(size_t i=0; i<10000; i++) {
+      taskflow.emplace([&](){ counter++; })
+              .priority(static_cast<dubhe::TaskPriority>(::rand() % MAX_P))
+              .succeed(beg);
+    }
+    executor.run(taskflow);
+
+    for(size_t i=0; i<10000; i++) {
+      dubhe::TaskParams params;
+      params.priority = ::rand() % MAX_P;
+      executor.silent_async(params, [&](){ counter++; });
+    }
+
+    executor.wait_for_all();
+    REQUIRE(counter == 20000);
+  }
+}
+
+// ----------------------------------------------------------------------------
+// Deadline
+// ----------------------------------------------------------------------------
+
+// Observer: DeadlineObserver
+// counts the tasks reported to miss their deadlines
+struct DeadlineObserver : public dubhe::ObserverInterface {
+
+  std::atomic<size_t> num_misses {0};
+
+  void set_up(size_t) override final {}
+  void on_entry(dubhe::WorkerView, dubhe::TaskView) override final {}
+  void on_exit(dubhe::WorkerView, dubhe::TaskView) override final {}
+
+  void on_deadline_miss(
+    dubhe::WorkerView, dubhe::TaskView, std::chrono::steady_clock::time_point d
+  ) override final {
+    REQUIRE(d < std::chrono::steady_clock::now());
+    num_misses++;
+  }
+};
+
+TEST_CASE("Deadline.EarliestFirst" * doctest::timeout(300)) {
+
+  dubhe::Executor executor(1);
+  dubhe::Taskflow taskflow;
+
+  auto now = std::chrono::steady_clock::now();
+  std::vector<std::chrono::steady_clock::time_point> order;
+
+  auto src = taskflow.emplace([&](){ order.clear(); });
+
+  for(size_t i=0; i<1000; i++) {
+    auto d = now + std::chrono::hours(1) + std::chrono::milliseconds(::rand() % 1000);
+    auto t = taskflow.emplace([&order, d](){ order.push_back(d); })
+                     .deadline(d)
+                     .succeed(src);
+    REQUIRE(t.deadline() == d);
+  }
+
+  // tasks without deadlines come after all tasks with deadlines
+  for(size_t i=0; i<100; i++) {
+    taskflow.emplace([&order](){
+      order.push_back(std::chrono::steady_clock::time_point::max());
+    }).succeed(src);
+  }
+
+  executor.run_n(taskflow, 4).wait();
+
+  // no successor with a deadline runs right after its predecessor ahead
+  // of the earliest-deadline-first order
+  REQUIRE(order.size() == 1100);
+  for(size_t i=1; i<order.size(); i++) {
+    REQUIRE(order[i-1] <= order[i]);
+  }
+  REQUIRE(executor.num_deadline_misses() == 0);
+}
+
+TEST_CASE("Deadline.Run" * doctest::timeout(300)) {
+
+  dubhe::Executor executor(2);
+  auto observer = executor.make_observer<DeadlineObserver>();
+
+  dubhe::Taskflow taskflow;
+  std::atomic<size_t> counter {0};
+  auto src = taskflow.emplace([&](){ counter++; });
+  for(size_t i=0; i<100; i++) {
+    taskflow.emplace([&](){ counter++; }).succeed(src);
+  }
+
+  // no task misses a far deadline
+  executor.run(taskflow, std::chrono::steady_clock::now() + std::chrono::hours(1)).wait();
+  REQUIRE(counter == 101);
+  REQUIRE(observer->num_misses == 0);
+
+  // every task misses a passed deadline of the run
+  executor.run(taskflow, std::chrono::steady_clock::now() - std::chrono::seconds(1)).wait();
+  REQUIRE(counter == 202);
+  REQUIRE(observer->num_misses == 101);
+  REQUIRE(executor.num_deadline_misses() == 101);
+
+  // the deadline of a task overrides the one of the run
+  src.deadline(std::chrono::steady_clock::now() + std::chrono::hours(1));
+  executor.run(std::move(taskflow), std::chrono::steady_clock::now() - std::chrono::seconds(1)).wait();
+  REQUIRE(counter == 303);
+  REQUIRE(observer->num_misses == 201);
+
+  // a run without deadline has no misses
+  dubhe::Taskflow taskflow2;
+  taskflow2.emplace([&](){ counter++; });
+  executor.run(taskflow2).wait();
+  REQUIRE(observer->num_misses == 201);
+}
+
+TEST_CASE("Deadline.Async" * doctest::timeout(300)) {
+
+  for(size_t W=1; W<=4; W++) {
+
+    dubhe::Executor executor(W);
+    auto observer = executor.make_observer<DeadlineObserver>();
+
+    std::atomic<size_t> counter {0};
+
+    dubhe::TaskParams params;
+    params.deadline = std::chrono::steady_clock::now() - std::chrono::seconds(1);
+
+    for(size_t i=0; i<1000; i++) {
+      executor.silent_async(params, [&](){ counter++; });
+    }
+    executor.silent_async_bulk(params, 0, 1000, [&](size_t){ counter++; });
+    executor.async(params, [&](){ counter++; }).get();
+    executor.wait_for_all();
+
+    REQUIRE(counter == 2001);
+    REQUIRE(observer->num_misses == 2001);
+
+    // tasks with and without deadlines from inside the executor
+    params.deadline = std::chrono::steady_clock::now() + std::chrono::hours(1);
+    for(size_t i=0; i<100; i++) {
+      executor.silent_async([&, params](){
+        counter++;
+        for(size_t j=0; j<10; j++) {
+          executor.silent_async(params, [&](){ counter++; });
+          executor.silent_async([&](){ counter++; });
+        }
+      });
+    }
+    executor.wait_for_all();
+    REQUIRE(counter == 2001 + 2100);
+    REQUIRE(observer->num_misses == 2001);
+  }
+}
+
+// --------------------------------------------------------
+// Testcase: CriticalPath
+// --------------------------------------------------------
+
+TEST_CASE("CriticalPath.Ranks" * doctest::timeout(300)) {
+
+  dubhe::Taskflow taskflow;
+
+  auto [A, B, C, D] = taskflow.emplace(
+    [](){}, [](){}, [](){}, [](){}
+  );
+
+  A.precede(B);
+  B.precede(C);
+
+  REQUIRE(taskflow.prioritize() == 3);
+  REQUIRE(A.priority() == dubhe::TaskPriority::HIGH);
+  REQUIRE(static_cast<unsigned>(B.priority()) == 85);
+  REQUIRE(static_cast<unsigned>(C.priority()) == 170);
+  REQUIRE(static_cast<unsigned>(D.priority()) == 170);
+
+  // priorities overwritten by hand are restored by the pass
+  A.priority(dubhe::TaskPriority::LOW);
+  REQUIRE(taskflow.prioritize() == 3);
+  REQUIRE(A.priority() == dubhe::TaskPriority::HIGH);
+
+  // an empty taskflow has no critical path
+  dubhe::Taskflow empty;
+  REQUIRE(empty.prioritize() == 0);
+}
+
+TEST_CASE("CriticalPath.CostHints" * doctest::timeout(300)) {
+
+  dubhe::Taskflow taskflow;
+
+  auto [A, B, C] = taskflow.emplace([](){}, [](){}, [](){});
+
+  A.precede(B);
+
+  REQUIRE(A.cost() == 1);
+  C.cost(10);
+  REQUIRE(C.cost() == 10);
+
+  REQUIRE(taskflow.prioritize() == 10);
+  REQUIRE(C.priority() == dubhe::TaskPriority::HIGH);
+  REQUIRE(static_cast<unsigned>(A.priority()) == 204);
+  REQUIRE(static_cast<unsigned>(B.priority()) == 229);
+
+  // costs of zero rank a task with its successors
+  A.cost(0);
+  B.cost(0);
+  C.cost(0);
+  REQUIRE(taskflow.prioritize() == 0);
+  REQUIRE(A.priority() == dubhe::TaskPriority::HIGH);
+  REQUIRE(C.priority() == dubhe::TaskPriority::HIGH);
+}
+
+TEST_CASE("CriticalPath.DeepChain" * doctest::timeout(300)) {
+
+  const size_t N = 100000;
+
+  dubhe::Executor executor;
+  dubhe::Taskflow taskflow;
+
+  size_t counter = 0;
+  std::vector<dubhe::Task> tasks;
+
+  for(size_t i=0; i<N; i++) {
+    tasks.push_back(taskflow.emplace([&](){ counter++; }));
+    if(i) {
+      tasks[i-1].precede(tasks[i]);
+    }
+  }
+
+  REQUIRE(taskflow.prioritize() == N);
+  REQUIRE(tasks.front().priority() == dubhe::TaskPriority::HIGH);
+  REQUIRE(static_cast<unsigned>(tasks.back().priority()) == 254);
+
+  executor.run(taskflow).wait();
+  REQUIRE(counter == N);
+}
+
+TEST_CASE("CriticalPath.Order" * doctest::timeout(300)) {
+
+  dubhe::Executor executor(1);
+  dubhe::Taskflow taskflow;
+
+  std::vector<std::string> order;
+
+  auto S = taskflow.emplace([&](){ order.push_back("S"); });
+  auto E = taskflow.emplace([&](){ order.push_back("E"); });
+
+  // short tasks off the chain are created first and would run first
+  // without priorities
+  for(int i=0; i<8; i++) {
+    taskflow.emplace([&](){ order.push_back("Y"); }).succeed(S).precede(E);
+  }
+
+  dubhe::Task prev = S;
+  for(int i=1; i<=4; i++) {
+    auto X = taskflow.emplace([&, i](){ order.push_back("X" + std::to_string(i)); });
+    prev.precede(X);
+    prev = X;
+  }
+  prev.precede(E);
+
+  REQUIRE(taskflow.prioritize() == 6);
+
+  for(int r=0; r<10; r++) {
+    order.clear();
+    executor.run(taskflow).wait();
+    REQUIRE(order.size() == 14);
+    REQUIRE(order[0] == "S");
+    REQUIRE(order[1] == "X1");
+    REQUIRE(order[2] == "X2");
+    REQUIRE(order[3] == "X3");
+    REQUIRE(order[13] == "E");
+  }
+}
+
+TEST_CASE("CriticalPath.Condition" * doctest::timeout(300)) {
+
+  dubhe::Executor executor;
+  dubhe::Taskflow taskflow;
+
+  int i = 0;
+
+  auto init = taskflow.emplace([&](){ i = 0; });
+  auto cond = taskflow.emplace([&](){ return ++i < 5 ? 0 : 1; });
+  auto stop = taskflow.emplace([](){});
+
+  init.precede(cond);
+  cond.precede(cond, stop);
+
+  REQUIRE(taskflow.prioritize() == 3);
+  REQUIRE(init.priority() == dubhe::TaskPriority::HIGH);
+
+  executor.run(taskflow).wait();
+  REQUIRE(i == 5);
+}
+
+TEST_CASE("CriticalPath.Observer" * doctest::timeout(300)) {
+
+  dubhe::Executor executor(2);
+  dubhe::Taskflow taskflow;
+
+  auto observer = executor.make_observer<dubhe::TFProfObserver>();
+
+  auto slow = taskflow.emplace([](){
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }).name("slow");
+
+  auto [A, B, C] = taskflow.emplace([](){}, [](){}, [](){});
+  A.name("A").precede(B);
+  B.name("B").precede(C);
+  C.name("C");
+
+  // the hints favor the chain but the measurements favor the slow task
+  A.cost(1000);
+  B.cost(1000);
+  C.cost(1000);
+  REQUIRE(taskflow.prioritize() == 3000);
+  REQUIRE(A.priority() == dubhe::TaskPriority::HIGH);
+
+  executor.run_n(taskflow, 3).wait();
+
+  auto durations = observer->durations();
+  REQUIRE(durations.size() == 4);
+  REQUIRE(durations.at("slow") >= std::chrono::milliseconds(5));
+
+  auto critical = taskflow.prioritize(*observer);
+  REQUIRE(critical >= 5000000);
+  REQUIRE(slow.priority() == dubhe::TaskPriority::HIGH);
+  REQUIRE(static_cast<unsigned>(A.priority()) > 200);
+}
@@ -298,6 +298,23 @@ TEST_CASE("Reduce.Random.12threads" * doctest::timeout(300)) {
   reduce<dubhe::RandomPartitioner<>>(12);
 }
 
+// adaptive
+TEST_CASE("Reduce.Adaptive.1thread" * doctest::timeout(300)) {
+  reduce<dubhe::AdaptivePartitioner<>>(1);
+}
+
+TEST_CASE("Reduce.Adaptive.2threads" * doctest::timeout(300)) {
+  reduce<dubhe::AdaptivePartitioner<>>(2);
+}
+
+TEST_CASE("Reduce.Adaptive.4threads" * doctest::timeout(300)) {
+  reduce<dubhe::AdaptivePartitioner<>>(4);
+}
+
+TEST_CASE("Reduce.Adaptive.8threads" * doctest::timeout(300)) {
+  reduce<dubhe::AdaptivePartitioner<>>(8);
+}
+
 // --------------------------------------------------------
 // Testcase: reduce_sum
 // --------------------------------------------------------
@@ -542,6 +559,23 @@ TEST_CASE("ReduceSum.Random.12threads" * doctest::timeout(300)) {
   reduce_sum<dubhe::RandomPartitioner<>>(12);
 }
 
+// adaptive
+TEST_CASE("ReduceSum.Adaptive.1thread" * doctest::timeout(300)) {
+  reduce_sum<dubhe::AdaptivePartitioner<>>(1);
+}
+
+TEST_CASE("ReduceSum.Adaptive.2threads" * doctest::timeout(300)) {
+  reduce_sum<dubhe::AdaptivePartitioner<>>(2);
+}
+
+TEST_CASE("ReduceSum.Adaptive.4threads" * doctest::timeout(300)) {
+  reduce_sum<dubhe::AdaptivePartitioner<>>(4);
+}
+
+TEST_CASE("ReduceSum.Adaptive.8threads" * doctest::timeout(300)) {
+  reduce_sum<dubhe::AdaptivePartitioner<>>(8);
+}
+
 
 // ----------------------------------------------------------------------------
 // transform_reduce
@@ -799,6 +833,23 @@ TEST_CASE("TransformReduce.Random.12threads" * doctest::timeout(300)) {
   transform_reduce<dubhe::RandomPartitioner<>>(12);
 }
 
+// adaptive
+TEST_CASE("TransformReduce.Adaptive.1thread" * doctest::timeout(300)) {
+  transform_reduce<dubhe::AdaptivePartitioner<>>(1);
+}
+
+TEST_CASE("TransformReduce.Adaptive.2threads" * doctest::timeout(300)) {
+  transform_reduce<dubhe::AdaptivePartitioner<>>(2);
+}
+
+TEST_CASE("TransformReduce.Adaptive.4threads" * doctest::timeout(300)) {
+  transform_reduce<dubhe::AdaptivePartitioner<>>(4);
+}
+
+TEST_CASE("TransformReduce.Adaptive.8threads" * doctest::timeout(300)) {
+  transform_reduce<dubhe::AdaptivePartitioner<>>(8);
+}
+
 // ----------------------------------------------------------------------------
 // Transform & Reduce on Movable Data
 // ----------------------------------------------------------------------------
@@ -969,6 +1020,23 @@ TEST_CASE("TransformReduce.MoveOnlyData.Random.4threads" * doctest::timeout(300)
   move_only_transform_reduce<dubhe::RandomPartitioner<>>(4);
 }
 
+// adaptive
+TEST_CASE("TransformReduce.MoveOnlyData.Adaptive.1thread" * doctest::timeout(300)) {
+  move_only_transform_reduce<dubhe::AdaptivePartitioner<>>(1);
+}
+
+TEST_CASE("TransformReduce.MoveOnlyData.Adaptive.2threads" * doctest::timeout(300)) {
+  move_only_transform_reduce<dubhe::AdaptivePartitioner<>>(2);
+}
+
+TEST_CASE("TransformReduce.MoveOnlyData.Adaptive.4threads" * doctest::timeout(300)) {
+  move_only_transform_reduce<dubhe::AdaptivePartitioner<>>(4);
+}
+
+TEST_CASE("TransformReduce.MoveOnlyData.Adaptive.8threads" * doctest::timeout(300)) {
+  move_only_transform_reduce<dubhe::AdaptivePartitioner<>>(8);
+}
+
 // ----------------------------------------------------------------------------
 // transform_reduce_sum
 // ----------------------------------------------------------------------------
@@ -1212,6 +1280,23 @@ TEST_CASE("TransformReduceSum.Random.12threads" * doctest::timeout(300)) {
   transform_reduce_sum<dubhe::RandomPartitioner<>>(12);
 }
 
+// adaptive
+TEST_CASE("TransformReduceSum.Adaptive.1thread" * doctest::timeout(300)) {
+  transform_reduce_sum<dubhe::AdaptivePartitioner<>>(1);
+}
+
+TEST_CASE("TransformReduceSum.Adaptive.2threads" * doctest::timeout(300)) {
+  transform_reduce_sum<dubhe::AdaptivePartitioner<>>(2);
+}
+
+TEST_CASE("TransformReduceSum.Adaptive.4threads" * doctest::timeout(300)) {
+  transform_reduce_sum<dubhe::AdaptivePartitioner<>>(4);
+}
+
+TEST_CASE("TransformReduceSum.Adaptive.8threads" * doctest::timeout(300)) {
+  transform_reduce_sum<dubhe::AdaptivePartitioner<>>(8);
+}
+
 // ----------------------------------------------------------------------------
 // binary_transform_reduce
 // ----------------------------------------------------------------------------
@@ -1461,6 +1546,23 @@ TEST_CASE("BinaryTransformReduce.Random.11thread" * doctest::timeout(300)) {
 TEST_CASE("BinaryTransformReduce.Random.12thread" * doctest::timeout(300)) {
   binary_transform_reduce<dubhe::RandomPartitioner<>>(12);
 }
+
+// adaptive
+TEST_CASE("BinaryTransformReduce.Adaptive.1thread" * doctest::timeout(300)) {
+  binary_transform_reduce<dubhe::AdaptivePartitioner<>>(1);
+}
+
+TEST_CASE("BinaryTransformReduce.Adaptive.2threads" * doctest::timeout(300)) {
+  binary_transform_reduce<dubhe::AdaptivePartitioner<>>(2);
+}
+
+TEST_CASE("BinaryTransformReduce.Adaptive.4threads" * doctest::timeout(300)) {
+  binary_transform_reduce<dubhe::AdaptivePartitioner<>>(4);
+}
+
+TEST_CASE("BinaryTransformReduce.Adaptive.8threads" * doctest::timeout(300)) {
+  binary_transform_reduce<dubhe::AdaptivePartitioner<>>(8);
+}
 // ----------------------------------------------------------------------------
 // binary_transform_reduce_sum
 // ----------------------------------------------------------------------------
@@ -1710,6 +1812,23 @@ TEST_CASE("BinaryTransformReduceSum.Random.12thread" * doctest::timeout(300)) {
   binary_transform_reduce_sum<dubhe::RandomPartitioner<>>(12);
 }
 
+// adaptive
+TEST_CASE("BinaryTransformReduceSum.Adaptive.1thread" * doctest::timeout(300)) {
+  binary_transform_reduce_sum<dubhe::AdaptivePartitioner<>>(1);
+}
+
+TEST_CASE("BinaryTransformReduceSum.Adaptive.2threads" * doctest::timeout(300)) {
+  binary_transform_reduce_sum<dubhe::AdaptivePartitioner<>>(2);
+}
+
+TEST_CASE("BinaryTransformReduceSum.Adaptive.4threads" * doctest::timeout(300)) {
+  binary_transform_reduce_sum<dubhe::AdaptivePartitioner<>>(4);
+}
+
+TEST_CASE("BinaryTransformReduceSum.Adaptive.8threads" * doctest::timeout(300)) {
+  binary_transform_reduce_sum<dubhe::AdaptivePartitioner<>>(8);
+}
+
 // ----------------------------------------------------------------------------
 // Closure Wrapper
 // ----------------------------------------------------------------------------
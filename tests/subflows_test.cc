@@ -488,3 +488,67 @@ TEST_CASE("FibSubflow.7threads") {
 TEST_CASE("FibSubflow.8threads") {
   fibonacci(8);
 }
+
+// --------------------------------------------------------
+// Testcase: Subflow.Arena
+// --------------------------------------------------------
+
+// children of subflows and runtime asynchronous tasks come from the arena
+// of the spawning worker and must survive repeated runs, detaching, and
+// the executor itself
+void subflow_arena(size_t W) {
+
+  dubhe::Taskflow taskflow;
+  std::atomic<size_t> counter {0};
+
+  std::function<void(dubhe::Subflow&, int)> spawn;
+  spawn = [&](dubhe::Subflow& sf, int d) {
+    counter.fetch_add(1, std::memory_order_relaxed);
+    if(d == 0) {
+      return;
+    }
+    for(int i=0; i<3; i++) {
+      sf.emplace([&, d](dubhe::Subflow& child){ spawn(child, d-1); });
+    }
+    for(int i=0; i<3; i++) {
+      sf.silent_async([&](){ counter.fetch_add(1, std::memory_order_relaxed); });
+    }
+    if(d % 2) {
+      sf.detach();
+    }
+  };
+
+  taskflow.emplace([&](dubhe::Subflow& sf){ spawn(sf, 6); });
+
+  // 3^0 + ... + 3^6 subflows, each non-leaf spawning three asyncs
+  const size_t expected = 1093 + 3 * 364;
+
+  {
+    dubhe::Executor executor(W);
+    for(size_t r=1; r<=3; r++) {
+      executor.run(taskflow).wait();
+      REQUIRE(counter == r * expected);
+    }
+  }
+
+  // the nodes spawned by the first executor are released by the next run
+  dubhe::Executor executor(W);
+  executor.run(taskflow).wait();
+  REQUIRE(counter == 4 * expected);
+}
+
+TEST_CASE("Subflow.Arena.1thread" * doctest::timeout(300)) {
+  subflow_arena(1);
+}
+
+TEST_CASE("Subflow.Arena.2threads" * doctest::timeout(300)) {
+  subflow_arena(2);
+}
+
+TEST_CASE("Subflow.Arena.4threads" * doctest::timeout(300)) {
+  subflow_arena(4);
+}
+
+TEST_CASE("Subflow.Arena.8threads" * doctest::timeout(300)) {
+  subflow_arena(8);
+}
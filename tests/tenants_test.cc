@@ -0,0 +1,402 @@
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include <doctest/doctest.h>
+#include <dubhe/taskflow.h>
+
+// busy-waits for the given time to consume worker time
+void spin_for(std::chrono::microseconds us) {
+  auto end = std::chrono::steady_clock::now() + us;
+  while(std::chrono::steady_clock::now() < end);
+}
+
+// --------------------------------------------------------
+// Testcase: Tenant.Basics
+// --------------------------------------------------------
+
+TEST_CASE("Tenant.Basics" * doctest::timeout(300)) {
+
+  REQUIRE_THROWS(dubhe::Tenant(0));
+
+  dubhe::Tenant tenant(2);
+  REQUIRE(tenant.weight() == 2);
+  REQUIRE(tenant.num_tasks() == 0);
+  REQUIRE(tenant.busy_time().count() == 0);
+
+  tenant.weight(5);
+  REQUIRE(tenant.weight() == 5);
+  REQUIRE_THROWS(tenant.weight(0));
+
+  dubhe::Taskflow taskflow;
+  auto task = taskflow.emplace([](){});
+  REQUIRE(task.tenant() == nullptr);
+  task.tenant(tenant);
+  REQUIRE(task.tenant() == &tenant);
+}
+
+// --------------------------------------------------------
+// Testcase: Tenant.Accounting
+// --------------------------------------------------------
+
+void tenant_accounting(size_t W) {
+
+  dubhe::Executor executor(W);
+
+  dubhe::Tenant t1, t2, t3;
+  std::atomic<size_t> counter {0};
+
+  // static and subflow tasks of a run
+  dubhe::Taskflow taskflow;
+  auto A = taskflow.emplace([&](){ counter++; });
+  auto B = taskflow.emplace([&](dubhe::Subflow& sf){
+    counter++;
+    for(size_t i=0; i<10; i++) {
+      sf.emplace([&](){ counter++; });
+    }
+  });
+  auto C = taskflow.emplace([&](){ counter++; });
+  auto D = taskflow.emplace([&](){ counter++; spin_for(std::chrono::microseconds(100)); });
+  A.precede(B, C);
+  D.succeed(B, C);
+
+  executor.run_n(taskflow, 10, t1).wait();
+  REQUIRE(counter == 140);
+  REQUIRE(t1.num_tasks() == 140);
+  REQUIRE(t1.busy_time() >= std::chrono::microseconds(1000));
+
+  // a task of its own tenant overrides the tenant of the run
+  D.tenant(t2);
+  executor.run(taskflow, t1).wait();
+  REQUIRE(counter == 154);
+  REQUIRE(t1.num_tasks() == 153);
+  REQUIRE(t2.num_tasks() == 1);
+
+  // a run without tenant charges only the tasks of their own
+  executor.run(taskflow).wait();
+  REQUIRE(counter == 168);
+  REQUIRE(t1.num_tasks() == 153);
+  REQUIRE(t2.num_tasks() == 2);
+
+  // async tasks
+  dubhe::TaskParams params;
+  params.tenant = &t3;
+  for(size_t i=0; i<100; i++) {
+    executor.silent_async(params, [&](){ counter++; });
+  }
+  executor.silent_async_bulk(params, 0, 100, [&](size_t){ counter++; });
+  executor.async(params, [&](){ counter++; }).get();
+  auto [A1, fu1] = executor.dependent_async(params, [&](){ counter++; });
+  executor.silent_dependent_async(params, [&](){ counter++; }, A1);
+  executor.wait_for_all();
+  REQUIRE(counter == 168 + 203);
+  REQUIRE(t3.num_tasks() == 203);
+}
+
+TEST_CASE("Tenant.Accounting.1thread" * doctest::timeout(300)) {
+  tenant_accounting(1);
+}
+
+TEST_CASE("Tenant.Accounting.4threads" * doctest::timeout(300)) {
+  tenant_accounting(4);
+}
+
+// a parent task is charged for its own work only, not for the time its
+// subflow children run on the same worker
+TEST_CASE("Tenant.Accounting.Subflow" * doctest::timeout(300)) {
+
+  dubhe::Executor executor(1);
+  dubhe::Tenant tenant;
+
+  dubhe::Taskflow taskflow;
+  taskflow.emplace([](dubhe::Subflow& sf){
+    for(size_t i=0; i<4; i++) {
+      sf.emplace([](){ spin_for(std::chrono::microseconds(10000)); });
+    }
+  });
+
+  // the run takes as long as its tasks on one worker, which is about half
+  // of what charging the children to the parent as well would amount to
+  auto beg = std::chrono::steady_clock::now();
+  executor.run(taskflow, tenant).wait();
+  auto wall = std::chrono::steady_clock::now() - beg;
+
+  REQUIRE(tenant.num_tasks() == 5);
+  REQUIRE(tenant.busy_time() >= std::chrono::milliseconds(40));
+  REQUIRE(tenant.busy_time() <= wall);
+
+  // children of another tenant are not charged to the parent either
+  dubhe::Tenant other;
+  taskflow.clear();
+  taskflow.emplace([&](dubhe::Subflow& sf){
+    spin_for(std::chrono::microseconds(5000));
+    for(size_t i=0; i<2; i++) {
+      sf.emplace([](){ spin_for(std::chrono::microseconds(10000)); }).tenant(other);
+    }
+  });
+
+  auto busy = tenant.busy_time();
+  beg = std::chrono::steady_clock::now();
+  executor.run(taskflow, tenant).wait();
+  wall = std::chrono::steady_clock::now() - beg;
+
+  REQUIRE(tenant.num_tasks() == 6);
+  REQUIRE(tenant.busy_time() - busy >= std::chrono::milliseconds(5));
+  REQUIRE(tenant.busy_time() - busy + other.busy_time() <= wall);
+  REQUIRE(other.num_tasks() == 2);
+  REQUIRE(other.busy_time() >= std::chrono::milliseconds(20));
+}
+
+// --------------------------------------------------------
+// Testcase: Tenant.Share
+// --------------------------------------------------------
+
+// Runs two tenants on one worker that is held back until both have
+// queued all their tasks and returns the order the tenants were served.
+std::vector<int> tenant_order(
+  dubhe::Tenant& t1, dubhe::Taskflow& f1, dubhe::Tenant& t2, dubhe::Taskflow& f2
+) {
+
+  dubhe::Executor executor(1);
+
+  std::atomic<bool> started {false};
+  std::atomic<bool> gate {false};
+  executor.silent_async([&](){ started = true; while(!gate); });
+  while(!started);
+
+  std::vector<int> order;
+  f1.for_each_task([&](dubhe::Task task){
+    task.work([&](){ order.push_back(1); spin_for(std::chrono::microseconds(20)); });
+  });
+  f2.for_each_task([&](dubhe::Task task){
+    task.work([&](){ order.push_back(2); spin_for(std::chrono::microseconds(20)); });
+  });
+
+  auto fu1 = executor.run(f1, t1);
+  auto fu2 = executor.run(f2, t2);
+  gate = true;
+  fu1.wait();
+  fu2.wait();
+
+  return order;
+}
+
+TEST_CASE("Tenant.Share.Weights" * doctest::timeout(300)) {
+
+  dubhe::Tenant t1(3), t2(1);
+  dubhe::Taskflow f1, f2;
+
+  for(size_t i=0; i<2000; i++) {
+    f1.placeholder();
+    f2.placeholder();
+  }
+
+  auto order = tenant_order(t1, f1, t2, f2);
+  REQUIRE(order.size() == 4000);
+
+  // about three quarters of the worker goes to the heavier tenant while
+  // both tenants have tasks ready
+  auto n1 = std::count(order.begin(), order.begin() + 1600, 1);
+  REQUIRE(n1 > 1000);
+  REQUIRE(n1 < 1500);
+
+  REQUIRE(t1.num_tasks() == 2000);
+  REQUIRE(t2.num_tasks() == 2000);
+}
+
+TEST_CASE("Tenant.Share.Chains" * doctest::timeout(300)) {
+
+  dubhe::Tenant t1, t2;
+  dubhe::Taskflow f1, f2;
+
+  // a linear chain does not keep the worker to its tenant
+  dubhe::Task p1, p2;
+  for(size_t i=0; i<1000; i++) {
+    auto c1 = f1.placeholder();
+    auto c2 = f2.placeholder();
+    if(i) {
+      p1.precede(c1);
+      p2.precede(c2);
+    }
+    p1 = c1;
+    p2 = c2;
+  }
+
+  auto order = tenant_order(t1, f1, t2, f2);
+  REQUIRE(order.size() == 2000);
+
+  auto n1 = std::count(order.begin(), order.begin() + 1000, 1);
+  REQUIRE(n1 > 300);
+  REQUIRE(n1 < 700);
+}
+
+TEST_CASE("Tenant.Share.Untenanted" * doctest::timeout(300)) {
+
+  dubhe::Executor executor(1);
+
+  std::atomic<bool> started {false};
+  std::atomic<bool> gate {false};
+  executor.silent_async([&](){ started = true; while(!gate); });
+  while(!started);
+
+  dubhe::Tenant tenant;
+  dubhe::Taskflow f1, f2;
+  std::vector<int> order;
+
+  for(size_t i=0; i<2000; i++) {
+    f1.emplace([&](){ order.push_back(1); });
+  }
+  for(size_t i=0; i<100; i++) {
+    f2.emplace([&](){ order.push_back(2); });
+  }
+
+  // a large tenant graph does not hold up tasks without a tenant
+  auto fu1 = executor.run(f1, tenant);
+  auto fu2 = executor.run(f2);
+  gate = true;
+  fu1.wait();
+  fu2.wait();
+
+  REQUIRE(order.size() == 2100);
+  REQUIRE(std::count(order.begin(), order.begin() + 400, 2) == 100);
+  REQUIRE(tenant.num_tasks() == 2000);
+}
+
+// --------------------------------------------------------
+// Testcase: Tenant.Parallel
+// --------------------------------------------------------
+
+TEST_CASE("Tenant.Parallel" * doctest::timeout(300)) {
+
+  for(size_t W=1; W<=8; W*=2) {
+
+    dubhe::Executor executor(W);
+
+    std::vector<std::unique_ptr<dubhe::Tenant>> tenants;
+    std::vector<dubhe::Taskflow> taskflows(8);
+    std::atomic<size_t> counter {0};
+
+    for(size_t t=0; t<taskflows.size(); t++) {
+      tenants.push_back(std::make_unique<dubhe::Tenant>(t + 1));
+      auto src = taskflows[t].emplace([](){});
+      for(size_t i=0; i<100; i++) {
+        auto m = taskflows[t].emplace([&](){ counter++; });
+        src.precede(m);
+        taskflows[t].emplace([&](dubhe::Runtime& rt){
+          rt.silent_async([&](){ counter++; });
+          rt.corun_all();
+        }).succeed(m);
+      }
+    }
+
+    std::vector<dubhe::Future<void>> futures;
+    for(size_t t=0; t<taskflows.size(); t++) {
+      futures.push_back(executor.run_n(taskflows[t], 5, *tenants[t]));
+    }
+    for(auto& fu : futures) {
+      fu.wait();
+    }
+
+    REQUIRE(counter == 8 * 5 * 200);
+    for(auto& tenant : tenants) {
+      // the async tasks spawned by a runtime belong to the tenant of the run
+      REQUIRE(tenant->num_tasks() == 5 * 301);
+    }
+  }
+}
+
+// --------------------------------------------------------
+// Testcase: Tenant.Shared
+// --------------------------------------------------------
+
+TEST_CASE("Tenant.Shared" * doctest::timeout(300)) {
+
+  // tasks held by one executor wait for tasks admitted by the other
+  dubhe::Executor executor1(2);
+  dubhe::Executor executor2(2);
+
+  dubhe::Tenant tenant;
+  dubhe::Taskflow taskflow1, taskflow2;
+  std::atomic<size_t> counter {0};
+
+  for(auto taskflow : {&taskflow1, &taskflow2}) {
+    auto src = taskflow->emplace([](){});
+    for(size_t i=0; i<100; i++) {
+      taskflow->emplace([&](){
+        std::this_thread::sleep_for(std::chrono::microseconds(10));
+        counter++;
+      }).succeed(src);
+    }
+  }
+
+  auto fu1 = executor1.run_n(taskflow1, 10, tenant);
+  auto fu2 = executor2.run_n(taskflow2, 10, tenant);
+  fu1.wait();
+  fu2.wait();
+
+  REQUIRE(counter == 2 * 10 * 100);
+  REQUIRE(tenant.num_tasks() == 2 * 10 * 101);
+}
+
+// --------------------------------------------------------
+// Testcase: Tenant.MaxPending
+// --------------------------------------------------------
+
+TEST_CASE("Tenant.MaxPending" * doctest::timeout(300)) {
+
+  dubhe::ExecutorOptions options;
+  options.backpressure.mode = dubhe::OverflowMode::FAIL;
+  dubhe::Executor executor(2, options);
+
+  dubhe::Tenant tenant;
+  tenant.max_pending(2);
+  REQUIRE(tenant.max_pending() == 2);
+
+  dubhe::TaskParams params;
+  params.tenant = &tenant;
+
+  std::atomic<bool> gate {false};
+  std::atomic<size_t> counter {0};
+
+  REQUIRE(executor.try_silent_async(params, [&](){ while(!gate); counter++; }));
+  REQUIRE(executor.try_silent_async(params, [&](){ while(!gate); counter++; }));
+  REQUIRE(tenant.num_pending() == 2);
+
+  // the tenant is full but the executor is not
+  dubhe::Taskflow taskflow;
+  taskflow.emplace([&](){ counter++; });
+  REQUIRE(executor.try_silent_async(params, [&](){ counter++; }) == false);
+  REQUIRE(executor.try_run(taskflow, tenant).has_value() == false);
+  REQUIRE_THROWS(executor.run(taskflow, tenant));
+  REQUIRE(executor.try_silent_async([&](){ counter++; }));
+  REQUIRE(executor.num_pending() == 3);
+
+  gate = true;
+  executor.wait_for_all();
+  REQUIRE(counter == 3);
+  REQUIRE(tenant.num_pending() == 0);
+
+  auto fu = executor.try_run(taskflow, tenant);
+  REQUIRE(fu.has_value());
+  fu->wait();
+  executor.wait_for_all();
+  REQUIRE(counter == 4);
+  REQUIRE(tenant.num_pending() == 0);
+  REQUIRE(executor.num_pending() == 0);
+}
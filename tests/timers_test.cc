@@ -0,0 +1,299 @@
+// Copyright (C) 2024 EA group inc.
+// Author: Jeff.li lijippy@163.com
+// All rights reserved.
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Affero General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Affero General Public License for more details.
+//
+// You should have received a copy of the GNU Affero General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include <doctest/doctest.h>
+#include <dubhe/taskflow.h>
+
+using namespace std::chrono_literals;
+
+// --------------------------------------------------------
+// Testcase: TimerWheel
+// --------------------------------------------------------
+
+TEST_CASE("TimerWheel.Order" * doctest::timeout(300)) {
+
+  dubhe::TimerWheel<int> wheel(std::chrono::microseconds(1));
+
+  auto beg = std::chrono::steady_clock::now();
+
+  // spread over all levels, including beyond the top level
+  std::vector<std::chrono::microseconds> delays = {
+    1us, 5us, 63us, 64us, 65us, 4095us, 4096us, 5000us,
+    262143us, 262144us, 300000us, 16777216us, 20000000us, 100000000us
+  };
+
+  for(size_t i=0; i<delays.size(); ++i) {
+    REQUIRE(wheel.insert(beg + delays[i], static_cast<int>(i)));
+  }
+  REQUIRE(wheel.size() == delays.size());
+
+  // a timer in the past is not kept
+  REQUIRE(wheel.insert(beg - 1s, -1) == false);
+  REQUIRE(wheel.size() == delays.size());
+
+  std::vector<int> expired;
+
+  for(size_t i=0; i<delays.size(); ++i) {
+
+    // nothing fires before its due time
+    wheel.advance(beg + delays[i] - 1us, expired);
+    REQUIRE(expired.size() == i);
+
+    // the wheel never asks to be advanced after the next timer is due
+    REQUIRE(wheel.next_due() <= beg + delays[i] + 1us);
+
+    wheel.advance(beg + delays[i] + 1us, expired);
+    REQUIRE(expired.size() == i + 1);
+    REQUIRE(expired.back() == static_cast<int>(i));
+  }
+
+  REQUIRE(wheel.empty());
+  REQUIRE(wheel.next_due() == std::chrono::steady_clock::time_point::max());
+}
+
+TEST_CASE("TimerWheel.Drain" * doctest::timeout(300)) {
+
+  dubhe::TimerWheel<int> wheel(std::chrono::milliseconds(1));
+
+  auto now = std::chrono::steady_clock::now();
+
+  for(int i=1; i<=1000; ++i) {
+    REQUIRE(wheel.insert(now + std::chrono::milliseconds(i*37), i));
+  }
+
+  std::vector<int> items;
+  wheel.drain(items);
+
+  REQUIRE(wheel.empty());
+  REQUIRE(items.size() == 1000);
+  std::sort(items.begin(), items.end());
+  for(int i=1; i<=1000; ++i) {
+    REQUIRE(items[i-1] == i);
+  }
+}
+
+TEST_CASE("TimerWheel.DrainIf" * doctest::timeout(300)) {
+
+  dubhe::TimerWheel<int> wheel(std::chrono::milliseconds(1));
+
+  auto now = std::chrono::steady_clock::now();
+
+  for(int i=1; i<=1000; ++i) {
+    REQUIRE(wheel.insert(now + std::chrono::milliseconds(i*37), i));
+  }
+
+  std::vector<int> items;
+  wheel.drain_if([](int i){ return i % 2 == 0; }, items);
+
+  REQUIRE(wheel.size() == 500);
+  REQUIRE(items.size() == 500);
+  for(auto i : items) {
+    REQUIRE(i % 2 == 0);
+  }
+
+  // the odd timers remain and expire in order
+  items.clear();
+  wheel.advance(now + std::chrono::milliseconds(1001*37), items);
+  REQUIRE(wheel.empty());
+  REQUIRE(items.size() == 500);
+  for(int i=0; i<500; ++i) {
+    REQUIRE(items[i] == 2*i + 1);
+  }
+}
+
+// --------------------------------------------------------
+// Testcase: Timer.ScheduleAfter
+// --------------------------------------------------------
+
+void schedule_after(size_t W) {
+
+  dubhe::Executor executor(W);
+
+  auto beg = std::chrono::steady_clock::now();
+
+  auto fu = executor.schedule_after(20ms, [](){
+    return std::chrono::steady_clock::now();
+  });
+
+  REQUIRE(executor.num_timers() == 1);
+
+  auto end = fu.get();
+  REQUIRE(end - beg >= 20ms);
+  REQUIRE(executor.num_timers() == 0);
+
+  // a time in the past runs right away
+  REQUIRE(executor.schedule_at(beg, [](){ return 7; }).get() == 7);
+
+  // wait_for_all waits for armed timers
+  std::atomic<size_t> counter {0};
+  for(size_t i=0; i<100; ++i) {
+    executor.schedule_after(std::chrono::microseconds(i*100), [&](){ counter++; });
+  }
+  executor.wait_for_all();
+  REQUIRE(counter == 100);
+  REQUIRE(executor.num_pending() == 0);
+}
+
+TEST_CASE("Timer.ScheduleAfter.1thread" * doctest::timeout(300)) {
+  schedule_after(1);
+}
+
+TEST_CASE("Timer.ScheduleAfter.4threads" * doctest::timeout(300)) {
+  schedule_after(4);
+}
+
+// --------------------------------------------------------
+// Testcase: Timer.Order
+// --------------------------------------------------------
+
+TEST_CASE("Timer.Order" * doctest::timeout(300)) {
+
+  dubhe::Executor executor(1);
+
+  std::mutex mutex;
+  std::vector<int> order;
+
+  // armed in reverse such that only the wheel puts them in order
+  for(int i=9; i>=0; --i) {
+    executor.schedule_after(std::chrono::milliseconds(5*i), [&, i](){
+      std::scoped_lock lock(mutex);
+      order.push_back(i);
+    });
+  }
+
+  executor.wait_for_all();
+
+  REQUIRE(order.size() == 10);
+  for(int i=0; i<10; ++i) {
+    REQUIRE(order[i] == i);
+  }
+}
+
+// --------------------------------------------------------
+// Testcase: Timer.Every
+// --------------------------------------------------------
+
+void schedule_every(size_t W) {
+
+  dubhe::Executor executor(W);
+
+  std::atomic<size_t> counter {0};
+
+  auto timer = executor.schedule_every(2ms, [&](){ counter++; });
+
+  REQUIRE(timer.empty() == false);
+  REQUIRE(timer.cancelled() == false);
+
+  while(counter < 10) {
+    std::this_thread::sleep_for(1ms);
+  }
+
+  timer.cancel();
+  REQUIRE(timer.cancelled());
+
+  // at most the run in flight completes after the cancellation
+  executor.wait_for_all();
+  auto n = counter.load();
+  std::this_thread::sleep_for(20ms);
+  executor.wait_for_all();
+  REQUIRE(counter.load() <= n + 1);
+
+  REQUIRE_THROWS(executor.schedule_every(0ms, [](){}));
+}
+
+TEST_CASE("Timer.Every.1thread" * doctest::timeout(300)) {
+  schedule_every(1);
+}
+
+TEST_CASE("Timer.Every.4threads" * doctest::timeout(300)) {
+  schedule_every(4);
+}
+
+// a periodic timer left running is dropped with the executor
+TEST_CASE("Timer.Every.Destroy" * doctest::timeout(300)) {
+  std::atomic<size_t> counter {0};
+  {
+    dubhe::Executor executor(2);
+    executor.schedule_every(1ms, [&](){ counter++; });
+    while(counter < 3) {
+      std::this_thread::sleep_for(1ms);
+    }
+  }
+  auto n = counter.load();
+  std::this_thread::sleep_for(10ms);
+  REQUIRE(counter.load() == n);
+}
+
+// the executor stops its periodic timers before it waits for the one-shot
+// timers, which still fire, and for the runs in flight
+TEST_CASE("Timer.Every.DestroyWithOneShot" * doctest::timeout(300)) {
+  for(size_t W=1; W<=4; W++) {
+    std::atomic<size_t> counter {0};
+    std::atomic<size_t> shots {0};
+    {
+      dubhe::Executor executor(W);
+      for(size_t i=0; i<4; i++) {
+        executor.schedule_every(std::chrono::microseconds(100), [&](){ counter++; });
+      }
+      for(size_t i=0; i<10; i++) {
+        executor.schedule_after(std::chrono::milliseconds(i), [&](){ shots++; });
+      }
+      while(counter < 4) {
+        std::this_thread::sleep_for(1ms);
+      }
+    }
+    REQUIRE(shots == 10);
+    auto n = counter.load();
+    std::this_thread::sleep_for(10ms);
+    REQUIRE(counter.load() == n);
+  }
+}
+
+// --------------------------------------------------------
+// Testcase: Timer.Responsive
+// --------------------------------------------------------
+
+// a pending timer must not hold the only worker back from other work
+TEST_CASE("Timer.Responsive" * doctest::timeout(300)) {
+
+  dubhe::Executor executor(1);
+
+  auto timer = executor.schedule_every(1h, [](){});
+
+  for(int i=0; i<100; ++i) {
+    REQUIRE(executor.async([i](){ return i; }).get() == i);
+  }
+
+  dubhe::Taskflow taskflow;
+  std::atomic<size_t> counter {0};
+  for(int i=0; i<100; ++i) {
+    taskflow.emplace([&](){ counter++; });
+  }
+  executor.run(taskflow).wait();
+  REQUIRE(counter == 100);
+
+  // an earlier timer armed later still fires on time
+  auto beg = std::chrono::steady_clock::now();
+  executor.schedule_after(10ms, [](){}).get();
+  REQUIRE(std::chrono::steady_clock::now() - beg < 1h);
+  REQUIRE(executor.num_timers() == 1);
+
+  timer.cancel();
+}
@@ -121,6 +121,27 @@ TEST_CASE("ParallelTransform.Random.4threads") {
   parallel_transform<std::list<int>, dubhe::RandomPartitioner<>>(4);
 }
 
+// adaptive
+TEST_CASE("ParallelTransform.Adaptive.1thread") {
+  parallel_transform<std::vector<int>, dubhe::AdaptivePartitioner<>>(1);
+  parallel_transform<std::list<int>, dubhe::AdaptivePartitioner<>>(1);
+}
+
+TEST_CASE("ParallelTransform.Adaptive.2threads") {
+  parallel_transform<std::vector<int>, dubhe::AdaptivePartitioner<>>(2);
+  parallel_transform<std::list<int>, dubhe::AdaptivePartitioner<>>(2);
+}
+
+TEST_CASE("ParallelTransform.Adaptive.3threads") {
+  parallel_transform<std::vector<int>, dubhe::AdaptivePartitioner<>>(3);
+  parallel_transform<std::list<int>, dubhe::AdaptivePartitioner<>>(3);
+}
+
+TEST_CASE("ParallelTransform.Adaptive.4threads") {
+  parallel_transform<std::vector<int>, dubhe::AdaptivePartitioner<>>(4);
+  parallel_transform<std::list<int>, dubhe::AdaptivePartitioner<>>(4);
+}
+
 // static
 TEST_CASE("ParallelTransform.Static.1thread") {
   parallel_transform<std::vector<int>, dubhe::StaticPartitioner<>>(1);
@@ -284,6 +305,27 @@ TEST_CASE("ParallelTransform2.Random.4threads") {
   parallel_transform2<std::list<int>, dubhe::RandomPartitioner<>>(4);
 }
 
+// adaptive
+TEST_CASE("ParallelTransform2.Adaptive.1thread") {
+  parallel_transform2<std::vector<int>, dubhe::AdaptivePartitioner<>>(1);
+  parallel_transform2<std::list<int>, dubhe::AdaptivePartitioner<>>(1);
+}
+
+TEST_CASE("ParallelTransform2.Adaptive.2threads") {
+  parallel_transform2<std::vector<int>, dubhe::AdaptivePartitioner<>>(2);
+  parallel_transform2<std::list<int>, dubhe::AdaptivePartitioner<>>(2);
+}
+
+TEST_CASE("ParallelTransform2.Adaptive.3threads") {
+  parallel_transform2<std::vector<int>, dubhe::AdaptivePartitioner<>>(3);
+  parallel_transform2<std::list<int>, dubhe::AdaptivePartitioner<>>(3);
+}
+
+TEST_CASE("ParallelTransform2.Adaptive.4threads") {
+  parallel_transform2<std::vector<int>, dubhe::AdaptivePartitioner<>>(4);
+  parallel_transform2<std::list<int>, dubhe::AdaptivePartitioner<>>(4);
+}
+
 
 // ----------------------------------------------------------------------------
 // Parallel Transform 3
@@ -461,6 +503,27 @@ TEST_CASE("ParallelTransform3.Random.4threads") {
   parallel_transform3<dubhe::RandomPartitioner<>>(4);
 }
 
+// adaptive
+TEST_CASE("ParallelTransform3.Adaptive.1thread") {
+  parallel_transform3<dubhe::AdaptivePartitioner<>>(1);
+  parallel_transform3<dubhe::AdaptivePartitioner<>>(1);
+}
+
+TEST_CASE("ParallelTransform3.Adaptive.2threads") {
+  parallel_transform3<dubhe::AdaptivePartitioner<>>(2);
+  parallel_transform3<dubhe::AdaptivePartitioner<>>(2);
+}
+
+TEST_CASE("ParallelTransform3.Adaptive.3threads") {
+  parallel_transform3<dubhe::AdaptivePartitioner<>>(3);
+  parallel_transform3<dubhe::AdaptivePartitioner<>>(3);
+}
+
+TEST_CASE("ParallelTransform3.Adaptive.4threads") {
+  parallel_transform3<dubhe::AdaptivePartitioner<>>(4);
+  parallel_transform3<dubhe::AdaptivePartitioner<>>(4);
+}
+
 // ----------------------------------------------------------------------------
 // Closure Wrapper
 // ----------------------------------------------------------------------------
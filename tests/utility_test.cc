@@ -20,10 +20,16 @@
 
 #include <dubhe/utility/traits.h>
 #include <dubhe/utility/object_pool.h>
+#include <dubhe/utility/object_arena.h>
 #include <dubhe/utility/small_vector.h>
 #include <dubhe/utility/uuid.h>
 #include <dubhe/utility/iterator.h>
 #include <dubhe/utility/math.h>
+#include <dubhe/utility/numa.h>
+#include <dubhe/utility/affinity.h>
+#include <dubhe/utility/small_function.h>
+
+#include <set>
 
 // --------------------------------------------------------
 // Testcase: SmallVector
@@ -357,6 +363,41 @@ TEST_CASE("ObjectPool.Sequential" * doctest::timeout(300)) {
   }
 }
 
+TEST_CASE("ObjectPool.AnimateN" * doctest::timeout(300)) {
+
+  dubhe::ObjectPool<Poolable> pool(4);
+
+  Poolable proto;
+  proto.str = "poolable";
+  proto.vec = {1, 2, 3};
+  proto.a = 7;
+  proto.b = 'b';
+
+  for(size_t n : {0, 1, 7, 1000, 5000}) {
+
+    std::vector<Poolable*> items(n);
+    pool.animate_n(n, items.data(), proto);
+
+    REQUIRE(std::set<Poolable*>(items.begin(), items.end()).size() == n);
+    REQUIRE(pool.num_allocated_objects() == n);
+
+    for(auto item : items) {
+      REQUIRE(item->str == "poolable");
+      REQUIRE(item->vec == std::vector<int>{1, 2, 3});
+      REQUIRE(item->a == 7);
+      REQUIRE(item->b == 'b');
+    }
+
+    // objects from a batch are recycled one by one
+    for(auto item : items) {
+      pool.recycle(item);
+    }
+
+    REQUIRE(pool.num_allocated_objects() == 0);
+    REQUIRE(pool.num_available_objects() == pool.capacity());
+  }
+}
+
 // --------------------------------------------------------
 // Testcase: ObjectPool.Threaded
 // --------------------------------------------------------
@@ -453,6 +494,105 @@ TEST_CASE("ObjectPool.16threads" * doctest::timeout(300)) {
   threaded_objectpool<Poolable>(16);
 }
 
+// --------------------------------------------------------
+// Testcase: ObjectArena
+// --------------------------------------------------------
+
+TEST_CASE("ObjectArena.Sequential" * doctest::timeout(300)) {
+
+  dubhe::ObjectArena<Poolable> arena;
+  dubhe::ObjectPool<Poolable> pool(1);
+
+  const size_t M = arena.num_objects_per_chunk();
+  const size_t N = 10 * M + 3;
+
+  for(int round=0; round<5; round++) {
+
+    std::vector<Poolable*> items;
+    for(size_t i=0; i<N; ++i) {
+      auto item = arena.animate();
+      item->str = std::to_string(i);
+      item->a = static_cast<int>(i);
+      items.push_back(item);
+    }
+
+    REQUIRE(std::set<Poolable*>(items.begin(), items.end()).size() == N);
+
+    for(size_t i=0; i<N; ++i) {
+      REQUIRE(dubhe::ObjectArena<Poolable>::owns(items[i]));
+      REQUIRE(items[i]->str == std::to_string(i));
+      REQUIRE(items[i]->a == static_cast<int>(i));
+    }
+
+    for(auto item : items) {
+      dubhe::ObjectArena<Poolable>::recycle(item);
+    }
+
+    // chunks whose objects are gone are reused rather than reallocated
+    REQUIRE(arena.num_chunks() <= N / M + 2);
+  }
+
+  auto item = pool.animate();
+  REQUIRE(!dubhe::ObjectArena<Poolable>::owns(item));
+  pool.recycle(item);
+}
+
+TEST_CASE("ObjectArena.RecycleByOtherThreads" * doctest::timeout(300)) {
+
+  dubhe::ObjectArena<Poolable> arena;
+
+  const size_t N = 65536;
+
+  for(unsigned W=1; W<=4; W++) {
+
+    std::vector<Poolable*> items;
+    for(size_t i=0; i<N; ++i) {
+      items.push_back(arena.animate());
+    }
+
+    std::vector<std::thread> threads;
+    for(unsigned w=0; w<W; ++w) {
+      threads.emplace_back([&, w](){
+        for(size_t i=w; i<N; i+=W) {
+          dubhe::ObjectArena<Poolable>::recycle(items[i]);
+        }
+      });
+    }
+    for(auto& thread : threads) {
+      thread.join();
+    }
+  }
+
+  REQUIRE(arena.num_chunks() <= N / arena.num_objects_per_chunk() + 2);
+}
+
+TEST_CASE("ObjectArena.ObjectsOutliveArena" * doctest::timeout(300)) {
+
+  std::vector<Poolable*> items;
+
+  {
+    dubhe::ObjectArena<Poolable> arena;
+    for(size_t i=0; i<10000; ++i) {
+      items.push_back(arena.animate());
+      items.back()->vec.resize(i % 7);
+    }
+    // some objects are recycled before the arena goes away
+    for(size_t i=0; i<items.size(); i+=2) {
+      dubhe::ObjectArena<Poolable>::recycle(items[i]);
+      items[i] = nullptr;
+    }
+  }
+
+  std::thread thread([&](){
+    for(auto item : items) {
+      if(item) {
+        dubhe::ObjectArena<Poolable>::recycle(item);
+      }
+    }
+  });
+  thread.join();
+}
+
 // --------------------------------------------------------
 // Testcase: Reference Wrapper
 // --------------------------------------------------------
@@ -632,3 +772,199 @@ TEST_CASE("NextPow2") {
 
 
 
+
+// --------------------------------------------------------
+// Testcase: NUMA
+// --------------------------------------------------------
+TEST_CASE("NUMA.ParseCpuList" * doctest::timeout(300)) {
+
+  using cpus = std::vector<size_t>;
+
+  REQUIRE(dubhe::parse_cpu_list("") == cpus{});
+  REQUIRE(dubhe::parse_cpu_list("\n") == cpus{});
+  REQUIRE(dubhe::parse_cpu_list("0") == cpus{0});
+  REQUIRE(dubhe::parse_cpu_list("0-3\n") == cpus{0, 1, 2, 3});
+  REQUIRE(dubhe::parse_cpu_list("0-1,4,6-7") == cpus{0, 1, 4, 6, 7});
+  REQUIRE(dubhe::parse_cpu_list("8-9,0-1") == cpus{0, 1, 8, 9});
+  REQUIRE(dubhe::parse_cpu_list("2,2,1-2") == cpus{1, 2});
+
+  // malformed tokens are ignored
+  REQUIRE(dubhe::parse_cpu_list("x,3") == cpus{3});
+  REQUIRE(dubhe::parse_cpu_list("5-2,7") == cpus{7});
+  REQUIRE(dubhe::parse_cpu_list("1-,4a,6") == cpus{6});
+}
+
+TEST_CASE("NUMA.DiscoverNodes" * doctest::timeout(300)) {
+
+  namespace fs = std::filesystem;
+
+  auto root = fs::temp_directory_path() / "dubhe_numa_test";
+  fs::remove_all(root);
+
+  auto make_node = [&](const std::string& name, const std::string& cpulist){
+    fs::create_directories(root / name);
+    std::ofstream(root / name / "cpulist") << cpulist << '\n';
+  };
+
+  make_node("node2", "4-7");
+  make_node("node0", "0-3");
+  make_node("node1", "");          // memory-only node
+  make_node("nodeX", "8-9");       // not a node directory
+  fs::create_directories(root / "node3");  // no cpulist
+
+  auto nodes = dubhe::discover_numa_nodes(root.string());
+
+  REQUIRE(nodes.size() == 2);
+  REQUIRE(nodes[0].id == 0);
+  REQUIRE(nodes[0].cpus == std::vector<size_t>{0, 1, 2, 3});
+  REQUIRE(nodes[1].id == 2);
+  REQUIRE(nodes[1].cpus == std::vector<size_t>{4, 5, 6, 7});
+
+  fs::remove_all(root);
+
+  // nothing to discover falls back to a single node
+  nodes = dubhe::discover_numa_nodes(root.string());
+  REQUIRE(nodes.size() == 1);
+  REQUIRE(nodes[0].id == 0);
+  REQUIRE(nodes[0].cpus.size() == std::max(1u, std::thread::hardware_concurrency()));
+}
+
+// --------------------------------------------------------
+// Testcase: Affinity
+// --------------------------------------------------------
+TEST_CASE("Affinity.AllowedCpus" * doctest::timeout(300)) {
+  auto cpus = dubhe::allowed_cpus();
+  REQUIRE(cpus.size() > 0);
+  REQUIRE(std::is_sorted(cpus.begin(), cpus.end()));
+}
+
+TEST_CASE("Affinity.DiscoverCpus" * doctest::timeout(300)) {
+
+  namespace fs = std::filesystem;
+
+  auto root = fs::temp_directory_path() / "dubhe_affinity_test";
+  fs::remove_all(root);
+
+  // 2 packages x 2 cores x 2 SMT siblings, where the siblings of core c
+  // are cpus c and c+4
+  for(size_t c=0; c<8; c++) {
+    auto dir = root / ("cpu" + std::to_string(c)) / "topology";
+    fs::create_directories(dir);
+    std::ofstream(dir / "thread_siblings_list") << (c%4) << ',' << (c%4+4) << '\n';
+    std::ofstream(dir / "physical_package_id") << ((c%4)/2) << '\n';
+  }
+
+  auto infos = dubhe::discover_cpus({0, 1, 2, 3, 4, 5, 6, 7, 8}, root.string());
+  REQUIRE(infos.size() == 9);
+
+  for(size_t c=0; c<8; c++) {
+    REQUIRE(infos[c].id == c);
+    REQUIRE(infos[c].core == c%4);
+    REQUIRE(infos[c].package == (c%4)/2);
+    REQUIRE(infos[c].smt_rank == c/4);
+  }
+
+  // cpu 8 has no topology information
+  REQUIRE(infos[8].id == 8);
+  REQUIRE(infos[8].core == 8);
+  REQUIRE(infos[8].package == 0);
+  REQUIRE(infos[8].smt_rank == 0);
+
+  fs::remove_all(root);
+}
+
+TEST_CASE("Affinity.OrderCpus" * doctest::timeout(300)) {
+
+  using cpus = std::vector<size_t>;
+
+  // 2 packages x 2 cores x 2 SMT siblings
+  std::vector<dubhe::CpuInfo> infos;
+  for(size_t c=0; c<8; c++) {
+    infos.push_back({c, c%4, (c%4)/2, c/4});
+  }
+
+  REQUIRE(dubhe::order_cpus(infos, dubhe::AffinityPolicy::NONE).empty());
+
+  REQUIRE(dubhe::order_cpus(infos, dubhe::AffinityPolicy::COMPACT) ==
+          cpus{0, 4, 1, 5, 2, 6, 3, 7});
+
+  REQUIRE(dubhe::order_cpus(infos, dubhe::AffinityPolicy::NO_SMT) ==
+          cpus{0, 1, 2, 3});
+
+  REQUIRE(dubhe::order_cpus(infos, dubhe::AffinityPolicy::SCATTER) ==
+          cpus{0, 2, 1, 3, 4, 6, 5, 7});
+
+  REQUIRE(dubhe::order_cpus(infos, dubhe::AffinityPolicy::EXPLICIT, {7, 9, 3, 3}) ==
+          cpus{7, 3, 3});
+
+  // a restricted mask only orders the given cpus
+  infos.erase(infos.begin());
+  REQUIRE(dubhe::order_cpus(infos, dubhe::AffinityPolicy::COMPACT) ==
+          cpus{4, 1, 5, 2, 6, 3, 7});
+  REQUIRE(dubhe::order_cpus(infos, dubhe::AffinityPolicy::NO_SMT) ==
+          cpus{4, 1, 2, 3});
+}
+
+// --------------------------------------------------------
+// Testcase: SmallFunction
+// --------------------------------------------------------
+
+TEST_CASE("SmallFunction" * doctest::timeout(300)) {
+
+  // empty functions
+  dubhe::SmallFunction<int(int)> f;
+  REQUIRE(!f);
+  REQUIRE_THROWS_AS(f(1), std::bad_function_call);
+
+  // inline, trivially copyable callables
+  int offset = 2;
+  f = [offset](int v){ return v + offset; };
+  REQUIRE(f);
+  REQUIRE(f(1) == 3);
+
+  auto g = std::move(f);
+  REQUIRE(!f);
+  REQUIRE(g(1) == 3);
+
+  // move-only callables
+  dubhe::SmallFunction<int()> h = [p=std::make_unique<int>(7)](){ return *p; };
+  REQUIRE(h() == 7);
+  dubhe::SmallFunction<int()> k;
+  k = std::move(h);
+  REQUIRE(!h);
+  REQUIRE(k() == 7);
+
+  // callables beyond the buffer live on the heap
+  std::array<int, 64> big;
+  big.fill(1);
+  dubhe::SmallFunction<int(), 16> l = [big](){
+    return std::accumulate(big.begin(), big.end(), 0);
+  };
+  REQUIRE(l() == 64);
+  auto m = std::move(l);
+  REQUIRE(!l);
+  REQUIRE(m() == 64);
+
+  // callables are destroyed exactly once
+  auto counter = std::make_shared<int>(0);
+  {
+    dubhe::SmallFunction<void(int&)> n = [counter](int& v){ v = 1; };
+    REQUIRE(counter.use_count() == 2);
+    auto o = std::move(n);
+    REQUIRE(counter.use_count() == 2);
+    int v = 0;
+    o(v);
+    REQUIRE(v == 1);
+    n = [counter](int&){};
+    REQUIRE(counter.use_count() == 3);
+    n = nullptr;
+    REQUIRE(counter.use_count() == 2);
+  }
+  REQUIRE(counter.use_count() == 1);
+
+  // return values are converted to the return type
+  dubhe::SmallFunction<void()> p = [](){ return 1; };
+  p();
+  dubhe::SmallFunction<long()> q = [](){ return 1; };
+  REQUIRE(q() == 1L);
+}
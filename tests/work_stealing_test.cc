@@ -185,6 +185,115 @@ TEST_CASE("WorkStealing.Queue8Thieves" * doctest::timeout(300)) {
   tsq_n_thieves(8);
 }
 
+// ----------------------------------------------------------------------------
+// Testcase: TSQTest.StealHalf
+// ----------------------------------------------------------------------------
+TEST_CASE("WorkStealing.QueueStealHalf" * doctest::timeout(300)) {
+
+  for(size_t N=1; N<=4097; N=N*2+1) {
+
+    dubhe::TaskQueue<size_t*> victim;
+    dubhe::TaskQueue<size_t*> thief;
+    std::vector<size_t> data(N);
+
+    for(size_t i=0; i<N; ++i) {
+      victim.push(&data[i], i % 2);
+    }
+
+    // the first non-empty priority loses half of its items (rounded up),
+    // oldest first, with the oldest item returned
+    size_t P0 = (N+1)/2;
+    REQUIRE(victim.steal_half(thief) == &data[0]);
+    REQUIRE(thief.size() == (P0+1)/2 - 1);
+    REQUIRE(thief.size(1) == 0);
+    REQUIRE(victim.size(0) == P0 - (P0+1)/2);
+    REQUIRE(victim.size(1) == N/2);
+
+    // the rest of the batch is in the thief's queue in the same order
+    for(size_t k=(P0+1)/2-1; k>=1; --k) {
+      REQUIRE(thief.pop() == &data[2*k]);
+    }
+    REQUIRE(thief.empty());
+  }
+
+  dubhe::TaskQueue<size_t*> victim;
+  dubhe::TaskQueue<size_t*> thief;
+  REQUIRE(victim.steal_half(thief) == nullptr);
+  REQUIRE(thief.empty());
+}
+
+// Procedure: tsq_n_half_thieves
+void tsq_n_half_thieves(size_t M) {
+
+  for(size_t N=1; N<=262143; N=N*2+1) {
+    dubhe::TaskQueue<void*> queue;
+    std::vector<void*> gold(N);
+    std::atomic<size_t> consumed {0};
+
+    for(size_t i=0; i<N; ++i) {
+      gold[i] = &gold[i];
+    }
+
+    // thieves steal in batches into their own queues
+    std::vector<std::thread> threads;
+    std::vector<std::vector<void*>> stolens(M);
+    for(size_t i=0; i<M; ++i) {
+      threads.emplace_back([&, i](){
+        dubhe::TaskQueue<void*> own;
+        while(consumed != N) {
+          for(auto ptr = queue.steal_half(own); ptr; ptr = own.pop()) {
+            stolens[i].push_back(ptr);
+            consumed.fetch_add(1, std::memory_order_relaxed);
+          }
+        }
+        REQUIRE(own.empty());
+      });
+    }
+
+    // master thread
+    for(size_t i=0; i<N; ++i) {
+      queue.push(gold[i], 0);
+    }
+
+    std::vector<void*> items;
+    while(consumed != N) {
+      auto ptr = queue.pop();
+      if(ptr != nullptr) {
+        items.push_back(ptr);
+        consumed.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+    REQUIRE(queue.empty());
+
+    for(auto& thread : threads) thread.join();
+
+    for(size_t i=0; i<M; ++i) {
+      for(auto s : stolens[i]) {
+        items.push_back(s);
+      }
+    }
+
+    std::sort(items.begin(), items.end());
+    REQUIRE(items == gold);
+  }
+}
+
+TEST_CASE("WorkStealing.QueueStealHalf.1Thief" * doctest::timeout(300)) {
+  tsq_n_half_thieves(1);
+}
+
+TEST_CASE("WorkStealing.QueueStealHalf.2Thieves" * doctest::timeout(300)) {
+  tsq_n_half_thieves(2);
+}
+
+TEST_CASE("WorkStealing.QueueStealHalf.4Thieves" * doctest::timeout(300)) {
+  tsq_n_half_thieves(4);
+}
+
+TEST_CASE("WorkStealing.QueueStealHalf.8Thieves" * doctest::timeout(300)) {
+  tsq_n_half_thieves(8);
+}
+
 // ============================================================================
 // Test with Priority
 // ============================================================================
@@ -1260,3 +1369,1042 @@ TEST_CASE("WorkStealing.Continuation.8threads" * doctest::timeout(300)) {
 
 
 
+
+// ----------------------------------------------------------------------------
+// NUMA-aware Executor
+// ----------------------------------------------------------------------------
+
+// Function: make_numa_sysfs
+// creates a fake sysfs node directory with one node per given cpulist
+std::string make_numa_sysfs(const std::vector<std::string>& cpulists) {
+  namespace fs = std::filesystem;
+  auto root = fs::temp_directory_path() / "dubhe_work_stealing_numa";
+  fs::remove_all(root);
+  for(size_t i=0; i<cpulists.size(); i++) {
+    auto dir = root / ("node" + std::to_string(i));
+    fs::create_directories(dir);
+    std::ofstream(dir / "cpulist") << cpulists[i] << '\n';
+  }
+  return root.string();
+}
+
+// Function: num_allowed_nodes
+// counts the given nodes with cpus that the process is allowed to run on
+size_t num_allowed_nodes(const std::vector<std::string>& cpulists) {
+  auto allowed = dubhe::allowed_cpus();
+  return std::count_if(cpulists.begin(), cpulists.end(), [&](const std::string& list){
+    auto cpus = dubhe::parse_cpu_list(list);
+    return std::any_of(cpus.begin(), cpus.end(), [&](size_t c){
+      return std::count(allowed.begin(), allowed.end(), c) != 0;
+    });
+  });
+}
+
+// Function: all_allowed
+// queries if the process is allowed to run on all the cpus of the given nodes
+bool all_allowed(const std::vector<std::string>& cpulists) {
+  auto allowed = dubhe::allowed_cpus();
+  return std::all_of(cpulists.begin(), cpulists.end(), [&](const std::string& list){
+    auto cpus = dubhe::parse_cpu_list(list);
+    return std::includes(allowed.begin(), allowed.end(), cpus.begin(), cpus.end());
+  });
+}
+
+// Observer: NumaObserver
+// records the NUMA node of every worker that runs a task
+struct NumaObserver : public dubhe::ObserverInterface {
+
+  std::mutex mutex;
+  std::unordered_map<size_t, size_t> nodes;
+
+  void set_up(size_t) override final {}
+
+  void on_entry(dubhe::WorkerView wv, dubhe::TaskView) override final {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto [itr, inserted] = nodes.emplace(wv.id(), wv.numa_node());
+    REQUIRE(itr->second == wv.numa_node());
+  }
+
+  void on_exit(dubhe::WorkerView, dubhe::TaskView) override final {}
+};
+
+void numa_executor(
+  const std::vector<std::string>& cpulists, size_t W,
+  const std::vector<size_t>& expected
+) {
+
+  dubhe::ExecutorOptions options;
+  options.numa_aware = true;
+  options.numa_sysfs_root = make_numa_sysfs(cpulists);
+
+  dubhe::Executor executor(W, options);
+
+  // nodes outside the affinity mask of the process receive no workers,
+  // in which case only the remaining groups are checked
+  const bool full = all_allowed(cpulists);
+
+  REQUIRE(executor.num_workers() == W);
+  if(full) {
+    REQUIRE(executor.num_worker_groups() == expected.size());
+  }
+  else {
+    REQUIRE(executor.num_worker_groups() ==
+            std::max<size_t>(1, std::min(W, num_allowed_nodes(cpulists))));
+  }
+
+  auto observer = executor.make_observer<NumaObserver>();
+
+  // graph tasks, subflows, and asynchronous tasks all complete
+  std::atomic<size_t> counter {0};
+
+  dubhe::Taskflow taskflow;
+  for(size_t i=0; i<256; i++) {
+    taskflow.emplace([&](dubhe::Subflow& sf){
+      for(size_t j=0; j<16; j++) {
+        sf.emplace([&](){ counter.fetch_add(1, std::memory_order_relaxed); });
+      }
+    });
+  }
+
+  executor.run_n(taskflow, 4).wait();
+  REQUIRE(counter == 256*16*4);
+
+  for(size_t i=0; i<1024; i++) {
+    executor.silent_async([&](){ counter.fetch_add(1, std::memory_order_relaxed); });
+  }
+  executor.wait_for_all();
+  REQUIRE(counter == 256*16*4 + 1024);
+
+  if(!full) {
+    std::filesystem::remove_all(options.numa_sysfs_root);
+    return;
+  }
+
+  // workers are split by node in proportion to its cpus, and the worker
+  // ids go round the nodes such that the first ids land on distinct nodes
+  std::vector<size_t> sizes(expected.size(), 0);
+  std::set<size_t> firsts;
+  for(auto [w, node] : observer->nodes) {
+    REQUIRE(node < cpulists.size());
+    REQUIRE(++sizes[node] <= expected[node]);
+    if(w < expected.size()) {
+      REQUIRE(firsts.insert(node).second);
+    }
+  }
+
+  std::filesystem::remove_all(options.numa_sysfs_root);
+}
+
+TEST_CASE("WorkStealing.NUMA.1node" * doctest::timeout(300)) {
+  numa_executor({"0-3"}, 4, {4});
+}
+
+TEST_CASE("WorkStealing.NUMA.2nodes" * doctest::timeout(300)) {
+  numa_executor({"0-3", "4-7"}, 8, {4, 4});
+}
+
+TEST_CASE("WorkStealing.NUMA.2nodes.Uneven" * doctest::timeout(300)) {
+  numa_executor({"0-1", "2-7"}, 4, {1, 3});
+}
+
+TEST_CASE("WorkStealing.NUMA.3nodes.Oversubscribed" * doctest::timeout(300)) {
+  numa_executor({"0", "1", "2"}, 7, {3, 2, 2});
+}
+
+TEST_CASE("WorkStealing.NUMA.4nodes.FewerWorkers" * doctest::timeout(300)) {
+  numa_executor({"0-1", "2-3", "4-5", "6-7"}, 2, {1, 1});
+}
+
+TEST_CASE("WorkStealing.NUMA.LocalSteals" * doctest::timeout(300)) {
+
+  dubhe::ExecutorOptions options;
+  options.numa_aware = true;
+  options.num_local_steals = 1;
+  options.numa_sysfs_root = make_numa_sysfs({"0-1", "2-3"});
+
+  dubhe::Executor executor(4, options);
+  REQUIRE(executor.num_worker_groups() == num_allowed_nodes({"0-1", "2-3"}));
+
+  // external submissions complete with early escalation to remote groups
+  std::atomic<size_t> counter {0};
+  for(size_t i=0; i<10000; i++) {
+    executor.silent_async([&](){ counter++; });
+  }
+  executor.wait_for_all();
+  REQUIRE(counter == 10000);
+
+  std::filesystem::remove_all(options.numa_sysfs_root);
+}
+
+// ----------------------------------------------------------------------------
+// Worker Affinity
+// ----------------------------------------------------------------------------
+
+// Observer: AffinityObserver
+// records the cpu of every worker that runs a task
+struct AffinityObserver : public dubhe::ObserverInterface {
+
+  std::mutex mutex;
+  std::unordered_map<size_t, int> cpus;
+
+  void set_up(size_t) override final {}
+
+  void on_entry(dubhe::WorkerView wv, dubhe::TaskView) override final {
+    std::lock_guard<std::mutex> lock(mutex);
+    cpus[wv.id()] = wv.cpu();
+  }
+
+  void on_exit(dubhe::WorkerView, dubhe::TaskView) override final {}
+};
+
+TEST_CASE("WorkStealing.NUMA.RestrictedMask" * doctest::timeout(300)) {
+
+  // one node holds an allowed cpu and the other one a cpu outside the
+  // affinity mask of the process, as under taskset
+  auto allowed = dubhe::allowed_cpus();
+  auto inside = std::to_string(allowed.front());
+  auto outside = std::to_string(allowed.back() + 1);
+
+  dubhe::ExecutorOptions options;
+  options.numa_aware = true;
+  options.affinity = dubhe::AffinityPolicy::COMPACT;
+  options.numa_sysfs_root = make_numa_sysfs({inside, outside});
+
+  dubhe::Executor executor(4, options);
+
+  // all workers go to the node the process may run on
+  REQUIRE(executor.num_workers() == 4);
+  REQUIRE(executor.num_worker_groups() == 1);
+
+  auto numa = executor.make_observer<NumaObserver>();
+  auto affinity = executor.make_observer<AffinityObserver>();
+
+  std::atomic<size_t> counter {0};
+  for(size_t i=0; i<1024; i++) {
+    executor.silent_async([&](){ counter++; });
+  }
+  executor.wait_for_all();
+  REQUIRE(counter == 1024);
+
+  for(auto [w, node] : numa->nodes) {
+    REQUIRE(node == 0);
+  }
+  for(auto [w, cpu] : affinity->cpus) {
+    REQUIRE(cpu == static_cast<int>(allowed.front()));
+  }
+
+  std::filesystem::remove_all(options.numa_sysfs_root);
+}
+
+void affinity_executor(dubhe::AffinityPolicy policy, size_t W) {
+
+  dubhe::ExecutorOptions options;
+  options.affinity = policy;
+  options.affinity_cpus = dubhe::allowed_cpus();
+
+  dubhe::Executor executor(W, options);
+  auto observer = executor.make_observer<AffinityObserver>();
+
+  std::atomic<size_t> counter {0};
+  for(size_t i=0; i<1000; i++) {
+    executor.silent_async([&](){ counter++; });
+  }
+  executor.wait_for_all();
+  REQUIRE(counter == 1000);
+
+  auto allowed = dubhe::allowed_cpus();
+
+  for(auto [w, cpu] : observer->cpus) {
+    if(policy == dubhe::AffinityPolicy::NONE) {
+      REQUIRE(cpu == -1);
+    }
+    else {
+      REQUIRE(cpu >= 0);
+      REQUIRE(std::count(allowed.begin(), allowed.end(), static_cast<size_t>(cpu)) == 1);
+    }
+  }
+
+  // the pinned cpu must be observed from the worker itself
+  if(policy != dubhe::AffinityPolicy::NONE) {
+    for(size_t i=0; i<W; i++) {
+      executor.silent_async([&](){
+        auto id = executor.this_worker_id();
+        auto cpu = dubhe::current_cpu();
+        std::lock_guard<std::mutex> lock(observer->mutex);
+        if(auto itr = observer->cpus.find(id); itr != observer->cpus.end() && cpu >= 0) {
+          REQUIRE(itr->second == cpu);
+        }
+      });
+    }
+    executor.wait_for_all();
+  }
+}
+
+TEST_CASE("WorkStealing.Affinity.None" * doctest::timeout(300)) {
+  affinity_executor(dubhe::AffinityPolicy::NONE, 4);
+}
+
+TEST_CASE("WorkStealing.Affinity.Compact" * doctest::timeout(300)) {
+  affinity_executor(dubhe::AffinityPolicy::COMPACT, 4);
+}
+
+TEST_CASE("WorkStealing.Affinity.Scatter" * doctest::timeout(300)) {
+  affinity_executor(dubhe::AffinityPolicy::SCATTER, 4);
+}
+
+TEST_CASE("WorkStealing.Affinity.Explicit" * doctest::timeout(300)) {
+  affinity_executor(dubhe::AffinityPolicy::EXPLICIT, 4);
+}
+
+TEST_CASE("WorkStealing.Affinity.NoSMT" * doctest::timeout(300)) {
+  affinity_executor(dubhe::AffinityPolicy::NO_SMT, 4);
+}
+
+TEST_CASE("WorkStealing.Affinity.Oversubscribed" * doctest::timeout(300)) {
+  affinity_executor(
+    dubhe::AffinityPolicy::COMPACT, 2*dubhe::allowed_cpus().size() + 1
+  );
+}
+
+TEST_CASE("WorkStealing.Affinity.NoAllowedCpu" * doctest::timeout(300)) {
+  dubhe::ExecutorOptions options;
+  options.affinity = dubhe::AffinityPolicy::EXPLICIT;
+  options.affinity_cpus = {CPU_SETSIZE + 1};
+  REQUIRE_THROWS(dubhe::Executor(2, options));
+}
+
+// ----------------------------------------------------------------------------
+// MPMC Queue
+// ----------------------------------------------------------------------------
+
+TEST_CASE("WorkStealing.MPMCQueue.Priority" * doctest::timeout(300)) {
+
+  const size_t N = 777;
+
+  dubhe::MPMCQueue<size_t*> queue(16);
+  std::vector<size_t> data(N*3);
+
+  REQUIRE(queue.empty());
+  REQUIRE(queue.capacity() == 16);
+
+  // interleave the priorities and overflow the rings
+  for(size_t i=0; i<N*3; i++) {
+    queue.push(&data[i], i%3);
+    REQUIRE(queue.size() == i+1);
+    REQUIRE(queue.size(i%3) == i/3+1);
+  }
+
+  // a spilled priority level rejects try_push
+  REQUIRE(queue.try_push(&data[0], 0) == false);
+
+  // higher priority first, FIFO within a priority
+  for(unsigned p=0; p<3; p++) {
+    for(size_t i=0; i<N; i++) {
+      REQUIRE(queue.steal() == &data[i*3+p]);
+    }
+    REQUIRE(queue.empty(p));
+  }
+
+  REQUIRE(queue.empty());
+  REQUIRE(queue.steal() == nullptr);
+
+  // the rings are usable again after the overflow is drained
+  REQUIRE(queue.try_push(&data[0], 2) == true);
+  REQUIRE(queue.steal(1) == nullptr);
+  REQUIRE(queue.steal(2) == &data[0]);
+}
+
+void mpmc_queue(size_t num_producers, size_t num_consumers, size_t capacity) {
+
+  const size_t N = 65536;
+
+  dubhe::MPMCQueue<size_t*> queue(capacity);
+  std::vector<size_t> data(N * num_producers);
+  std::vector<std::atomic<int>> seen(data.size());
+  std::atomic<size_t> consumed {0};
+
+  std::vector<std::thread> threads;
+
+  for(size_t i=0; i<num_producers; i++) {
+    threads.emplace_back([&, i](){
+      for(size_t j=0; j<N; j++) {
+        data[i*N+j] = i*N+j;
+        queue.push(&data[i*N+j], j%3);
+      }
+    });
+  }
+
+  for(size_t i=0; i<num_consumers; i++) {
+    threads.emplace_back([&](){
+      while(consumed.load() != data.size()) {
+        if(auto ptr = queue.steal(); ptr) {
+          seen[*ptr]++;
+          consumed++;
+        }
+      }
+    });
+  }
+
+  for(auto& t : threads) {
+    t.join();
+  }
+
+  REQUIRE(queue.empty());
+  for(auto& s : seen) {
+    REQUIRE(s == 1);
+  }
+}
+
+TEST_CASE("WorkStealing.MPMCQueue.1P1C" * doctest::timeout(300)) {
+  mpmc_queue(1, 1, 1024);
+}
+
+TEST_CASE("WorkStealing.MPMCQueue.4P1C" * doctest::timeout(300)) {
+  mpmc_queue(4, 1, 1024);
+}
+
+TEST_CASE("WorkStealing.MPMCQueue.1P4C" * doctest::timeout(300)) {
+  mpmc_queue(1, 4, 1024);
+}
+
+TEST_CASE("WorkStealing.MPMCQueue.4P4C" * doctest::timeout(300)) {
+  mpmc_queue(4, 4, 1024);
+}
+
+TEST_CASE("WorkStealing.MPMCQueue.8P8C.Overflow" * doctest::timeout(300)) {
+  mpmc_queue(8, 8, 2);
+}
+
+TEST_CASE("WorkStealing.MPMCQueue.BulkPush" * doctest::timeout(300)) {
+
+  dubhe::MPMCQueue<size_t*> queue(8);
+  std::vector<size_t> data(100);
+  std::vector<size_t*> ptrs(data.size());
+  for(size_t i=0; i<data.size(); i++) {
+    ptrs[i] = &data[i];
+  }
+
+  // fits in the ring
+  queue.bulk_push(ptrs.data(), 5, 1);
+  REQUIRE(queue.size() == 5);
+
+  // fills the ring and spills the rest
+  queue.bulk_push(ptrs.data() + 5, 95, 1);
+  REQUIRE(queue.size() == 100);
+  REQUIRE(queue.size(1) == 100);
+
+  for(size_t i=0; i<data.size(); i++) {
+    REQUIRE(queue.steal() == &data[i]);
+  }
+  REQUIRE(queue.empty());
+
+  // wraps around the ring
+  queue.bulk_push(ptrs.data(), 6, 0);
+  REQUIRE(queue.steal(0) == &data[0]);
+  REQUIRE(queue.steal(0) == &data[1]);
+  queue.bulk_push(ptrs.data() + 6, 4, 0);
+  for(size_t i=2; i<10; i++) {
+    REQUIRE(queue.steal(0) == &data[i]);
+  }
+  REQUIRE(queue.empty());
+}
+
+TEST_CASE("WorkStealing.MPMCQueue.BulkPush.4P4C" * doctest::timeout(300)) {
+
+  const size_t N = 65536;
+  const size_t P = 4;
+
+  dubhe::MPMCQueue<size_t*> queue(64);
+  std::vector<size_t> data(N*P);
+  std::vector<std::atomic<int>> seen(data.size());
+  std::atomic<size_t> consumed {0};
+
+  std::vector<std::thread> threads;
+
+  for(size_t i=0; i<P; i++) {
+    threads.emplace_back([&, i](){
+      std::vector<size_t*> batch;
+      for(size_t j=0; j<N; j++) {
+        data[i*N+j] = i*N+j;
+        batch.push_back(&data[i*N+j]);
+        if(batch.size() == 1 + j%37 || j+1 == N) {
+          queue.bulk_push(batch.data(), batch.size(), j%3);
+          batch.clear();
+        }
+      }
+    });
+  }
+
+  for(size_t i=0; i<P; i++) {
+    threads.emplace_back([&](){
+      while(consumed.load() != data.size()) {
+        if(auto ptr = queue.steal(); ptr) {
+          seen[*ptr]++;
+          consumed++;
+        }
+      }
+    });
+  }
+
+  for(auto& t : threads) {
+    t.join();
+  }
+
+  REQUIRE(queue.empty());
+  for(auto& s : seen) {
+    REQUIRE(s == 1);
+  }
+}
+
+TEST_CASE("WorkStealing.TaskQueue.BulkPush" * doctest::timeout(300)) {
+
+  for(size_t N=1; N<=65536; N=N*2+1) {
+
+    dubhe::TaskQueue<size_t*> queue(2);
+    std::vector<size_t> data(N);
+    std::vector<size_t*> ptrs(N);
+    for(size_t i=0; i<N; i++) {
+      ptrs[i] = &data[i];
+    }
+
+    queue.bulk_push(ptrs.data(), N, 1);
+    REQUIRE(queue.size() == N);
+    REQUIRE(queue.size(1) == N);
+    REQUIRE(queue.capacity(1) >= static_cast<int64_t>(N));
+
+    // the owner pops in LIFO order and thieves steal in FIFO order
+    REQUIRE(queue.pop() == &data[N-1]);
+    for(size_t i=0; i+1<N; i++) {
+      REQUIRE(queue.steal() == &data[i]);
+    }
+    REQUIRE(queue.empty());
+  }
+}
+
+// --------------------------------------------------------
+// Testcase: WorkStealing.WaitPolicy
+// --------------------------------------------------------
+
+void wait_policy(dubhe::WaitMode mode, size_t W) {
+
+  dubhe::ExecutorOptions options;
+  options.wait_policy.mode = mode;
+  options.wait_policy.spin_budget = std::chrono::microseconds(20);
+  options.wait_policy.max_backoff = 64;
+
+  dubhe::Executor executor(W, options);
+
+  for(size_t N=1; N<=4096; N<<=2) {
+
+    std::atomic<size_t> counter {0};
+
+    // independent asyncs from outside the executor
+    for(size_t i=0; i<N; i++) {
+      executor.silent_async([&](){ counter.fetch_add(1, std::memory_order_relaxed); });
+    }
+    executor.wait_for_all();
+    REQUIRE(counter == N);
+
+    // fan-out graph that forces workers to steal
+    dubhe::Taskflow taskflow;
+    auto src = taskflow.emplace([](){});
+    auto dst = taskflow.emplace([](){});
+    for(size_t i=0; i<N; i++) {
+      auto t = taskflow.emplace([&](){ counter.fetch_add(1, std::memory_order_relaxed); });
+      src.precede(t);
+      t.precede(dst);
+    }
+    executor.run_n(taskflow, 4).wait();
+    REQUIRE(counter == 5*N);
+
+    // let the workers go idle such that the next round wakes them up
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+}
+
+TEST_CASE("WorkStealing.WaitPolicy.Yield" * doctest::timeout(300)) {
+  for(size_t W=1; W<=4; W++) {
+    wait_policy(dubhe::WaitMode::YIELD, W);
+  }
+}
+
+TEST_CASE("WorkStealing.WaitPolicy.Spin" * doctest::timeout(300)) {
+  for(size_t W=1; W<=4; W++) {
+    wait_policy(dubhe::WaitMode::SPIN, W);
+  }
+}
+
+TEST_CASE("WorkStealing.WaitPolicy.Backoff" * doctest::timeout(300)) {
+  for(size_t W=1; W<=4; W++) {
+    wait_policy(dubhe::WaitMode::BACKOFF, W);
+  }
+}
+
+TEST_CASE("WorkStealing.WaitPolicy.Park" * doctest::timeout(300)) {
+  for(size_t W=1; W<=4; W++) {
+    wait_policy(dubhe::WaitMode::PARK, W);
+  }
+}
+
+TEST_CASE("WorkStealing.WaitPolicy.NumSteals" * doctest::timeout(300)) {
+  dubhe::ExecutorOptions options;
+  options.wait_policy.num_steals = 1;
+  options.wait_policy.num_yields = 1;
+  for(size_t W=1; W<=4; W++) {
+    dubhe::Executor executor(W, options);
+    std::atomic<size_t> counter {0};
+    for(size_t i=0; i<1000; i++) {
+      executor.silent_async([&](){ counter++; });
+    }
+    executor.wait_for_all();
+    REQUIRE(counter == 1000);
+
+    // joining workers corun with their own bound of failed steals
+    dubhe::Taskflow taskflow;
+    for(size_t i=0; i<16; i++) {
+      taskflow.emplace([&](dubhe::Subflow& sf){
+        for(size_t j=0; j<64; j++) {
+          sf.emplace([&](){ counter++; });
+        }
+        sf.join();
+      });
+    }
+    executor.run(taskflow).wait();
+    REQUIRE(counter == 2024);
+  }
+}
+
+// --------------------------------------------------------
+// Testcase: WorkStealing.Elastic
+// --------------------------------------------------------
+
+// runs a fan-out graph and a batch of asyncs and checks every task ran once
+void elastic_workload(dubhe::Executor& executor, size_t N) {
+
+  std::atomic<size_t> counter {0};
+
+  dubhe::Taskflow taskflow;
+  auto src = taskflow.emplace([](){});
+  auto dst = taskflow.emplace([](){});
+  for(size_t i=0; i<N; i++) {
+    auto t = taskflow.emplace([&](){ counter.fetch_add(1, std::memory_order_relaxed); });
+    src.precede(t);
+    t.precede(dst);
+  }
+  executor.run(taskflow);
+
+  for(size_t i=0; i<N; i++) {
+    executor.silent_async([&](){ counter.fetch_add(1, std::memory_order_relaxed); });
+  }
+
+  executor.wait_for_all();
+  REQUIRE(counter == 2*N);
+}
+
+TEST_CASE("WorkStealing.Elastic.Fixed" * doctest::timeout(300)) {
+  dubhe::Executor executor(4);
+  REQUIRE(executor.num_workers() == 4);
+  REQUIRE(executor.max_num_workers() == 4);
+  REQUIRE(executor.add_workers(1) == 0);
+  REQUIRE(executor.remove_workers(8) == 3);
+  REQUIRE(executor.num_workers() == 1);
+  elastic_workload(executor, 1000);
+  REQUIRE(executor.add_workers(8) == 3);
+  REQUIRE(executor.num_workers() == 4);
+  elastic_workload(executor, 1000);
+}
+
+TEST_CASE("WorkStealing.Elastic.AddRemove" * doctest::timeout(300)) {
+
+  dubhe::ExecutorOptions options;
+  options.elastic_policy.max_workers = 8;
+
+  dubhe::Executor executor(2, options);
+  REQUIRE(executor.num_workers() == 2);
+  REQUIRE(executor.max_num_workers() == 8);
+
+  for(size_t round=0; round<20; round++) {
+    auto n = executor.num_workers();
+    if(round % 3 == 0) {
+      REQUIRE(executor.remove_workers(round % 4 + 1) == std::min(round % 4 + 1, n - 1));
+    }
+    else {
+      REQUIRE(executor.add_workers(round % 4 + 1) == std::min(round % 4 + 1, 8 - n));
+    }
+    elastic_workload(executor, 512);
+  }
+
+  // worker ids span all slots and always name the calling worker
+  std::atomic<bool> valid {true};
+  executor.add_workers(8);
+  for(size_t i=0; i<1000; i++) {
+    executor.silent_async([&](){
+      auto id = executor.this_worker_id();
+      if(id < 0 || id >= 8) {
+        valid = false;
+      }
+    });
+  }
+  executor.wait_for_all();
+  REQUIRE(valid);
+  REQUIRE(executor.this_worker_id() == -1);
+}
+
+TEST_CASE("WorkStealing.Elastic.RemoveUnderLoad" * doctest::timeout(300)) {
+
+  dubhe::ExecutorOptions options;
+  options.elastic_policy.max_workers = 6;
+
+  dubhe::Executor executor(6, options);
+  std::atomic<size_t> counter {0};
+
+  // workers retire themselves and re-add each other while tasks keep coming
+  for(size_t i=0; i<10000; i++) {
+    executor.silent_async([&, i](){
+      if(i % 97 == 0) {
+        executor.remove_workers(1);
+      }
+      else if(i % 89 == 0) {
+        executor.add_workers(1);
+      }
+      counter.fetch_add(1, std::memory_order_relaxed);
+    });
+  }
+  executor.wait_for_all();
+  REQUIRE(counter == 10000);
+  REQUIRE(executor.num_workers() >= 1);
+}
+
+TEST_CASE("WorkStealing.Elastic.NUMA" * doctest::timeout(300)) {
+
+  dubhe::ExecutorOptions options;
+  options.numa_aware = true;
+  options.numa_sysfs_root = make_numa_sysfs({"0-3", "4-7"});
+  options.elastic_policy.max_workers = 8;
+
+  dubhe::Executor executor(2, options);
+  REQUIRE(executor.num_worker_groups() == num_allowed_nodes({"0-3", "4-7"}));
+
+  auto observer = executor.make_observer<NumaObserver>();
+
+  // the two initial workers are spread over both groups
+  std::set<size_t> nodes;
+  for(size_t round=0; round<100 && nodes.size() < executor.num_worker_groups(); round++) {
+    elastic_workload(executor, 4096);
+    std::lock_guard<std::mutex> lock(observer->mutex);
+    for(auto [id, node] : observer->nodes) {
+      nodes.insert(node);
+    }
+  }
+  REQUIRE(nodes.size() == executor.num_worker_groups());
+
+  REQUIRE(executor.add_workers(6) == 6);
+  elastic_workload(executor, 4096);
+  REQUIRE(executor.remove_workers(7) == 7);
+  REQUIRE(executor.num_workers() == 1);
+  elastic_workload(executor, 4096);
+
+  std::filesystem::remove_all(options.numa_sysfs_root);
+}
+
+TEST_CASE("WorkStealing.Elastic.Automatic" * doctest::timeout(300)) {
+
+  dubhe::ExecutorOptions options;
+  options.elastic_policy.max_workers = 4;
+  options.elastic_policy.min_workers = 1;
+  options.elastic_policy.automatic = true;
+  options.elastic_policy.interval = std::chrono::microseconds(100);
+  options.elastic_policy.idle_intervals = 10;
+
+  dubhe::Executor executor(4, options);
+
+  // an idle executor retires down to its minimum
+  while(executor.num_workers() > 1) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  // a backlog of long tasks makes it grow again
+  std::atomic<size_t> counter {0};
+  for(size_t i=0; i<200; i++) {
+    executor.silent_async([&](){
+      std::this_thread::sleep_for(std::chrono::microseconds(200));
+      counter.fetch_add(1, std::memory_order_relaxed);
+    });
+  }
+  executor.wait_for_all();
+  REQUIRE(counter == 200);
+  elastic_workload(executor, 1000);
+}
+
+// --------------------------------------------------------
+// Testcase: WorkStealing.TaskQueue.Shrink
+// --------------------------------------------------------
+
+TEST_CASE("WorkStealing.TaskQueue.Shrink" * doctest::timeout(300)) {
+
+  dubhe::TaskQueue<size_t*> queue(4);
+  std::vector<size_t> data(10000);
+
+  for(auto& d : data) {
+    queue.push(&d, 1);
+  }
+  REQUIRE(queue.capacity(1) == 16384);
+
+  // too many items to shrink
+  queue.shrink();
+  REQUIRE(queue.capacity(1) == 16384);
+
+  // shrink to a quarter of slack with the remaining items kept in order
+  for(size_t i=0; i<9000; i++) {
+    REQUIRE(queue.pop() == &data[9999-i]);
+  }
+  queue.shrink();
+  REQUIRE(queue.capacity(1) == 2048);
+  REQUIRE(queue.size() == 1000);
+  for(size_t i=0; i<500; i++) {
+    REQUIRE(queue.steal() == &data[i]);
+  }
+  for(size_t i=0; i<500; i++) {
+    REQUIRE(queue.pop() == &data[999-i]);
+  }
+
+  // an empty queue returns to its initial capacity
+  queue.shrink();
+  REQUIRE(queue.capacity(1) == 4);
+  REQUIRE(queue.capacity(0) == 4);
+  REQUIRE(queue.empty());
+}
+
+// Procedure: tsq_shrink_n_thieves
+// the owner grows and shrinks the queue while thieves keep stealing
+void tsq_shrink_n_thieves(size_t M) {
+
+  const size_t N = 1 << 16;
+
+  dubhe::TaskQueue<void*> queue(2);
+  std::vector<void*> gold(N);
+  std::atomic<size_t> consumed {0};
+
+  for(size_t i=0; i<N; ++i) {
+    gold[i] = &gold[i];
+  }
+
+  std::vector<std::thread> threads;
+  std::vector<std::vector<void*>> stolens(M);
+  for(size_t i=0; i<M; ++i) {
+    threads.emplace_back([&, i](){
+      dubhe::TaskQueue<void*> own;
+      while(consumed != N) {
+        auto ptr = (i % 2) ? queue.steal() : queue.steal_half(own);
+        for(; ptr; ptr = own.pop()) {
+          stolens[i].push_back(ptr);
+          consumed.fetch_add(1, std::memory_order_relaxed);
+        }
+      }
+    });
+  }
+
+  // push in bursts of growing size and pop most of each burst before
+  // shrinking, such that arrays are retired while thieves read them
+  std::vector<void*> items;
+  for(size_t i=0, burst=1; i<N; burst = burst*2 % 4093 + 1) {
+    for(size_t k=0; k<burst && i<N; ++k, ++i) {
+      queue.push(gold[i], 0);
+    }
+    for(size_t k=0; k<burst/2; ++k) {
+      if(auto ptr = queue.pop(); ptr) {
+        items.push_back(ptr);
+        consumed.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+    queue.shrink();
+  }
+
+  while(consumed != N) {
+    if(auto ptr = queue.pop(); ptr) {
+      items.push_back(ptr);
+      consumed.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  for(auto& thread : threads) thread.join();
+
+  queue.shrink();
+  REQUIRE(queue.capacity(0) == 2);
+
+  // no thief is left to read the retired arrays
+  REQUIRE(queue.num_retired() > 0);
+  queue.reclaim(queue.num_retired());
+  REQUIRE(queue.num_retired() == 0);
+
+  for(size_t i=0; i<M; ++i) {
+    for(auto s : stolens[i]) {
+      items.push_back(s);
+    }
+  }
+
+  std::sort(items.begin(), items.end());
+  REQUIRE(items == gold);
+}
+
+TEST_CASE("WorkStealing.TaskQueue.Shrink.1Thief" * doctest::timeout(300)) {
+  tsq_shrink_n_thieves(1);
+}
+
+TEST_CASE("WorkStealing.TaskQueue.Shrink.2Thieves" * doctest::timeout(300)) {
+  tsq_shrink_n_thieves(2);
+}
+
+TEST_CASE("WorkStealing.TaskQueue.Shrink.4Thieves" * doctest::timeout(300)) {
+  tsq_shrink_n_thieves(4);
+}
+
+TEST_CASE("WorkStealing.TaskQueue.Shrink.8Thieves" * doctest::timeout(300)) {
+  tsq_shrink_n_thieves(8);
+}
+
+TEST_CASE("WorkStealing.ShrinkOnIdle" * doctest::timeout(300)) {
+
+  dubhe::ExecutorOptions options;
+  options.shrink_on_idle = true;
+
+  for(size_t W=1; W<=4; W++) {
+
+    dubhe::Executor executor(W, options);
+
+    // a deep recursion of subflows grows the worker queues
+    std::atomic<size_t> counter {0};
+    std::function<void(dubhe::Subflow&, size_t)> spawn;
+    spawn = [&](dubhe::Subflow& sf, size_t d) {
+      counter.fetch_add(1, std::memory_order_relaxed);
+      if(d < 12) {
+        for(int i=0; i<2; i++) {
+          sf.emplace([&, d](dubhe::Subflow& sf2){ spawn(sf2, d+1); });
+        }
+      }
+    };
+
+    dubhe::Taskflow taskflow;
+    taskflow.emplace([&](dubhe::Subflow& sf){ spawn(sf, 0); });
+    executor.run(taskflow).wait();
+    REQUIRE(counter == (1 << 13) - 1);
+
+    counter = 0;
+    executor.run(taskflow).wait();
+    REQUIRE(counter == (1 << 13) - 1);
+  }
+}
+
+// ----------------------------------------------------------------------------
+// Affinity
+// ----------------------------------------------------------------------------
+
+TEST_CASE("WorkStealing.Affinity.API" * doctest::timeout(300)) {
+
+  dubhe::Taskflow taskflow;
+
+  auto task = taskflow.emplace([](){});
+  REQUIRE(!task.affinity().has_value());
+
+  task.affinity(3);
+  REQUIRE(task.affinity().has_value());
+  REQUIRE(*task.affinity() == 3);
+
+  task.reset_affinity();
+  REQUIRE(!task.affinity().has_value());
+
+  // an id that does not fit the node is taken as no hint
+  task.affinity(std::numeric_limits<size_t>::max());
+  REQUIRE(!task.affinity().has_value());
+}
+
+void affinity_hints(size_t W, dubhe::WaitMode mode, bool replay) {
+
+  dubhe::ExecutorOptions options;
+  options.wait_policy.mode = mode;
+  options.replay_affinity = replay;
+
+  dubhe::Executor executor(W, options);
+  dubhe::Taskflow taskflow;
+
+  const size_t N = 1024;
+  std::atomic<size_t> counter {0};
+  std::atomic<size_t> num_hinted {0};
+  std::atomic<size_t> num_on_hint {0};
+
+  // independent tasks, chains, and subflow children with valid hints,
+  // hints beyond the number of workers, and no hints
+  for(size_t i=0; i<N; i++) {
+    auto a = taskflow.emplace([&](){ counter++; });
+    auto b = taskflow.emplace([&, i](){
+      counter++;
+      num_hinted++;
+      if(static_cast<size_t>(executor.this_worker_id()) == i % W) {
+        num_on_hint++;
+      }
+    }).affinity(i % W);
+    auto c = taskflow.emplace([&](){ counter++; }).affinity(W + i);
+    a.precede(b);
+    b.precede(c);
+  }
+
+  taskflow.emplace([&](dubhe::Subflow& sf){
+    for(size_t i=0; i<N; i++) {
+      sf.emplace([&](){ counter++; }).affinity(i % W);
+    }
+  });
+
+  for(size_t r=1; r<=4; r++) {
+    executor.run(taskflow).wait();
+    REQUIRE(counter == r * 4 * N);
+  }
+
+  // hints are not binding, but with a single worker every hint is kept
+  REQUIRE(num_hinted == 4 * N);
+  if(W == 1) {
+    REQUIRE(num_on_hint == num_hinted);
+  }
+}
+
+TEST_CASE("WorkStealing.Affinity.1Worker" * doctest::timeout(300)) {
+  affinity_hints(1, dubhe::WaitMode::YIELD, false);
+}
+
+TEST_CASE("WorkStealing.Affinity.4Workers" * doctest::timeout(300)) {
+  affinity_hints(4, dubhe::WaitMode::YIELD, false);
+}
+
+TEST_CASE("WorkStealing.Affinity.4Workers.Park" * doctest::timeout(300)) {
+  affinity_hints(4, dubhe::WaitMode::PARK, false);
+}
+
+TEST_CASE("WorkStealing.Affinity.4Workers.Spin" * doctest::timeout(300)) {
+  affinity_hints(4, dubhe::WaitMode::SPIN, false);
+}
+
+TEST_CASE("WorkStealing.Affinity.Replay.4Workers" * doctest::timeout(300)) {
+  affinity_hints(4, dubhe::WaitMode::YIELD, true);
+}
+
+TEST_CASE("WorkStealing.Affinity.Replay.8Workers.Park" * doctest::timeout(300)) {
+  affinity_hints(8, dubhe::WaitMode::PARK, true);
+}
+
+TEST_CASE("WorkStealing.Affinity.Replay.Async" * doctest::timeout(300)) {
+
+  dubhe::ExecutorOptions options;
+  options.replay_affinity = true;
+
+  dubhe::Executor executor(4, options);
+
+  std::atomic<size_t> counter {0};
+
+  for(int r=0; r<8; r++) {
+    for(int i=0; i<256; i++) {
+      executor.silent_async([&](){ counter++; });
+    }
+    executor.wait_for_all();
+  }
+
+  REQUIRE(counter == 8 * 256);
+}